@@ -0,0 +1,200 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Compares iteration counts with the direct joint tree solver on hanging
+// chains. Each chain of revolute joints is pinned at one end, starts
+// horizontal and carries a heavy load, so it swings down and stretches under
+// Gauss-Seidel iterations. After the run it reports the mean time per step
+// and, from the largest distance between the two anchors of any joint after
+// each step:
+//   gap      - its mean over the run
+//   worstGap - its maximum over the run
+
+#include <Box2D/Box2D.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+	struct Config
+	{
+		const char* name;
+		bool jointTrees;
+		int32 velocityIterations;
+		int32 positionIterations;
+	};
+
+	const Config kConfigs[] =
+	{
+		{"si-8-3", false, 8, 3},
+		{"si-30-10", false, 30, 10},
+		{"si-100-30", false, 100, 30},
+		{"tree-4-2", true, 4, 2},
+		{"tree-8-3", true, 8, 3},
+	};
+	const int32 kConfigCount = sizeof(kConfigs) / sizeof(kConfigs[0]);
+
+	const float32 kTimeStep = 1.0f / 60.0f;
+	const float32 kLinkLength = 0.5f;
+
+	void Run(const Config& config, int32 linkCount, int32 stepCount, b2Joint** joints, bool last)
+	{
+		b2World world(b2Vec2(0.0f, -10.0f));
+		world.SetAllowSleeping(false);
+		world.SetJointTreeSolving(config.jointTrees);
+
+		b2BodyDef bd;
+		b2Body* ground = world.CreateBody(&bd);
+
+		b2PolygonShape link;
+		link.SetAsBox(0.5f * kLinkLength, 0.05f);
+
+		b2PolygonShape load;
+		load.SetAsBox(0.5f, 0.5f);
+
+		b2FixtureDef fd;
+		fd.shape = &link;
+		fd.density = 1.0f;
+		fd.filter.groupIndex = -1;
+
+		bd.type = b2_dynamicBody;
+		b2RevoluteJointDef jd;
+		b2Body* prevBody = ground;
+		for (int32 i = 0; i < linkCount; ++i)
+		{
+			bd.position.Set(kLinkLength * (i + 0.5f), 0.0f);
+			b2Body* body = world.CreateBody(&bd);
+			body->CreateFixture(&fd);
+
+			jd.Initialize(prevBody, body, b2Vec2(kLinkLength * i, 0.0f));
+			joints[i] = world.CreateJoint(&jd);
+			prevBody = body;
+		}
+
+		// The load weighs as much as twenty-five links.
+		bd.position.Set(kLinkLength * linkCount + 0.5f, 0.0f);
+		b2Body* loadBody = world.CreateBody(&bd);
+		fd.shape = &load;
+		fd.density = 25.0f * kLinkLength * 0.1f;
+		loadBody->CreateFixture(&fd);
+		jd.Initialize(prevBody, loadBody, b2Vec2(kLinkLength * linkCount, 0.0f));
+		joints[linkCount] = world.CreateJoint(&jd);
+
+		int64 elapsed = 0;
+		float32 gapSum = 0.0f;
+		float32 worstGap = 0.0f;
+		for (int32 i = 0; i < stepCount; ++i)
+		{
+			int64 start = b2Timer::GetTimestamp();
+			world.Step(kTimeStep, config.velocityIterations, config.positionIterations);
+			elapsed += b2Timer::GetTimestamp() - start;
+
+			float32 gap = 0.0f;
+			for (int32 j = 0; j <= linkCount; ++j)
+			{
+				gap = b2Max(gap, b2Distance(joints[j]->GetAnchorA(), joints[j]->GetAnchorB()));
+			}
+			gapSum += gap;
+			worstGap = b2Max(worstGap, gap);
+		}
+
+		printf("\t\t{\"solver\": \"%s\", \"links\": %d, \"stepMs\": %.4f, \"gap\": %.4f, \"worstGap\": %.4f}%s\n",
+			config.name, linkCount, 1.0e-6 * elapsed / stepCount, gapSum / stepCount, worstGap, last ? "" : ",");
+	}
+
+	void Usage()
+	{
+		fprintf(stderr,
+			"usage: ChainBenchmark [--steps count] [--links n1,n2,...]\n"
+			"Runs a loaded chain of each length with every solver configuration.\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int32 stepCount = 300;
+	int32 lengths[16] = {20, 50, 100};
+	int32 lengthCount = 3;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+		{
+			stepCount = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--links") == 0 && i + 1 < argc)
+		{
+			lengthCount = 0;
+			for (char* p = argv[++i]; *p && lengthCount < 16; )
+			{
+				lengths[lengthCount++] = (int32)strtol(p, &p, 10);
+				if (*p == ',')
+				{
+					++p;
+				}
+				else if (*p)
+				{
+					lengthCount = 0;
+					break;
+				}
+			}
+		}
+		else
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	int32 maxLength = 0;
+	for (int32 i = 0; i < lengthCount; ++i)
+	{
+		maxLength = b2Max(maxLength, lengths[i]);
+		if (lengths[i] < 1)
+		{
+			lengthCount = 0;
+		}
+	}
+
+	if (stepCount < 1 || lengthCount == 0)
+	{
+		Usage();
+		return 1;
+	}
+
+	b2Joint** joints = new b2Joint*[maxLength + 1];
+
+	printf("{\n");
+	printf("\t\"steps\": %d,\n", stepCount);
+	printf("\t\"runs\": [\n");
+	for (int32 l = 0; l < lengthCount; ++l)
+	{
+		for (int32 c = 0; c < kConfigCount; ++c)
+		{
+			bool last = l == lengthCount - 1 && c == kConfigCount - 1;
+			Run(kConfigs[c], lengths[l], stepCount, joints, last);
+		}
+	}
+	printf("\t]\n}\n");
+
+	delete[] joints;
+
+	return 0;
+}
@@ -0,0 +1,299 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Measures small object allocation from several threads at once. Every thread
+// churns a set of live blocks of contact-like sizes, freeing a random one and
+// allocating a replacement, which is the pattern of contact creation and
+// destruction. The allocation strategies are:
+//   locked  - one b2BlockAllocator behind a mutex
+//   pool    - one b2BlockPool with a b2BlockCache per thread
+//   private - a b2BlockAllocator per thread, which cannot share memory and
+//             is the upper bound
+
+#include <Box2D/Box2D.h>
+#include <Box2D/Common/b2BlockAllocator.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace
+{
+	const int32 kMaxThreads = 64;
+	const int32 kLiveBlocks = 4096;
+	const int32 kSizes[] = {48, 64, 96, 128, 160, 256};
+	const int32 kSizeCount = sizeof(kSizes) / sizeof(kSizes[0]);
+
+	enum Mode
+	{
+		e_locked,
+		e_pool,
+		e_private,
+		e_modeCount
+	};
+
+	const char* const kModeNames[e_modeCount] = {"locked", "pool", "private"};
+
+	struct Shared
+	{
+		Mode mode;
+		int32 opCount;
+		b2Mutex mutex;
+		b2BlockAllocator* lockedAllocator;
+		b2BlockPool* pool;
+	};
+
+	struct Worker
+	{
+		Shared* shared;
+		uint32 seed;
+	};
+
+	// Wraps the three strategies behind one interface for the worker loop.
+	class ThreadAllocator
+	{
+	public:
+		ThreadAllocator(Shared* shared) : m_shared(shared), m_cache(shared->pool) {}
+
+		void* Allocate(int32 size)
+		{
+			switch (m_shared->mode)
+			{
+			case e_locked:
+				{
+					b2MutexLock lock(&m_shared->mutex);
+					return m_shared->lockedAllocator->Allocate(size, e_allocTagContact);
+				}
+
+			case e_pool:
+				return m_cache.Allocate(size, e_allocTagContact);
+
+			default:
+				return m_private.Allocate(size, e_allocTagContact);
+			}
+		}
+
+		void Free(void* p, int32 size)
+		{
+			switch (m_shared->mode)
+			{
+			case e_locked:
+				{
+					b2MutexLock lock(&m_shared->mutex);
+					m_shared->lockedAllocator->Free(p, size, e_allocTagContact);
+				}
+				break;
+
+			case e_pool:
+				m_cache.Free(p, size, e_allocTagContact);
+				break;
+
+			default:
+				m_private.Free(p, size, e_allocTagContact);
+				break;
+			}
+		}
+
+	private:
+		Shared* m_shared;
+		b2BlockCache m_cache;
+		b2BlockAllocator m_private;
+	};
+
+	void Churn(Worker* worker)
+	{
+		Shared* shared = worker->shared;
+		ThreadAllocator allocator(shared);
+
+		void* blocks[kLiveBlocks];
+		int32 sizes[kLiveBlocks];
+		uint32 state = worker->seed;
+		for (int32 i = 0; i < kLiveBlocks; ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			sizes[i] = kSizes[(state >> 8) % kSizeCount];
+			blocks[i] = allocator.Allocate(sizes[i]);
+		}
+
+		for (int32 i = 0; i < shared->opCount; ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			int32 slot = (state >> 8) % kLiveBlocks;
+			allocator.Free(blocks[slot], sizes[slot]);
+			sizes[slot] = kSizes[(state >> 20) % kSizeCount];
+			blocks[slot] = allocator.Allocate(sizes[slot]);
+			memset(blocks[slot], 0, 16);
+		}
+
+		for (int32 i = 0; i < kLiveBlocks; ++i)
+		{
+			allocator.Free(blocks[i], sizes[i]);
+		}
+	}
+
+#if defined(_WIN32)
+	DWORD WINAPI ThreadMain(LPVOID data)
+	{
+		Churn((Worker*)data);
+		return 0;
+	}
+
+	void RunThreads(Worker* workers, int32 count)
+	{
+		HANDLE threads[kMaxThreads];
+		for (int32 i = 0; i < count; ++i)
+		{
+			threads[i] = CreateThread(NULL, 0, ThreadMain, workers + i, 0, NULL);
+		}
+		WaitForMultipleObjects(count, threads, TRUE, INFINITE);
+		for (int32 i = 0; i < count; ++i)
+		{
+			CloseHandle(threads[i]);
+		}
+	}
+#else
+	void* ThreadMain(void* data)
+	{
+		Churn((Worker*)data);
+		return NULL;
+	}
+
+	void RunThreads(Worker* workers, int32 count)
+	{
+		pthread_t threads[kMaxThreads];
+		for (int32 i = 0; i < count; ++i)
+		{
+			pthread_create(threads + i, NULL, ThreadMain, workers + i);
+		}
+		for (int32 i = 0; i < count; ++i)
+		{
+			pthread_join(threads[i], NULL);
+		}
+	}
+#endif
+
+	void RunMode(Mode mode, int32 threadCount, int32 opCount, bool last)
+	{
+		Shared shared;
+		shared.mode = mode;
+		shared.opCount = opCount;
+		shared.lockedAllocator = new b2BlockAllocator;
+		shared.pool = new b2BlockPool;
+
+		Worker workers[kMaxThreads];
+		for (int32 i = 0; i < threadCount; ++i)
+		{
+			workers[i].shared = &shared;
+			workers[i].seed = 12345u + 7919u * (uint32)i;
+		}
+
+		b2Timer timer;
+		RunThreads(workers, threadCount);
+		float64 milliseconds = timer.GetMilliseconds();
+
+		float64 operations = 2.0 * threadCount * (opCount + kLiveBlocks);
+		int32 chunkBytes = 0;
+		switch (mode)
+		{
+		case e_locked:
+			chunkBytes = shared.lockedAllocator->GetChunkBytes();
+			break;
+
+		case e_pool:
+			chunkBytes = shared.pool->GetChunkBytes();
+			break;
+
+		default:
+			break;
+		}
+
+		printf("\t\t{\"mode\": \"%s\", \"threads\": %d, \"ms\": %.3f, \"mopsPerSecond\": %.2f",
+			kModeNames[mode], threadCount, milliseconds, milliseconds > 0.0 ? operations / (1000.0 * milliseconds) : 0.0);
+		if (mode == e_pool)
+		{
+			printf(", \"locksPerOp\": %.5f", shared.pool->GetLockCount() / operations);
+		}
+		if (mode != e_private)
+		{
+			printf(", \"chunkKB\": %d", chunkBytes / 1024);
+		}
+		printf("}%s\n", last ? "" : ",");
+
+		delete shared.pool;
+		delete shared.lockedAllocator;
+	}
+
+	void Usage()
+	{
+		fprintf(stderr,
+			"usage: ContentionBenchmark [--threads count] [--ops count]\n"
+			"Runs every allocation mode with 1, 2, 4, ... threads up to count.\n"
+			"--ops is the number of free and allocate pairs per thread.\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int32 maxThreads = 8;
+	int32 opCount = 2000000;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			maxThreads = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc)
+		{
+			opCount = atoi(argv[++i]);
+		}
+		else
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	if (maxThreads < 1 || maxThreads > kMaxThreads || opCount < 0)
+	{
+		Usage();
+		return 1;
+	}
+
+	printf("{\n");
+	printf("\t\"liveBlocks\": %d,\n", kLiveBlocks);
+	printf("\t\"opsPerThread\": %d,\n", opCount);
+	printf("\t\"runs\": [\n");
+	for (int32 threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+	{
+		for (int32 mode = 0; mode < e_modeCount; ++mode)
+		{
+			bool last = 2 * threadCount > maxThreads && mode == e_modeCount - 1;
+			RunMode((Mode)mode, threadCount, opCount, last);
+		}
+	}
+	printf("\t]\n}\n");
+
+	return 0;
+}
@@ -0,0 +1,575 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Micro-benchmarks for the collision kernels. Each kernel runs over a fixed
+// set of seeded random inputs until a minimum time has elapsed, so results
+// are comparable between runs and machines.
+
+#include <Box2D/Box2D.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Iteration counters maintained by b2Distance and b2TimeOfImpact.
+extern int32 b2_gjkCalls, b2_gjkIters, b2_gjkMaxIters;
+extern int32 b2_toiCalls, b2_toiIters, b2_toiMaxIters;
+extern int32 b2_toiRootIters, b2_toiMaxRootIters;
+
+namespace
+{
+	const int32 kInputCount = 1024;
+	const int32 kTreeProxyCount = 10000;
+
+	// Small LCG so the inputs do not depend on the C library.
+	class Random
+	{
+	public:
+		explicit Random(uint32 seed) : m_state(seed) {}
+
+		float32 Float(float32 lo, float32 hi)
+		{
+			m_state = m_state * 1664525u + 1013904223u;
+			float32 r = (float32)(m_state >> 8) / (float32)(1 << 24);
+			return lo + r * (hi - lo);
+		}
+
+		int32 Int(int32 lo, int32 hi)
+		{
+			m_state = m_state * 1664525u + 1013904223u;
+			return lo + (int32)((m_state >> 8) % (uint32)(hi - lo + 1));
+		}
+
+	private:
+		uint32 m_state;
+	};
+
+	// Vertices of a convex CCW polygon on an ellipse, with jittered angles.
+	int32 RandomHull(Random& random, b2Vec2* vertices)
+	{
+		int32 count = random.Int(3, b2_maxPolygonVertices);
+		float32 rx = random.Float(0.25f, 1.0f);
+		float32 ry = random.Float(0.25f, 1.0f);
+		float32 step = 2.0f * b2_pi / count;
+		for (int32 i = 0; i < count; ++i)
+		{
+			float32 angle = (i + random.Float(-0.3f, 0.3f)) * step;
+			vertices[i].Set(rx * cosf(angle), ry * sinf(angle));
+		}
+		return count;
+	}
+
+	b2Transform RandomTransform(Random& random, float32 extent)
+	{
+		b2Transform xf;
+		xf.p.Set(random.Float(-extent, extent), random.Float(-extent, extent));
+		xf.q.Set(random.Float(-b2_pi, b2_pi));
+		return xf;
+	}
+
+	void ResetIterationCounters()
+	{
+		b2_gjkCalls = b2_gjkIters = b2_gjkMaxIters = 0;
+		b2_toiCalls = b2_toiIters = b2_toiMaxIters = 0;
+		b2_toiRootIters = b2_toiMaxRootIters = 0;
+	}
+
+	class Kernel
+	{
+	public:
+		virtual ~Kernel() {}
+
+		// Run the kernel once over every input and return a value that
+		// depends on the results so the work cannot be optimized away.
+		virtual float32 Run() = 0;
+	};
+
+	class CollidePolygonsKernel : public Kernel
+	{
+	public:
+		explicit CollidePolygonsKernel(Random& random)
+		{
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				b2Vec2 vertices[b2_maxPolygonVertices];
+				int32 count = RandomHull(random, vertices);
+				m_polygonsA[i].Set(vertices, count);
+				count = RandomHull(random, vertices);
+				m_polygonsB[i].Set(vertices, count);
+				m_xfA[i] = RandomTransform(random, 0.5f);
+				m_xfB[i] = RandomTransform(random, 0.5f);
+			}
+		}
+
+		float32 Run()
+		{
+			float32 sum = 0.0f;
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				b2Manifold manifold;
+				b2CollidePolygons(&manifold, m_polygonsA + i, m_xfA[i], m_polygonsB + i, m_xfB[i], 0.0f);
+				sum += manifold.pointCount;
+			}
+			return sum;
+		}
+
+	private:
+		b2PolygonShape m_polygonsA[kInputCount];
+		b2PolygonShape m_polygonsB[kInputCount];
+		b2Transform m_xfA[kInputCount];
+		b2Transform m_xfB[kInputCount];
+	};
+
+	class CollideEdgeAndPolygonKernel : public Kernel
+	{
+	public:
+		explicit CollideEdgeAndPolygonKernel(Random& random)
+		{
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				b2Vec2 v0(random.Float(-3.0f, -2.0f), random.Float(-0.5f, 0.5f));
+				b2Vec2 v1(random.Float(-1.5f, -0.5f), random.Float(-0.5f, 0.5f));
+				b2Vec2 v2(random.Float(0.5f, 1.5f), random.Float(-0.5f, 0.5f));
+				b2Vec2 v3(random.Float(2.0f, 3.0f), random.Float(-0.5f, 0.5f));
+				m_edges[i].Set(v1, v2);
+				m_edges[i].m_hasVertex0 = random.Int(0, 1) == 1;
+				m_edges[i].m_hasVertex3 = random.Int(0, 1) == 1;
+				m_edges[i].m_vertex0 = v0;
+				m_edges[i].m_vertex3 = v3;
+
+				b2Vec2 vertices[b2_maxPolygonVertices];
+				int32 count = RandomHull(random, vertices);
+				m_polygons[i].Set(vertices, count);
+				m_xfA[i].SetIdentity();
+				m_xfB[i] = RandomTransform(random, 0.75f);
+			}
+		}
+
+		float32 Run()
+		{
+			float32 sum = 0.0f;
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				b2Manifold manifold;
+				b2CollideEdgeAndPolygon(&manifold, m_edges + i, m_xfA[i], m_polygons + i, m_xfB[i], 0.0f);
+				sum += manifold.pointCount;
+			}
+			return sum;
+		}
+
+	private:
+		b2EdgeShape m_edges[kInputCount];
+		b2PolygonShape m_polygons[kInputCount];
+		b2Transform m_xfA[kInputCount];
+		b2Transform m_xfB[kInputCount];
+	};
+
+	class CollideCirclesKernel : public Kernel
+	{
+	public:
+		explicit CollideCirclesKernel(Random& random)
+		{
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				m_circlesA[i].m_radius = random.Float(0.1f, 1.0f);
+				m_circlesB[i].m_radius = random.Float(0.1f, 1.0f);
+				m_xfA[i] = RandomTransform(random, 1.0f);
+				m_xfB[i] = RandomTransform(random, 1.0f);
+			}
+		}
+
+		float32 Run()
+		{
+			float32 sum = 0.0f;
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				b2Manifold manifold;
+				b2CollideCircles(&manifold, m_circlesA + i, m_xfA[i], m_circlesB + i, m_xfB[i], 0.0f);
+				sum += manifold.pointCount;
+			}
+			return sum;
+		}
+
+	private:
+		b2CircleShape m_circlesA[kInputCount];
+		b2CircleShape m_circlesB[kInputCount];
+		b2Transform m_xfA[kInputCount];
+		b2Transform m_xfB[kInputCount];
+	};
+
+	class DistanceKernel : public Kernel
+	{
+	public:
+		explicit DistanceKernel(Random& random)
+		{
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				b2Vec2 vertices[b2_maxPolygonVertices];
+				int32 count = RandomHull(random, vertices);
+				m_polygonsA[i].Set(vertices, count);
+				count = RandomHull(random, vertices);
+				m_polygonsB[i].Set(vertices, count);
+
+				m_inputs[i].proxyA.Set(m_polygonsA + i, 0);
+				m_inputs[i].proxyB.Set(m_polygonsB + i, 0);
+				m_inputs[i].transformA = RandomTransform(random, 2.0f);
+				m_inputs[i].transformB = RandomTransform(random, 2.0f);
+				m_inputs[i].useRadii = true;
+			}
+		}
+
+		float32 Run()
+		{
+			float32 sum = 0.0f;
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				b2SimplexCache cache;
+				cache.count = 0;
+				b2DistanceOutput output;
+				b2Distance(&output, &cache, m_inputs + i);
+				sum += output.distance;
+			}
+			return sum;
+		}
+
+	private:
+		b2PolygonShape m_polygonsA[kInputCount];
+		b2PolygonShape m_polygonsB[kInputCount];
+		b2DistanceInput m_inputs[kInputCount];
+	};
+
+	class TimeOfImpactKernel : public Kernel
+	{
+	public:
+		explicit TimeOfImpactKernel(Random& random)
+		{
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				b2Vec2 vertices[b2_maxPolygonVertices];
+				int32 count = RandomHull(random, vertices);
+				m_polygonsA[i].Set(vertices, count);
+				count = RandomHull(random, vertices);
+				m_polygonsB[i].Set(vertices, count);
+
+				b2TOIInput& input = m_inputs[i];
+				input.proxyA.Set(m_polygonsA + i, 0);
+				input.proxyB.Set(m_polygonsB + i, 0);
+				InitSweep(random, &input.sweepA, b2Vec2(-4.0f, 0.0f), b2Vec2(4.0f, 0.0f));
+				InitSweep(random, &input.sweepB, b2Vec2(4.0f, 0.0f), b2Vec2(-4.0f, 0.0f));
+				input.tMax = 1.0f;
+			}
+		}
+
+		float32 Run()
+		{
+			float32 sum = 0.0f;
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				b2TOIOutput output;
+				b2TimeOfImpact(&output, m_inputs + i);
+				sum += output.t;
+			}
+			return sum;
+		}
+
+	private:
+		static void InitSweep(Random& random, b2Sweep* sweep, const b2Vec2& from, const b2Vec2& to)
+		{
+			sweep->localCenter.SetZero();
+			sweep->c0 = from + b2Vec2(random.Float(-1.0f, 1.0f), random.Float(-1.0f, 1.0f));
+			sweep->c = to + b2Vec2(random.Float(-1.0f, 1.0f), random.Float(-1.0f, 1.0f));
+			sweep->a0 = random.Float(-b2_pi, b2_pi);
+			sweep->a = sweep->a0 + random.Float(-b2_pi, b2_pi);
+			sweep->alpha0 = 0.0f;
+		}
+
+		b2PolygonShape m_polygonsA[kInputCount];
+		b2PolygonShape m_polygonsB[kInputCount];
+		b2TOIInput m_inputs[kInputCount];
+	};
+
+	class TreeKernel : public Kernel
+	{
+	public:
+		explicit TreeKernel(Random& random)
+		{
+			for (int32 i = 0; i < kTreeProxyCount; ++i)
+			{
+				m_tree.CreateProxy(RandomBox(random, 0.5f), NULL);
+			}
+			m_hits = 0;
+		}
+
+	protected:
+		static b2AABB RandomBox(Random& random, float32 maxExtent)
+		{
+			b2Vec2 center(random.Float(-100.0f, 100.0f), random.Float(-100.0f, 100.0f));
+			b2Vec2 extent(random.Float(0.1f, maxExtent), random.Float(0.1f, maxExtent));
+			b2AABB aabb;
+			aabb.lowerBound = center - extent;
+			aabb.upperBound = center + extent;
+			return aabb;
+		}
+
+		b2DynamicTree m_tree;
+		int32 m_hits;
+	};
+
+	class TreeQueryKernel : public TreeKernel
+	{
+	public:
+		explicit TreeQueryKernel(Random& random) : TreeKernel(random)
+		{
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				m_boxes[i] = RandomBox(random, 4.0f);
+			}
+		}
+
+		bool QueryCallback(int32 proxyId)
+		{
+			B2_NOT_USED(proxyId);
+			++m_hits;
+			return true;
+		}
+
+		float32 Run()
+		{
+			m_hits = 0;
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				m_tree.Query(this, m_boxes[i]);
+			}
+			return (float32)m_hits;
+		}
+
+	private:
+		b2AABB m_boxes[kInputCount];
+	};
+
+	class TreeRayCastKernel : public TreeKernel
+	{
+	public:
+		explicit TreeRayCastKernel(Random& random) : TreeKernel(random)
+		{
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				b2RayCastInput& input = m_inputs[i];
+				input.p1.Set(random.Float(-100.0f, 100.0f), random.Float(-100.0f, 100.0f));
+				input.p2 = input.p1 + b2Vec2(random.Float(-50.0f, 50.0f), random.Float(-50.0f, 50.0f));
+				input.maxFraction = 1.0f;
+			}
+		}
+
+		float32 RayCastCallback(const b2RayCastInput& input, int32 proxyId)
+		{
+			B2_NOT_USED(proxyId);
+			++m_hits;
+			return input.maxFraction;
+		}
+
+		float32 Run()
+		{
+			m_hits = 0;
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				m_tree.RayCast(this, m_inputs[i]);
+			}
+			return (float32)m_hits;
+		}
+
+	private:
+		b2RayCastInput m_inputs[kInputCount];
+	};
+
+	class PolygonSetKernel : public Kernel
+	{
+	public:
+		explicit PolygonSetKernel(Random& random)
+		{
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				m_counts[i] = RandomHull(random, m_vertices[i]);
+			}
+		}
+
+		float32 Run()
+		{
+			float32 sum = 0.0f;
+			for (int32 i = 0; i < kInputCount; ++i)
+			{
+				b2PolygonShape polygon;
+				polygon.Set(m_vertices[i], m_counts[i]);
+				sum += polygon.m_centroid.x;
+			}
+			return sum;
+		}
+
+	private:
+		b2Vec2 m_vertices[kInputCount][b2_maxPolygonVertices];
+		int32 m_counts[kInputCount];
+	};
+
+	template <typename T>
+	Kernel* CreateKernel(Random& random)
+	{
+		return new T(random);
+	}
+
+	typedef Kernel* KernelCreateFcn(Random& random);
+
+	struct KernelEntry
+	{
+		const char* name;
+		KernelCreateFcn* createFcn;
+	};
+
+	const KernelEntry kKernels[] =
+	{
+		{"collidePolygons", CreateKernel<CollidePolygonsKernel>},
+		{"collideEdgeAndPolygon", CreateKernel<CollideEdgeAndPolygonKernel>},
+		{"collideCircles", CreateKernel<CollideCirclesKernel>},
+		{"distance", CreateKernel<DistanceKernel>},
+		{"timeOfImpact", CreateKernel<TimeOfImpactKernel>},
+		{"treeQuery", CreateKernel<TreeQueryKernel>},
+		{"treeRayCast", CreateKernel<TreeRayCastKernel>},
+		{"polygonSet", CreateKernel<PolygonSetKernel>},
+		{NULL, NULL}
+	};
+
+	volatile float32 g_sink;
+
+	void RunKernel(const KernelEntry& entry, uint32 seed, float32 minMilliseconds, bool last)
+	{
+		Random random(seed);
+		Kernel* kernel = entry.createFcn(random);
+
+		// Warm up caches and branch predictors once before timing.
+		g_sink += kernel->Run();
+
+		ResetIterationCounters();
+
+		int32 passes = 0;
+		float32 elapsed = 0.0f;
+		b2Timer timer;
+		do
+		{
+			g_sink += kernel->Run();
+			++passes;
+			elapsed = timer.GetMilliseconds();
+		}
+		while (elapsed < minMilliseconds);
+
+		float64 ops = (float64)passes * kInputCount;
+
+		printf("\t\t{\n");
+		printf("\t\t\t\"name\": \"%s\",\n", entry.name);
+		printf("\t\t\t\"ops\": %.0f,\n", ops);
+		printf("\t\t\t\"nsPerOp\": %.2f", 1.0e6 * elapsed / ops);
+		if (b2_gjkCalls > 0)
+		{
+			printf(",\n\t\t\t\"gjk\": {\"calls\": %d, \"avgIters\": %.3f, \"maxIters\": %d}",
+				b2_gjkCalls, (float64)b2_gjkIters / b2_gjkCalls, b2_gjkMaxIters);
+		}
+		if (b2_toiCalls > 0)
+		{
+			printf(",\n\t\t\t\"toi\": {\"calls\": %d, \"avgIters\": %.3f, \"maxIters\": %d, "
+				"\"avgRootIters\": %.3f, \"maxRootIters\": %d}",
+				b2_toiCalls, (float64)b2_toiIters / b2_toiCalls, b2_toiMaxIters,
+				(float64)b2_toiRootIters / b2_toiCalls, b2_toiMaxRootIters);
+		}
+		printf("\n\t\t}%s\n", last ? "" : ",");
+
+		delete kernel;
+	}
+
+	void Usage()
+	{
+		fprintf(stderr,
+			"usage: KernelBenchmark [--kernel name] [--seed value] [--time milliseconds]\n"
+			"Kernels:");
+		for (int32 i = 0; kKernels[i].name; ++i)
+		{
+			fprintf(stderr, " %s", kKernels[i].name);
+		}
+		fprintf(stderr, "\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const char* kernelName = NULL;
+	uint32 seed = 12345;
+	float32 minMilliseconds = 200.0f;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--kernel") == 0 && i + 1 < argc)
+		{
+			kernelName = argv[++i];
+		}
+		else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			seed = (uint32)strtoul(argv[++i], NULL, 10);
+		}
+		else if (strcmp(argv[i], "--time") == 0 && i + 1 < argc)
+		{
+			minMilliseconds = (float32)atof(argv[++i]);
+		}
+		else
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	int32 count = 0;
+	int32 matches = 0;
+	for (; kKernels[count].name; ++count)
+	{
+		if (kernelName == NULL || strcmp(kernelName, kKernels[count].name) == 0)
+		{
+			++matches;
+		}
+	}
+
+	if (matches == 0)
+	{
+		Usage();
+		return 1;
+	}
+
+	printf("{\n");
+	printf("\t\"seed\": %u,\n", seed);
+	printf("\t\"inputs\": %d,\n", kInputCount);
+	printf("\t\"kernels\": [\n");
+	for (int32 i = 0; i < count; ++i)
+	{
+		const KernelEntry& entry = kKernels[i];
+		if (kernelName && strcmp(kernelName, entry.name) != 0)
+		{
+			continue;
+		}
+
+		--matches;
+		RunKernel(entry, seed, minMilliseconds, matches == 0);
+	}
+	printf("\t]\n}\n");
+
+	return 0;
+}
@@ -0,0 +1,533 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Scene.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+	const float32 kTimeStep = 1.0f / 60.0f;
+	const int32 kVelocityIterations = 8;
+	const int32 kPositionIterations = 3;
+
+	struct ProfileField
+	{
+		const char* name;
+		float32 b2Profile::*time;
+		b2ProfileStat b2ProfileStats::*stat;
+	};
+
+	const ProfileField kProfileFields[] =
+	{
+		{"step", &b2Profile::step, &b2ProfileStats::step},
+		{"collide", &b2Profile::collide, &b2ProfileStats::collide},
+		{"solve", &b2Profile::solve, &b2ProfileStats::solve},
+		{"solveInit", &b2Profile::solveInit, &b2ProfileStats::solveInit},
+		{"solveVelocity", &b2Profile::solveVelocity, &b2ProfileStats::solveVelocity},
+		{"solvePosition", &b2Profile::solvePosition, &b2ProfileStats::solvePosition},
+		{"broadphase", &b2Profile::broadphase, &b2ProfileStats::broadphase},
+		{"solveTOI", &b2Profile::solveTOI, &b2ProfileStats::solveTOI}
+	};
+	const int32 kProfileCount = sizeof(kProfileFields) / sizeof(kProfileFields[0]);
+
+	struct MetricField
+	{
+		const char* name;
+		int32 b2Metrics::*field;
+	};
+
+	const MetricField kMetricFields[] =
+	{
+		{"contactsCreated", &b2Metrics::contactsCreated},
+		{"contactsDestroyed", &b2Metrics::contactsDestroyed},
+		{"contactsTouching", &b2Metrics::contactsTouching},
+		{"pairsFound", &b2Metrics::pairsFound},
+		{"pairsBuffered", &b2Metrics::pairsBuffered},
+		{"proxiesMoved", &b2Metrics::proxiesMoved},
+		{"proxiesReinserted", &b2Metrics::proxiesReinserted},
+		{"contactPointsCached", &b2Metrics::contactPointsCached},
+		{"contactPointsRestored", &b2Metrics::contactPointsRestored},
+		{"manifoldsReused", &b2Metrics::manifoldsReused},
+		{"islands", &b2Metrics::islands},
+		{"bodiesAwake", &b2Metrics::bodiesAwake},
+		{"toiEvents", &b2Metrics::toiEvents},
+		{"gjkCalls", &b2Metrics::gjkCalls},
+		{"gjkIters", &b2Metrics::gjkIters},
+		{"gjkMaxIters", &b2Metrics::gjkMaxIters},
+		{"toiCalls", &b2Metrics::toiCalls},
+		{"toiIters", &b2Metrics::toiIters},
+		{"toiMaxIters", &b2Metrics::toiMaxIters},
+		{"blockAllocatorBytes", &b2Metrics::blockAllocatorBytes},
+		{"stackAllocatorPeak", &b2Metrics::stackAllocatorPeak},
+		{"stackAllocatorCapacity", &b2Metrics::stackAllocatorCapacity},
+		{"stackAllocatorGrowths", &b2Metrics::stackAllocatorGrowths},
+		{"blockAllocatorGrowths", &b2Metrics::blockAllocatorGrowths},
+		{"broadPhaseGrowths", &b2Metrics::broadPhaseGrowths},
+	};
+	const int32 kMetricCount = sizeof(kMetricFields) / sizeof(kMetricFields[0]);
+
+	// Per-step maxima of the world metrics and the island histogram of the whole run.
+	struct MetricStats
+	{
+		MetricStats()
+		{
+			memset(max, 0, sizeof(max));
+			memset(islandSizes, 0, sizeof(islandSizes));
+		}
+
+		void Add(const b2Metrics& metrics)
+		{
+			for (int32 i = 0; i < kMetricCount; ++i)
+			{
+				max[i] = b2Max(max[i], metrics.*kMetricFields[i].field);
+			}
+			for (int32 i = 0; i < b2_islandHistogramSize; ++i)
+			{
+				islandSizes[i] += metrics.islandSizes[i];
+			}
+		}
+
+		int32 max[kMetricCount];
+		int32 islandSizes[b2_islandHistogramSize];
+	};
+
+	// Peak resident set size of the process in kilobytes.
+	long PeakMemoryKB()
+	{
+#if defined(__linux__)
+		rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		return usage.ru_maxrss;
+#elif defined(__APPLE__)
+		rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		return usage.ru_maxrss / 1024;
+#else
+		return 0;
+#endif
+	}
+
+	void PrintProfile(const b2ProfileStats& stats, const char* indent)
+	{
+		printf("%s\"profile\": {\n", indent);
+		for (int32 i = 0; i < kProfileCount; ++i)
+		{
+			const b2ProfileStat& phase = stats.*kProfileFields[i].stat;
+			float64 avg = stats.stepCount > 0 ? 1.0e-6 * phase.total / stats.stepCount : 0.0;
+			printf("%s\t\"%s\": {\"min\": %.4f, \"avg\": %.4f, \"max\": %.4f}%s\n",
+				indent, kProfileFields[i].name, 1.0e-6 * phase.min, avg, 1.0e-6 * phase.max,
+				i + 1 < kProfileCount ? "," : "");
+		}
+		printf("%s}", indent);
+	}
+
+	void PrintMetrics(const MetricStats& stats, const char* indent)
+	{
+		printf("%s\"metricsMax\": {\n", indent);
+		for (int32 i = 0; i < kMetricCount; ++i)
+		{
+			printf("%s\t\"%s\": %d,\n", indent, kMetricFields[i].name, stats.max[i]);
+		}
+		printf("%s\t\"islandSizes\": [", indent);
+		for (int32 i = 0; i < b2_islandHistogramSize; ++i)
+		{
+			printf("%s%d", i > 0 ? ", " : "", stats.islandSizes[i]);
+		}
+		printf("]\n%s}", indent);
+	}
+
+	void PrintMemory(const b2World* world, const char* indent)
+	{
+		b2MemoryReport report;
+		world->GetMemoryReport(&report);
+
+		printf("%s\"memory\": {\n", indent);
+		printf("%s\t\"totalBytes\": %d,\n", indent, report.totalBytes);
+		printf("%s\t\"peakBytes\": %d,\n", indent, report.peakBytes);
+		for (int32 i = 0; i < e_allocTagCount; ++i)
+		{
+			printf("%s\t\"%s\": %d%s\n", indent, b2GetAllocTagName((b2AllocTag)i), report.bytes[i],
+				i + 1 < e_allocTagCount ? "," : "");
+		}
+		printf("%s}", indent);
+	}
+
+	bool WriteFile(const char* path, const void* data, int32 size)
+	{
+		FILE* file = fopen(path, "wb");
+		if (file == NULL)
+		{
+			return false;
+		}
+		bool ok = fwrite(data, 1, size, file) == (size_t)size;
+		fclose(file);
+		return ok;
+	}
+
+	void* ReadFile(const char* path, int32* size)
+	{
+		FILE* file = fopen(path, "rb");
+		if (file == NULL)
+		{
+			return NULL;
+		}
+		fseek(file, 0, SEEK_END);
+		*size = (int32)ftell(file);
+		fseek(file, 0, SEEK_SET);
+		void* data = malloc(*size);
+		if (fread(data, 1, *size, file) != (size_t)*size)
+		{
+			free(data);
+			data = NULL;
+		}
+		fclose(file);
+		return data;
+	}
+
+	void WriteTrace(const char* text, int32 length, void* context)
+	{
+		fwrite(text, 1, length, (FILE*)context);
+	}
+
+	void ExportTrace(const char* path)
+	{
+		if (b2TraceGetEventCount() == 0)
+		{
+			fprintf(stderr, "No trace events; build with BOX2D_ENABLE_TRACE\n");
+		}
+
+		FILE* file = fopen(path, "w");
+		if (file == NULL)
+		{
+			fprintf(stderr, "Could not write %s\n", path);
+			return;
+		}
+		b2TraceExport(WriteTrace, file);
+		fclose(file);
+	}
+
+	// Run the scene once to find the largest object counts it reaches.
+	b2WorldCapacity MeasureCapacity(const SceneEntry& entry, int32 stepCount)
+	{
+		b2WorldCapacity capacity;
+		b2World* world = new b2World(b2Vec2(0.0f, -10.0f));
+		Scene* scene = entry.createFcn(world);
+		for (int32 i = 0; i <= stepCount; ++i)
+		{
+			int32 fixtureCount = 0;
+			int32 shapeCounts[b2Shape::e_typeCount] = {0};
+			for (b2Body* b = world->GetBodyList(); b; b = b->GetNext())
+			{
+				for (b2Fixture* f = b->GetFixtureList(); f; f = f->GetNext())
+				{
+					++fixtureCount;
+					++shapeCounts[f->GetType()];
+				}
+			}
+
+			int32 jointCounts[b2_jointTypeCount] = {0};
+			for (b2Joint* j = world->GetJointList(); j; j = j->GetNext())
+			{
+				++jointCounts[j->GetType()];
+			}
+
+			capacity.bodyCount = b2Max(capacity.bodyCount, world->GetBodyCount());
+			capacity.fixtureCount = b2Max(capacity.fixtureCount, fixtureCount);
+			capacity.proxyCount = b2Max(capacity.proxyCount, world->GetProxyCount());
+			capacity.contactCount = b2Max(capacity.contactCount, world->GetContactCount());
+			capacity.jointCount = b2Max(capacity.jointCount, world->GetJointCount());
+			for (int32 j = 0; j < b2Shape::e_typeCount; ++j)
+			{
+				capacity.shapeCounts[j] = b2Max(capacity.shapeCounts[j], shapeCounts[j]);
+			}
+			for (int32 j = 0; j < b2_jointTypeCount; ++j)
+			{
+				capacity.jointCounts[j] = b2Max(capacity.jointCounts[j], jointCounts[j]);
+			}
+
+			if (i < stepCount)
+			{
+				// New contacts are created before the step destroys the
+				// ones that stopped overlapping.
+				int32 contactCount = world->GetContactCount();
+				scene->Step(i);
+				world->Step(kTimeStep, kVelocityIterations, kPositionIterations);
+
+				const b2Metrics& metrics = world->GetMetrics();
+				capacity.contactCount = b2Max(capacity.contactCount, contactCount + metrics.contactsCreated);
+				capacity.pairCount = b2Max(capacity.pairCount, metrics.pairsBuffered);
+			}
+		}
+		delete scene;
+		delete world;
+		return capacity;
+	}
+
+	void RunScene(const SceneEntry& entry, int32 stepCount, const char* recordPath, const char* tracePath, bool reserve, bool reuseManifolds, bool last)
+	{
+		b2Recorder recorder;
+
+		b2WorldCapacity capacity;
+		if (reserve)
+		{
+			capacity = MeasureCapacity(entry, stepCount);
+		}
+
+		b2Timer timer;
+		b2World* world = new b2World(b2Vec2(0.0f, -10.0f));
+		if (reserve)
+		{
+			world->Reserve(capacity);
+		}
+		world->SetManifoldReuse(reuseManifolds);
+		if (recordPath)
+		{
+			world->SetRecorder(&recorder);
+		}
+		Scene* scene = entry.createFcn(world);
+		float32 buildTime = timer.GetMilliseconds();
+
+		if (tracePath)
+		{
+			b2TraceStart(1 << 20);
+		}
+
+		world->ResetProfileStats();
+		MetricStats metrics;
+		int64 totalTime = 0;
+		for (int32 i = 0; i < stepCount; ++i)
+		{
+			scene->Step(i);
+
+			timer.Reset();
+			world->Step(kTimeStep, kVelocityIterations, kPositionIterations);
+			totalTime += timer.GetNanoseconds();
+
+			metrics.Add(world->GetMetrics());
+		}
+
+		if (tracePath)
+		{
+			b2TraceStop();
+			ExportTrace(tracePath);
+			b2TraceFree();
+		}
+
+		// Compare copying the final world with building the scene from scratch.
+		world->SetRecorder(NULL);
+		timer.Reset();
+		b2World* copy = world->Clone();
+		float32 cloneTime = timer.GetMilliseconds();
+		delete copy;
+
+		if (recordPath && WriteFile(recordPath, recorder.GetData(), recorder.GetSize()) == false)
+		{
+			fprintf(stderr, "Could not write %s\n", recordPath);
+		}
+
+		printf("\t\t{\n");
+		printf("\t\t\t\"name\": \"%s\",\n", entry.name);
+		printf("\t\t\t\"steps\": %d,\n", stepCount);
+		printf("\t\t\t\"bodies\": %d,\n", world->GetBodyCount());
+		printf("\t\t\t\"joints\": %d,\n", world->GetJointCount());
+		printf("\t\t\t\"contacts\": %d,\n", world->GetContactCount());
+		printf("\t\t\t\"totalMs\": %.3f,\n", 1.0e-6 * totalTime);
+		printf("\t\t\t\"stepsPerSecond\": %.2f,\n", totalTime > 0 ? 1.0e9 * stepCount / totalTime : 0.0);
+		printf("\t\t\t\"buildMs\": %.3f,\n", buildTime);
+		printf("\t\t\t\"cloneMs\": %.3f,\n", cloneTime);
+		printf("\t\t\t\"peakMemoryKB\": %ld,\n", PeakMemoryKB());
+		printf("\t\t\t\"reserved\": %s,\n", reserve ? "true" : "false");
+		printf("\t\t\t\"manifoldReuse\": %s,\n", reuseManifolds ? "true" : "false");
+		printf("\t\t\t\"growths\": %d,\n", world->GetGrowthCount());
+		PrintProfile(world->GetProfileStats(), "\t\t\t");
+		printf(",\n");
+		PrintMetrics(metrics, "\t\t\t");
+		printf(",\n");
+		PrintMemory(world, "\t\t\t");
+		printf("\n\t\t}%s\n", last ? "" : ",");
+
+		delete scene;
+		delete world;
+	}
+
+	int Replay(const char* path)
+	{
+		int32 size = 0;
+		void* data = ReadFile(path, &size);
+		if (data == NULL)
+		{
+			fprintf(stderr, "Could not read %s\n", path);
+			return 1;
+		}
+
+		b2Replayer replayer(data, size);
+
+		printf("{\n\t\"replay\": \"%s\",\n\t\"stepProfiles\": [\n", path);
+		bool first = true;
+		while (replayer.Step())
+		{
+			const b2Profile& profile = replayer.GetWorld()->GetProfile();
+
+			printf("%s\t\t[", first ? "" : ",\n");
+			for (int32 i = 0; i < kProfileCount; ++i)
+			{
+				printf("%s%.4f", i > 0 ? ", " : "", profile.*kProfileFields[i].time);
+			}
+			printf("]");
+			first = false;
+		}
+		printf("\n\t],\n");
+		printf("\t\"steps\": %d,\n", replayer.GetStepCount());
+		printf("\t\"error\": %s,\n", replayer.HasError() ? "true" : "false");
+		printf("\t\"peakMemoryKB\": %ld,\n", PeakMemoryKB());
+		b2ProfileStats stats;
+		memset(&stats, 0, sizeof(stats));
+		if (replayer.GetWorld())
+		{
+			stats = replayer.GetWorld()->GetProfileStats();
+		}
+		PrintProfile(stats, "\t");
+		printf("\n}\n");
+
+		free(data);
+		return replayer.HasError() ? 1 : 0;
+	}
+
+	void Usage()
+	{
+		fprintf(stderr,
+			"usage: Benchmark [--scene name] [--steps count] [--record file] [--trace file] [--reserve] [--reuse-manifolds]\n"
+			"       Benchmark --replay file\n"
+			"Runs the benchmark scenes and prints the results as JSON.\n"
+			"--trace writes a Chrome trace of the scene when built with BOX2D_ENABLE_TRACE.\n"
+			"--reserve sizes the world from a dry run first, so growths should stay at zero.\n"
+			"--reuse-manifolds turns on b2World::SetManifoldReuse.\n"
+			"Per-step profiles of a replay are in the order");
+		for (int32 i = 0; i < kProfileCount; ++i)
+		{
+			fprintf(stderr, " %s", kProfileFields[i].name);
+		}
+		fprintf(stderr, ".\nScenes:");
+		for (int32 i = 0; g_sceneEntries[i].name; ++i)
+		{
+			fprintf(stderr, " %s", g_sceneEntries[i].name);
+		}
+		fprintf(stderr, "\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const char* sceneName = NULL;
+	const char* recordPath = NULL;
+	const char* replayPath = NULL;
+	const char* tracePath = NULL;
+	int32 stepCount = 600;
+	bool reserve = false;
+	bool reuseManifolds = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc)
+		{
+			sceneName = argv[++i];
+		}
+		else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+		{
+			stepCount = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+		{
+			recordPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+		{
+			replayPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+		{
+			tracePath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--reserve") == 0)
+		{
+			reserve = true;
+		}
+		else if (strcmp(argv[i], "--reuse-manifolds") == 0)
+		{
+			reuseManifolds = true;
+		}
+		else
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	if (replayPath)
+	{
+		return Replay(replayPath);
+	}
+
+	if ((recordPath || tracePath) && sceneName == NULL)
+	{
+		fprintf(stderr, "--record and --trace need --scene\n");
+		return 1;
+	}
+
+	int32 count = 0;
+	int32 matches = 0;
+	for (; g_sceneEntries[count].name; ++count)
+	{
+		if (sceneName == NULL || strcmp(sceneName, g_sceneEntries[count].name) == 0)
+		{
+			++matches;
+		}
+	}
+
+	if (matches == 0)
+	{
+		Usage();
+		return 1;
+	}
+
+	printf("{\n");
+	printf("\t\"version\": \"%d.%d.%d\",\n", b2_version.major, b2_version.minor, b2_version.revision);
+	printf("\t\"timeStep\": %.6f,\n", kTimeStep);
+	printf("\t\"scenes\": [\n");
+	for (int32 i = 0; i < count; ++i)
+	{
+		const SceneEntry& entry = g_sceneEntries[i];
+		if (sceneName && strcmp(sceneName, entry.name) != 0)
+		{
+			continue;
+		}
+
+		--matches;
+		RunScene(entry, stepCount, recordPath, tracePath, reserve, reuseManifolds, matches == 0);
+	}
+	printf("\t]\n}\n");
+
+	return 0;
+}
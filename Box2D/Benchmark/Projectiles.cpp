@@ -0,0 +1,203 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Compares the ways of keeping fast bodies from tunneling. Small circles and
+// boxes are fired in all directions inside a closed arena of edges, with a
+// thin wall across the middle. One in ten is a bullet. Every configuration
+// runs the same scene and reports:
+//   stepMs    - the mean time per step
+//   toiMs     - the mean time per step spent in time of impact sub-steps
+//   toiEvents - the number of time of impact sub-steps over the run
+//   escaped   - the projectiles that left the arena through a wall
+
+#include <Box2D/Box2D.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+	struct Config
+	{
+		const char* name;
+		bool continuous;
+		bool speculative;
+	};
+
+	const Config kConfigs[] =
+	{
+		{"discrete", false, false},
+		{"continuous", true, false},
+		{"speculative", true, true},
+	};
+	const int32 kConfigCount = sizeof(kConfigs) / sizeof(kConfigs[0]);
+
+	const float32 kTimeStep = 1.0f / 60.0f;
+	const float32 kArenaSize = 15.0f;
+	const int32 kBulletInterval = 10;
+
+	// A fixed generator, so every configuration sees the same projectiles.
+	float32 Random(uint32* seed, float32 lo, float32 hi)
+	{
+		*seed = *seed * 1664525u + 1013904223u;
+		return lo + (hi - lo) * float32(*seed >> 8) / float32(1 << 24);
+	}
+
+	void Build(b2World* world, int32 count, float32 speed, b2Body** projectiles)
+	{
+		b2BodyDef bd;
+		b2Body* ground = world->CreateBody(&bd);
+
+		b2Vec2 corners[4] =
+		{
+			b2Vec2(-kArenaSize, -kArenaSize),
+			b2Vec2(kArenaSize, -kArenaSize),
+			b2Vec2(kArenaSize, kArenaSize),
+			b2Vec2(-kArenaSize, kArenaSize)
+		};
+
+		b2EdgeShape edge;
+		for (int32 i = 0; i < 4; ++i)
+		{
+			edge.Set(corners[i], corners[(i + 1) % 4]);
+			ground->CreateFixture(&edge, 0.0f);
+		}
+
+		edge.Set(b2Vec2(-0.5f * kArenaSize, 0.0f), b2Vec2(0.5f * kArenaSize, 0.0f));
+		ground->CreateFixture(&edge, 0.0f);
+
+		b2CircleShape circle;
+		circle.m_radius = 0.15f;
+
+		b2PolygonShape box;
+		box.SetAsBox(0.15f, 0.15f);
+
+		b2FixtureDef fd;
+		fd.density = 1.0f;
+		fd.friction = 0.4f;
+		fd.restitution = 0.4f;
+
+		uint32 seed = 12345;
+		bd.type = b2_dynamicBody;
+		for (int32 i = 0; i < count; ++i)
+		{
+			float32 angle = Random(&seed, -b2_pi, b2_pi);
+			float32 s = Random(&seed, 0.5f * speed, speed);
+			bd.position.Set(Random(&seed, -0.9f, 0.9f) * kArenaSize, Random(&seed, 0.1f, 0.9f) * kArenaSize);
+			bd.linearVelocity.Set(s * cosf(angle), s * sinf(angle));
+			bd.angularVelocity = Random(&seed, -10.0f, 10.0f);
+			bd.bullet = i % kBulletInterval == 0;
+			projectiles[i] = world->CreateBody(&bd);
+
+			fd.shape = i % 2 == 0 ? (b2Shape*)&circle : (b2Shape*)&box;
+			projectiles[i]->CreateFixture(&fd);
+		}
+	}
+
+	void Run(const Config& config, int32 count, float32 speed, int32 stepCount, b2Body** projectiles, bool last)
+	{
+		b2World world(b2Vec2(0.0f, -10.0f));
+		world.SetContinuousPhysics(config.continuous);
+		world.SetSpeculativeContacts(config.speculative);
+
+		Build(&world, count, speed, projectiles);
+
+		int32 toiEvents = 0;
+		int64 start = b2Timer::GetTimestamp();
+		for (int32 i = 0; i < stepCount; ++i)
+		{
+			world.Step(kTimeStep, 8, 3);
+			toiEvents += world.GetMetrics().toiEvents;
+		}
+		int64 elapsed = b2Timer::GetTimestamp() - start;
+
+		int32 escaped = 0;
+		for (int32 i = 0; i < count; ++i)
+		{
+			b2Vec2 p = projectiles[i]->GetPosition();
+			if (b2Abs(p.x) > kArenaSize || b2Abs(p.y) > kArenaSize)
+			{
+				++escaped;
+			}
+		}
+
+		const b2ProfileStats& stats = world.GetProfileStats();
+		printf("\t\t{\"mode\": \"%s\", \"stepMs\": %.4f, \"toiMs\": %.4f, \"toiEvents\": %d, \"escaped\": %d}%s\n",
+			config.name, 1.0e-6 * elapsed / stepCount, 1.0e-6 * stats.solveTOI.total / stats.stepCount,
+			toiEvents, escaped, last ? "" : ",");
+	}
+
+	void Usage()
+	{
+		fprintf(stderr,
+			"usage: ProjectileBenchmark [--steps count] [--count projectiles] [--speed metersPerSecond]\n"
+			"Runs the projectile arena with discrete, continuous and speculative collision.\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int32 stepCount = 600;
+	int32 count = 400;
+	float32 speed = 120.0f;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+		{
+			stepCount = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--count") == 0 && i + 1 < argc)
+		{
+			count = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc)
+		{
+			speed = (float32)atof(argv[++i]);
+		}
+		else
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	if (stepCount < 1 || count < 1 || speed <= 0.0f)
+	{
+		Usage();
+		return 1;
+	}
+
+	b2Body** projectiles = new b2Body*[count];
+
+	printf("{\n");
+	printf("\t\"steps\": %d,\n", stepCount);
+	printf("\t\"projectiles\": %d,\n", count);
+	printf("\t\"speed\": %.1f,\n", speed);
+	printf("\t\"runs\": [\n");
+	for (int32 c = 0; c < kConfigCount; ++c)
+	{
+		Run(kConfigs[c], count, speed, stepCount, projectiles, c == kConfigCount - 1);
+	}
+	printf("\t]\n}\n");
+
+	delete[] projectiles;
+
+	return 0;
+}
@@ -0,0 +1,45 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Scene.h"
+
+Scene::Scene(b2World* world)
+{
+	m_world = world;
+}
+
+Scene::~Scene()
+{
+}
+
+void Scene::Step(int32 stepIndex)
+{
+	B2_NOT_USED(stepIndex);
+}
+
+b2Body* Scene::CreateGround(float32 halfWidth)
+{
+	b2BodyDef bd;
+	b2Body* ground = m_world->CreateBody(&bd);
+
+	b2EdgeShape shape;
+	shape.Set(b2Vec2(-halfWidth, 0.0f), b2Vec2(halfWidth, 0.0f));
+	ground->CreateFixture(&shape, 0.0f);
+
+	return ground;
+}
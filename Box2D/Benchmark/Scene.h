@@ -0,0 +1,52 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <Box2D/Box2D.h>
+
+/// A benchmark scene populates a world and may drive it between steps.
+/// Scenes must be deterministic so runs can be compared.
+class Scene
+{
+public:
+	Scene(b2World* world);
+	virtual ~Scene();
+
+	/// Called before every time step.
+	virtual void Step(int32 stepIndex);
+
+protected:
+	/// Create a static ground edge spanning [-halfWidth, halfWidth] at y = 0.
+	b2Body* CreateGround(float32 halfWidth);
+
+	b2World* m_world;
+};
+
+typedef Scene* SceneCreateFcn(b2World* world);
+
+struct SceneEntry
+{
+	const char* name;
+	SceneCreateFcn* createFcn;
+};
+
+extern SceneEntry g_sceneEntries[];
+
+#endif
@@ -0,0 +1,105 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef BRIDGES_H
+#define BRIDGES_H
+
+/// Rope bridges with hanging loads and welded posts. The revolute, distance
+/// and weld joints are created interleaved, so this stresses joint dispatch.
+class Bridges : public Scene
+{
+public:
+	enum
+	{
+		e_bridgeCount = 10,
+		e_plankCount = 40
+	};
+
+	Bridges(b2World* world) : Scene(world)
+	{
+		b2Body* ground = CreateGround(40.0f);
+
+		for (int32 i = 0; i < e_bridgeCount; ++i)
+		{
+			CreateBridge(ground, 5.0f + 6.0f * i);
+		}
+	}
+
+	b2Body* CreateBox(const b2Vec2& position, float32 hx, float32 hy, float32 density)
+	{
+		b2BodyDef bd;
+		bd.type = b2_dynamicBody;
+		bd.position = position;
+		b2Body* body = m_world->CreateBody(&bd);
+
+		b2PolygonShape shape;
+		shape.SetAsBox(hx, hy);
+
+		b2FixtureDef fd;
+		fd.shape = &shape;
+		fd.density = density;
+		fd.friction = 0.2f;
+		body->CreateFixture(&fd);
+
+		return body;
+	}
+
+	void CreateBridge(b2Body* ground, float32 y)
+	{
+		float32 x0 = -0.5f * e_plankCount;
+
+		b2RevoluteJointDef rjd;
+		b2DistanceJointDef djd;
+		b2WeldJointDef wjd;
+
+		b2Body* prevBody = ground;
+		for (int32 i = 0; i < e_plankCount; ++i)
+		{
+			float32 x = x0 + 0.5f + i;
+			b2Body* plank = CreateBox(b2Vec2(x, y), 0.5f, 0.125f, 20.0f);
+
+			rjd.Initialize(prevBody, plank, b2Vec2(x - 0.5f, y));
+			m_world->CreateJoint(&rjd);
+
+			// A load hanging below the plank.
+			b2Body* load = CreateBox(b2Vec2(x, y - 2.0f), 0.2f, 0.2f, 5.0f);
+			djd.Initialize(plank, load, b2Vec2(x, y), load->GetPosition());
+			m_world->CreateJoint(&djd);
+
+			if (i % 4 == 0)
+			{
+				// A post welded on top of the plank.
+				b2Body* post = CreateBox(b2Vec2(x, y + 0.625f), 0.05f, 0.5f, 1.0f);
+				wjd.Initialize(plank, post, b2Vec2(x, y + 0.125f));
+				m_world->CreateJoint(&wjd);
+			}
+
+			prevBody = plank;
+		}
+
+		rjd.Initialize(prevBody, ground, b2Vec2(x0 + e_plankCount, y));
+		m_world->CreateJoint(&rjd);
+	}
+
+	static Scene* Create(b2World* world)
+	{
+		return new Bridges(world);
+	}
+};
+
+#endif
@@ -0,0 +1,85 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef BULLETS_H
+#define BULLETS_H
+
+/// Fast bullets fired into box stacks. This stresses continuous collision.
+class Bullets : public Scene
+{
+public:
+	enum
+	{
+		e_columns = 10,
+		e_rows = 10,
+		e_bulletCount = 100,
+		e_fireInterval = 5
+	};
+
+	Bullets(b2World* world) : Scene(world)
+	{
+		CreateGround(60.0f);
+
+		b2PolygonShape shape;
+		shape.SetAsBox(0.5f, 0.5f);
+
+		for (int32 i = 0; i < e_columns; ++i)
+		{
+			for (int32 j = 0; j < e_rows; ++j)
+			{
+				b2BodyDef bd;
+				bd.type = b2_dynamicBody;
+				bd.position.Set(10.0f + 1.5f * i, 0.5f + 1.01f * j);
+				b2Body* body = m_world->CreateBody(&bd);
+				body->CreateFixture(&shape, 1.0f);
+			}
+		}
+
+		m_count = 0;
+	}
+
+	void Step(int32 stepIndex)
+	{
+		if (m_count == e_bulletCount || stepIndex % e_fireInterval != 0)
+		{
+			return;
+		}
+
+		b2CircleShape shape;
+		shape.m_radius = 0.125f;
+
+		b2BodyDef bd;
+		bd.type = b2_dynamicBody;
+		bd.bullet = true;
+		bd.position.Set(-40.0f, 1.0f + 0.9f * (m_count % e_rows));
+		bd.linearVelocity.Set(400.0f, 0.0f);
+		b2Body* body = m_world->CreateBody(&bd);
+		body->CreateFixture(&shape, 20.0f);
+
+		++m_count;
+	}
+
+	static Scene* Create(b2World* world)
+	{
+		return new Bullets(world);
+	}
+
+	int32 m_count;
+};
+
+#endif
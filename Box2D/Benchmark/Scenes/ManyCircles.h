@@ -0,0 +1,74 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef MANY_CIRCLES_H
+#define MANY_CIRCLES_H
+
+/// Thousands of circles settling in a bin. This stresses the broad-phase.
+class ManyCircles : public Scene
+{
+public:
+	enum
+	{
+		e_columns = 50,
+		e_rows = 40
+	};
+
+	ManyCircles(b2World* world) : Scene(world)
+	{
+		b2BodyDef bd;
+		b2Body* ground = m_world->CreateBody(&bd);
+
+		b2EdgeShape edge;
+		edge.Set(b2Vec2(-30.0f, 0.0f), b2Vec2(30.0f, 0.0f));
+		ground->CreateFixture(&edge, 0.0f);
+		edge.Set(b2Vec2(-30.0f, 0.0f), b2Vec2(-30.0f, 80.0f));
+		ground->CreateFixture(&edge, 0.0f);
+		edge.Set(b2Vec2(30.0f, 0.0f), b2Vec2(30.0f, 80.0f));
+		ground->CreateFixture(&edge, 0.0f);
+
+		b2CircleShape shape;
+		shape.m_radius = 0.5f;
+
+		b2FixtureDef fd;
+		fd.shape = &shape;
+		fd.density = 1.0f;
+		fd.friction = 0.3f;
+
+		for (int32 i = 0; i < e_rows; ++i)
+		{
+			for (int32 j = 0; j < e_columns; ++j)
+			{
+				// Stagger the rows so the pile does not settle into a grid.
+				float32 offset = (i & 1) ? 0.25f : -0.25f;
+
+				bd.type = b2_dynamicBody;
+				bd.position.Set(-27.0f + 1.1f * j + offset, 1.0f + 1.1f * i);
+				b2Body* body = m_world->CreateBody(&bd);
+				body->CreateFixture(&fd);
+			}
+		}
+	}
+
+	static Scene* Create(b2World* world)
+	{
+		return new ManyCircles(world);
+	}
+};
+
+#endif
@@ -0,0 +1,69 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef PYRAMID_H
+#define PYRAMID_H
+
+/// A large box pyramid. This stresses the contact solver and island sleeping.
+class Pyramid : public Scene
+{
+public:
+	enum
+	{
+		e_count = 40
+	};
+
+	Pyramid(b2World* world) : Scene(world)
+	{
+		CreateGround(60.0f);
+
+		float32 a = 0.5f;
+		b2PolygonShape shape;
+		shape.SetAsBox(a, a);
+
+		b2Vec2 x(-0.5f * e_count, 0.75f);
+		b2Vec2 y;
+		b2Vec2 deltaX(0.5625f, 1.25f);
+		b2Vec2 deltaY(1.125f, 0.0f);
+
+		for (int32 i = 0; i < e_count; ++i)
+		{
+			y = x;
+
+			for (int32 j = i; j < e_count; ++j)
+			{
+				b2BodyDef bd;
+				bd.type = b2_dynamicBody;
+				bd.position = y;
+				b2Body* body = m_world->CreateBody(&bd);
+				body->CreateFixture(&shape, 5.0f);
+
+				y += deltaY;
+			}
+
+			x += deltaX;
+		}
+	}
+
+	static Scene* Create(b2World* world)
+	{
+		return new Pyramid(world);
+	}
+};
+
+#endif
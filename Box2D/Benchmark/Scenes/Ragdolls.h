@@ -0,0 +1,109 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef RAGDOLLS_H
+#define RAGDOLLS_H
+
+/// A pile of jointed ragdolls. This stresses the joint solver.
+class Ragdolls : public Scene
+{
+public:
+	enum
+	{
+		e_count = 100
+	};
+
+	Ragdolls(b2World* world) : Scene(world)
+	{
+		CreateGround(40.0f);
+
+		for (int32 i = 0; i < e_count; ++i)
+		{
+			float32 x = -10.0f + 5.0f * (i % 5);
+			float32 y = 4.0f + 3.0f * (i / 5);
+			CreateRagdoll(b2Vec2(x, y), i);
+		}
+	}
+
+	b2Body* CreatePart(const b2Vec2& position, const b2Shape* shape, int16 group)
+	{
+		b2BodyDef bd;
+		bd.type = b2_dynamicBody;
+		bd.position = position;
+		b2Body* body = m_world->CreateBody(&bd);
+
+		b2FixtureDef fd;
+		fd.shape = shape;
+		fd.density = 1.0f;
+		fd.friction = 0.4f;
+		fd.filter.groupIndex = group;
+		body->CreateFixture(&fd);
+
+		return body;
+	}
+
+	void Connect(b2Body* bodyA, b2Body* bodyB, const b2Vec2& anchor, float32 lower, float32 upper)
+	{
+		b2RevoluteJointDef jd;
+		jd.Initialize(bodyA, bodyB, anchor);
+		jd.enableLimit = true;
+		jd.lowerAngle = lower;
+		jd.upperAngle = upper;
+		m_world->CreateJoint(&jd);
+	}
+
+	void CreateRagdoll(const b2Vec2& p, int32 index)
+	{
+		// The parts of one ragdoll never collide with each other.
+		int16 group = (int16)(-1 - index);
+
+		b2PolygonShape torsoShape;
+		torsoShape.SetAsBox(0.25f, 0.5f);
+		b2Body* torso = CreatePart(p, &torsoShape, group);
+
+		b2CircleShape headShape;
+		headShape.m_radius = 0.2f;
+		b2Body* head = CreatePart(p + b2Vec2(0.0f, 0.75f), &headShape, group);
+		Connect(torso, head, p + b2Vec2(0.0f, 0.5f), -0.25f * b2_pi, 0.25f * b2_pi);
+
+		b2PolygonShape limbShape;
+		limbShape.SetAsBox(0.1f, 0.3f);
+
+		for (int32 side = -1; side <= 1; side += 2)
+		{
+			float32 s = (float32)side;
+
+			b2Body* upperArm = CreatePart(p + b2Vec2(0.35f * s, 0.15f), &limbShape, group);
+			Connect(torso, upperArm, p + b2Vec2(0.3f * s, 0.45f), -0.5f * b2_pi, 0.5f * b2_pi);
+			b2Body* lowerArm = CreatePart(p + b2Vec2(0.35f * s, -0.45f), &limbShape, group);
+			Connect(upperArm, lowerArm, p + b2Vec2(0.35f * s, -0.15f), -0.5f * b2_pi, 0.0f);
+
+			b2Body* upperLeg = CreatePart(p + b2Vec2(0.15f * s, -0.8f), &limbShape, group);
+			Connect(torso, upperLeg, p + b2Vec2(0.15f * s, -0.5f), -0.25f * b2_pi, 0.25f * b2_pi);
+			b2Body* lowerLeg = CreatePart(p + b2Vec2(0.15f * s, -1.4f), &limbShape, group);
+			Connect(upperLeg, lowerLeg, p + b2Vec2(0.15f * s, -1.1f), 0.0f, 0.5f * b2_pi);
+		}
+	}
+
+	static Scene* Create(b2World* world)
+	{
+		return new Ragdolls(world);
+	}
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+/// Bodies scattered over a long static chain. This stresses chain contacts
+/// and the query cost of a large static tree.
+class Terrain : public Scene
+{
+public:
+	enum
+	{
+		e_vertexCount = 4000,
+		e_bodyCount = 1000
+	};
+
+	Terrain(b2World* world) : Scene(world)
+	{
+		float32 halfWidth = 1000.0f;
+		float32 dx = 2.0f * halfWidth / (e_vertexCount - 1);
+
+		b2Vec2* vertices = (b2Vec2*)b2Alloc(e_vertexCount * sizeof(b2Vec2));
+		for (int32 i = 0; i < e_vertexCount; ++i)
+		{
+			float32 x = -halfWidth + dx * i;
+			vertices[i].Set(x, 2.0f * sinf(0.05f * x) + 0.5f * sinf(0.73f * x));
+		}
+
+		b2BodyDef bd;
+		b2Body* ground = m_world->CreateBody(&bd);
+		b2ChainShape chain;
+		chain.CreateChain(vertices, e_vertexCount);
+		ground->CreateFixture(&chain, 0.0f);
+		b2Free(vertices);
+
+		b2CircleShape circle;
+		circle.m_radius = 0.5f;
+		b2PolygonShape box;
+		box.SetAsBox(0.5f, 0.5f);
+
+		float32 spacing = 2.0f * (halfWidth - 10.0f) / e_bodyCount;
+		for (int32 i = 0; i < e_bodyCount; ++i)
+		{
+			bd.type = b2_dynamicBody;
+			bd.position.Set(-halfWidth + 10.0f + spacing * i, 5.0f + (i % 7));
+			b2Body* body = m_world->CreateBody(&bd);
+			body->CreateFixture((i & 1) ? (b2Shape*)&circle : (b2Shape*)&box, 1.0f);
+		}
+	}
+
+	static Scene* Create(b2World* world)
+	{
+		return new Terrain(world);
+	}
+};
+
+#endif
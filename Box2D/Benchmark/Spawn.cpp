@@ -0,0 +1,259 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Measures spawning and despawning a wave of crates into a world that already
+// holds a resident pile. Each wave is created and destroyed either
+//   single - with CreateBody, b2Body::CreateFixture and DestroyBody per body
+//   each   - with one CreateBodies and DestroyBodies call per body, which is
+//            what MXWorld -addBody: and -removeBody: issue
+//   batch  - with one b2World::CreateBodies and b2World::DestroyBodies call,
+//            which is what MXWorld -addBodies: and -removeBodies: issue
+// The first step after the spawn is timed as well, since it finds the new pairs.
+// With --no-step the wave is destroyed while its proxies are still buffered.
+
+#include <Box2D/Box2D.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+	enum Mode
+	{
+		e_single,
+		e_each,
+		e_batch,
+		e_modeCount
+	};
+
+	const char* const kModeNames[e_modeCount] = {"single", "each", "batch"};
+
+	const int32 kColumns = 50;
+
+	struct Wave
+	{
+		int32 count;
+		b2BodyDef* bodyDefs;
+		int32* fixtureCounts;
+		b2FixtureDef* fixtureDefs;
+		b2Body** bodies;
+	};
+
+	void BuildResidents(b2World* world, const b2Shape* box, int32 count)
+	{
+		b2BodyDef bd;
+		b2Body* ground = world->CreateBody(&bd);
+		b2EdgeShape edge;
+		edge.Set(b2Vec2(-200.0f, 0.0f), b2Vec2(200.0f, 0.0f));
+		ground->CreateFixture(&edge, 0.0f);
+
+		bd.type = b2_dynamicBody;
+		for (int32 i = 0; i < count; ++i)
+		{
+			bd.position.Set(-100.0f + 1.0f * (i % kColumns), 0.5f + 1.0f * (i / kColumns));
+			world->CreateBody(&bd)->CreateFixture(box, 1.0f);
+		}
+	}
+
+	void SpawnSingle(b2World* world, Wave* wave)
+	{
+		for (int32 i = 0; i < wave->count; ++i)
+		{
+			b2Body* body = world->CreateBody(wave->bodyDefs + i);
+			body->CreateFixture(wave->fixtureDefs + i);
+			wave->bodies[i] = body;
+		}
+	}
+
+	void DespawnSingle(b2World* world, Wave* wave)
+	{
+		for (int32 i = 0; i < wave->count; ++i)
+		{
+			world->DestroyBody(wave->bodies[i]);
+		}
+	}
+
+	void SpawnEach(b2World* world, Wave* wave)
+	{
+		int32 fixtureIndex = 0;
+		for (int32 i = 0; i < wave->count; ++i)
+		{
+			world->CreateBodies(1, wave->bodyDefs + i, wave->fixtureCounts + i, wave->fixtureDefs + fixtureIndex, wave->bodies + i, NULL);
+			fixtureIndex += wave->fixtureCounts[i];
+		}
+	}
+
+	void DespawnEach(b2World* world, Wave* wave)
+	{
+		for (int32 i = 0; i < wave->count; ++i)
+		{
+			world->DestroyBodies(1, wave->bodies + i);
+		}
+	}
+
+	void RunMode(Mode mode, int32 residentCount, int32 waveCount, bool step, Wave* wave, bool last)
+	{
+		b2PolygonShape box;
+		box.SetAsBox(0.5f, 0.5f);
+
+		b2World world(b2Vec2(0.0f, -10.0f));
+		BuildResidents(&world, &box, residentCount);
+
+		for (int32 i = 0; i < wave->count; ++i)
+		{
+			wave->fixtureDefs[i].shape = &box;
+		}
+
+		int64 spawnTime = 0;
+		int64 stepTime = 0;
+		int64 despawnTime = 0;
+		int32 treeHeight = 0;
+
+		for (int32 w = 0; w < waveCount; ++w)
+		{
+			int64 start = b2Timer::GetTimestamp();
+			if (mode == e_batch)
+			{
+				world.CreateBodies(wave->count, wave->bodyDefs, wave->fixtureCounts, wave->fixtureDefs, wave->bodies, NULL);
+			}
+			else if (mode == e_each)
+			{
+				SpawnEach(&world, wave);
+			}
+			else
+			{
+				SpawnSingle(&world, wave);
+			}
+			int64 spawned = b2Timer::GetTimestamp();
+
+			if (step)
+			{
+				world.Step(1.0f / 60.0f, 8, 3);
+			}
+			int64 stepped = b2Timer::GetTimestamp();
+			treeHeight = b2Max(treeHeight, world.GetTreeHeight());
+
+			if (mode == e_batch)
+			{
+				world.DestroyBodies(wave->count, wave->bodies);
+			}
+			else if (mode == e_each)
+			{
+				DespawnEach(&world, wave);
+			}
+			else
+			{
+				DespawnSingle(&world, wave);
+			}
+			int64 despawned = b2Timer::GetTimestamp();
+
+			spawnTime += spawned - start;
+			stepTime += stepped - spawned;
+			despawnTime += despawned - stepped;
+		}
+
+		float64 scale = 1.0e-6 / b2Max(waveCount, 1);
+		printf("\t\t{\"mode\": \"%s\", \"spawnMs\": %.3f, \"firstStepMs\": %.3f, \"despawnMs\": %.3f, \"treeHeight\": %d}%s\n",
+			kModeNames[mode], scale * spawnTime, scale * stepTime, scale * despawnTime, treeHeight, last ? "" : ",");
+	}
+
+	void Usage()
+	{
+		fprintf(stderr,
+			"usage: SpawnBenchmark [--bodies count] [--residents count] [--waves count] [--no-step]\n"
+			"Spawns and despawns waves of crates one body at a time and in batches.\n"
+			"--bodies is the wave size and --residents the size of the resident pile.\n"
+			"--no-step destroys each wave without stepping the world first.\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int32 bodyCount = 2000;
+	int32 residentCount = 2000;
+	int32 waveCount = 20;
+	bool step = true;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--bodies") == 0 && i + 1 < argc)
+		{
+			bodyCount = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--residents") == 0 && i + 1 < argc)
+		{
+			residentCount = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--waves") == 0 && i + 1 < argc)
+		{
+			waveCount = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--no-step") == 0)
+		{
+			step = false;
+		}
+		else
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	if (bodyCount < 1 || residentCount < 0 || waveCount < 1)
+	{
+		Usage();
+		return 1;
+	}
+
+	// The wave drops in above the resident pile.
+	Wave wave;
+	wave.count = bodyCount;
+	wave.bodyDefs = new b2BodyDef[bodyCount];
+	wave.fixtureCounts = new int32[bodyCount];
+	wave.fixtureDefs = new b2FixtureDef[bodyCount];
+	wave.bodies = new b2Body*[bodyCount];
+
+	float32 top = 2.0f + 1.0f * (residentCount / kColumns);
+	for (int32 i = 0; i < bodyCount; ++i)
+	{
+		wave.bodyDefs[i].type = b2_dynamicBody;
+		wave.bodyDefs[i].position.Set(-100.0f + 1.1f * (i % kColumns), top + 1.1f * (i / kColumns));
+		wave.fixtureCounts[i] = 1;
+		wave.fixtureDefs[i].density = 1.0f;
+	}
+
+	printf("{\n");
+	printf("\t\"bodies\": %d,\n", bodyCount);
+	printf("\t\"residents\": %d,\n", residentCount);
+	printf("\t\"waves\": %d,\n", waveCount);
+	printf("\t\"step\": %s,\n", step ? "true" : "false");
+	printf("\t\"runs\": [\n");
+	for (int32 mode = 0; mode < e_modeCount; ++mode)
+	{
+		RunMode((Mode)mode, residentCount, waveCount, step, &wave, mode == e_modeCount - 1);
+	}
+	printf("\t]\n}\n");
+
+	delete[] wave.bodyDefs;
+	delete[] wave.fixtureCounts;
+	delete[] wave.fixtureDefs;
+	delete[] wave.bodies;
+
+	return 0;
+}
@@ -0,0 +1,219 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Compares the island solvers on box stacks of increasing height. Every
+// configuration runs a column and a pyramid of each height with sleeping off
+// and reports the mean time per step and whether the stack still stands:
+//   drift - the largest horizontal distance a box moved from its start
+//   sink  - how far the top box ended below its start height
+// A stack is standing when no box drifted more than half a box width.
+
+#include <Box2D/Box2D.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+	enum Shape
+	{
+		e_column,
+		e_pyramid,
+		e_shapeCount
+	};
+
+	const char* const kShapeNames[e_shapeCount] = {"column", "pyramid"};
+
+	struct Config
+	{
+		const char* name;
+		b2SolverType solverType;
+		bool shockPropagation;
+		bool manifoldReuse;
+		int32 velocityIterations;
+		int32 positionIterations;
+	};
+
+	const Config kConfigs[] =
+	{
+		{"si-8-3", b2_sequentialImpulseSolver, false, false, 8, 3},
+		{"si-20-8", b2_sequentialImpulseSolver, false, false, 20, 8},
+		{"si-40-10", b2_sequentialImpulseSolver, false, false, 40, 10},
+		{"shock-8-3", b2_sequentialImpulseSolver, true, false, 8, 3},
+		{"reuse-8-3", b2_sequentialImpulseSolver, false, true, 8, 3},
+		{"soft-2", b2_softStepSolver, false, false, 2, 3},
+		{"soft-4", b2_softStepSolver, false, false, 4, 3},
+		{"soft-8", b2_softStepSolver, false, false, 8, 3},
+	};
+	const int32 kConfigCount = sizeof(kConfigs) / sizeof(kConfigs[0]);
+
+	const float32 kTimeStep = 1.0f / 60.0f;
+
+	// Returns the number of boxes.
+	int32 Build(b2World* world, Shape shape, int32 height, b2Body** boxes)
+	{
+		b2BodyDef bd;
+		b2Body* ground = world->CreateBody(&bd);
+		b2EdgeShape edge;
+		edge.Set(b2Vec2(-100.0f, 0.0f), b2Vec2(100.0f, 0.0f));
+		ground->CreateFixture(&edge, 0.0f);
+
+		b2PolygonShape box;
+		box.SetAsBox(0.5f, 0.5f);
+
+		b2FixtureDef fd;
+		fd.shape = &box;
+		fd.density = 1.0f;
+		fd.friction = 0.6f;
+
+		bd.type = b2_dynamicBody;
+		int32 count = 0;
+		for (int32 i = 0; i < height; ++i)
+		{
+			int32 rowCount = shape == e_column ? 1 : height - i;
+			for (int32 j = 0; j < rowCount; ++j)
+			{
+				bd.position.Set(-0.5f * rowCount + 0.5f + 1.0f * j, 0.5f + 1.0f * i);
+				boxes[count] = world->CreateBody(&bd);
+				boxes[count]->CreateFixture(&fd);
+				++count;
+			}
+		}
+
+		return count;
+	}
+
+	void Run(const Config& config, Shape shape, int32 height, int32 stepCount, b2Body** boxes, b2Vec2* starts, bool last)
+	{
+		b2World world(b2Vec2(0.0f, -10.0f));
+		world.SetAllowSleeping(false);
+		world.SetSolverType(config.solverType);
+		world.SetShockPropagation(config.shockPropagation);
+		world.SetManifoldReuse(config.manifoldReuse);
+
+		int32 count = Build(&world, shape, height, boxes);
+		for (int32 i = 0; i < count; ++i)
+		{
+			starts[i] = boxes[i]->GetPosition();
+		}
+
+		int64 start = b2Timer::GetTimestamp();
+		for (int32 i = 0; i < stepCount; ++i)
+		{
+			world.Step(kTimeStep, config.velocityIterations, config.positionIterations);
+		}
+		int64 elapsed = b2Timer::GetTimestamp() - start;
+
+		float32 drift = 0.0f;
+		for (int32 i = 0; i < count; ++i)
+		{
+			drift = b2Max(drift, b2Abs(boxes[i]->GetPosition().x - starts[i].x));
+		}
+		float32 sink = starts[count - 1].y - boxes[count - 1]->GetPosition().y;
+
+		printf("\t\t{\"solver\": \"%s\", \"shape\": \"%s\", \"height\": %d, \"boxes\": %d, \"stepMs\": %.4f, \"drift\": %.4f, \"sink\": %.4f, \"standing\": %s}%s\n",
+			config.name, kShapeNames[shape], height, count, 1.0e-6 * elapsed / stepCount,
+			drift, sink, drift < 0.5f ? "true" : "false", last ? "" : ",");
+	}
+
+	void Usage()
+	{
+		fprintf(stderr,
+			"usage: StackBenchmark [--steps count] [--heights h1,h2,...]\n"
+			"Runs box columns and pyramids of each height with every solver configuration.\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int32 stepCount = 600;
+	int32 heights[16] = {10, 20, 40};
+	int32 heightCount = 3;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+		{
+			stepCount = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--heights") == 0 && i + 1 < argc)
+		{
+			heightCount = 0;
+			for (char* p = argv[++i]; *p && heightCount < 16; )
+			{
+				heights[heightCount++] = (int32)strtol(p, &p, 10);
+				if (*p == ',')
+				{
+					++p;
+				}
+				else if (*p)
+				{
+					heightCount = 0;
+					break;
+				}
+			}
+		}
+		else
+		{
+			Usage();
+			return 1;
+		}
+	}
+
+	int32 maxHeight = 0;
+	for (int32 i = 0; i < heightCount; ++i)
+	{
+		maxHeight = b2Max(maxHeight, heights[i]);
+		if (heights[i] < 1)
+		{
+			heightCount = 0;
+		}
+	}
+
+	if (stepCount < 1 || heightCount == 0)
+	{
+		Usage();
+		return 1;
+	}
+
+	int32 maxCount = maxHeight * (maxHeight + 1) / 2;
+	b2Body** boxes = new b2Body*[maxCount];
+	b2Vec2* starts = new b2Vec2[maxCount];
+
+	printf("{\n");
+	printf("\t\"steps\": %d,\n", stepCount);
+	printf("\t\"runs\": [\n");
+	for (int32 s = 0; s < e_shapeCount; ++s)
+	{
+		for (int32 h = 0; h < heightCount; ++h)
+		{
+			for (int32 c = 0; c < kConfigCount; ++c)
+			{
+				bool last = s == e_shapeCount - 1 && h == heightCount - 1 && c == kConfigCount - 1;
+				Run(kConfigs[c], (Shape)s, heights[h], stepCount, boxes, starts, last);
+			}
+		}
+	}
+	printf("\t]\n}\n");
+
+	delete[] boxes;
+	delete[] starts;
+
+	return 0;
+}
@@ -24,8 +24,16 @@ using namespace std;
 
 b2ChainShape::~b2ChainShape()
 {
-	b2Free(m_vertices);
+	if (m_allocator)
+	{
+		m_allocator->Free(m_vertices, m_count * sizeof(b2Vec2), e_allocTagShape);
+	}
+	else
+	{
+		b2Free(m_vertices);
+	}
 	m_vertices = NULL;
+	m_allocator = NULL;
 	m_count = 0;
 }
 
@@ -68,9 +76,12 @@ void b2ChainShape::SetNextVertex(const b2Vec2& nextVertex)
 
 b2Shape* b2ChainShape::Clone(b2BlockAllocator* allocator) const
 {
-	void* mem = allocator->Allocate(sizeof(b2ChainShape));
+	void* mem = allocator->Allocate(sizeof(b2ChainShape), e_allocTagShape);
 	b2ChainShape* clone = new (mem) b2ChainShape;
-	clone->CreateChain(m_vertices, m_count);
+	clone->m_count = m_count;
+	clone->m_vertices = (b2Vec2*)allocator->Allocate(m_count * sizeof(b2Vec2), e_allocTagShape);
+	clone->m_allocator = allocator;
+	memcpy(clone->m_vertices, m_vertices, m_count * sizeof(b2Vec2));
 	clone->m_prevVertex = m_prevVertex;
 	clone->m_nextVertex = m_nextVertex;
 	clone->m_hasPrevVertex = m_hasPrevVertex;
@@ -26,7 +26,8 @@ class b2EdgeShape;
 /// A chain shape is a free form sequence of line segments.
 /// The chain has two-sided collision, so you can use inside and outside collision.
 /// Therefore, you may use any winding order.
-/// Since there may be many vertices, they are allocated using b2Alloc.
+/// Since there may be many vertices, they are allocated using b2Alloc. A clone
+/// keeps its vertices in the allocator it was cloned into.
 /// Connectivity information is used to create smooth collisions.
 /// WARNING: The chain will not collide properly if there are self-intersections.
 class b2ChainShape : public b2Shape
@@ -34,7 +35,8 @@ class b2ChainShape : public b2Shape
 public:
 	b2ChainShape();
 
-	/// The destructor frees the vertices using b2Free.
+	/// The destructor frees the vertices using b2Free, or returns them to the
+	/// allocator of a clone.
 	~b2ChainShape();
 
 	/// Create a loop. This automatically adjusts connectivity.
@@ -55,7 +57,8 @@ public:
 	/// Don't call this for loops.
 	void SetNextVertex(const b2Vec2& nextVertex);
 
-	/// Implement b2Shape. Vertices are cloned using b2Alloc.
+	/// Implement b2Shape. Vertices are cloned into the allocator as well and
+	/// the destructor of the clone returns them to it.
 	b2Shape* Clone(b2BlockAllocator* allocator) const;
 
 	/// @see b2Shape::GetChildCount
@@ -82,6 +85,10 @@ public:
 	/// The vertices. Owned by this class.
 	b2Vec2* m_vertices;
 
+	/// The allocator holding the vertices of a clone, or NULL if they come
+	/// from b2Alloc.
+	b2BlockAllocator* m_allocator;
+
 	/// The vertex count.
 	int32 m_count;
 
@@ -94,6 +101,7 @@ inline b2ChainShape::b2ChainShape()
 	m_type = e_chain;
 	m_radius = b2_polygonRadius;
 	m_vertices = NULL;
+	m_allocator = NULL;
 	m_count = 0;
 	m_hasPrevVertex = NULL;
 	m_hasNextVertex = NULL;
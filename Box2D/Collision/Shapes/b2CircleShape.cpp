@@ -22,7 +22,7 @@ using namespace std;
 
 b2Shape* b2CircleShape::Clone(b2BlockAllocator* allocator) const
 {
-	void* mem = allocator->Allocate(sizeof(b2CircleShape));
+	void* mem = allocator->Allocate(sizeof(b2CircleShape), e_allocTagShape);
 	b2CircleShape* clone = new (mem) b2CircleShape;
 	*clone = *this;
 	return clone;
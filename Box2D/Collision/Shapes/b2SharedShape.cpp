@@ -0,0 +1,92 @@
+/*
+* Copyright (c) 2011 Erin Catto http://box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <Box2D/Collision/Shapes/b2SharedShape.h>
+#include <Box2D/Collision/Shapes/b2CircleShape.h>
+#include <Box2D/Collision/Shapes/b2EdgeShape.h>
+#include <Box2D/Collision/Shapes/b2ChainShape.h>
+#include <Box2D/Collision/Shapes/b2PolygonShape.h>
+#include <new>
+#include <cstring>
+using namespace std;
+
+// Copy a shape with b2Alloc. Its memory is freed with b2Free after the
+// virtual destructor has run, which also frees chain vertices.
+static b2Shape* b2CopyShape(const b2Shape* shape)
+{
+	switch (shape->m_type)
+	{
+	case b2Shape::e_circle:
+		{
+			void* mem = b2Alloc(sizeof(b2CircleShape));
+			return new (mem) b2CircleShape(*(const b2CircleShape*)shape);
+		}
+
+	case b2Shape::e_edge:
+		{
+			void* mem = b2Alloc(sizeof(b2EdgeShape));
+			return new (mem) b2EdgeShape(*(const b2EdgeShape*)shape);
+		}
+
+	case b2Shape::e_polygon:
+		{
+			void* mem = b2Alloc(sizeof(b2PolygonShape));
+			return new (mem) b2PolygonShape(*(const b2PolygonShape*)shape);
+		}
+
+	case b2Shape::e_chain:
+		{
+			const b2ChainShape* chain = (const b2ChainShape*)shape;
+			void* mem = b2Alloc(sizeof(b2ChainShape));
+			b2ChainShape* copy = new (mem) b2ChainShape;
+			copy->m_radius = chain->m_radius;
+			copy->m_count = chain->m_count;
+			copy->m_vertices = (b2Vec2*)b2Alloc(chain->m_count * sizeof(b2Vec2));
+			memcpy(copy->m_vertices, chain->m_vertices, chain->m_count * sizeof(b2Vec2));
+			copy->m_prevVertex = chain->m_prevVertex;
+			copy->m_nextVertex = chain->m_nextVertex;
+			copy->m_hasPrevVertex = chain->m_hasPrevVertex;
+			copy->m_hasNextVertex = chain->m_hasNextVertex;
+			return copy;
+		}
+
+	default:
+		b2Assert(false);
+		return NULL;
+	}
+}
+
+b2SharedShape* b2SharedShape::Create(const b2Shape* shape)
+{
+	b2SharedShape* sharedShape = (b2SharedShape*)b2Alloc(sizeof(b2SharedShape));
+	sharedShape->m_shape = b2CopyShape(shape);
+	sharedShape->m_referenceCount = 1;
+	return sharedShape;
+}
+
+void b2SharedShape::Release()
+{
+	b2Assert(m_referenceCount > 0);
+	--m_referenceCount;
+	if (m_referenceCount == 0)
+	{
+		m_shape->~b2Shape();
+		b2Free(m_shape);
+		b2Free(this);
+	}
+}
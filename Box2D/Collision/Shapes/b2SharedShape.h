@@ -0,0 +1,72 @@
+/*
+* Copyright (c) 2011 Erin Catto http://box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_SHARED_SHAPE_H
+#define B2_SHARED_SHAPE_H
+
+#include <Box2D/Collision/Shapes/b2Shape.h>
+
+/// A shape that many fixtures can use without each holding a copy, for
+/// example the box of a crate that is spawned thousands of times. Set it
+/// as b2FixtureDef::sharedShape. Every fixture holds a reference, so the
+/// shape lives until its creator and all fixtures using it have released
+/// it. Fixtures of different worlds may share a shape. Reference counting
+/// is not thread-safe.
+class b2SharedShape
+{
+public:
+	/// Copy a shape into a new shared shape. The caller holds the first
+	/// reference and must release it.
+	static b2SharedShape* Create(const b2Shape* shape);
+
+	/// Add a reference.
+	void Retain();
+
+	/// Remove a reference. The shape is freed with the last one.
+	void Release();
+
+	/// Get the shape. It must not be changed while fixtures use it.
+	const b2Shape* GetShape() const;
+
+	/// Get the number of references.
+	int32 GetReferenceCount() const;
+
+private:
+
+	friend class b2Fixture;
+
+	b2Shape* m_shape;
+	int32 m_referenceCount;
+};
+
+inline void b2SharedShape::Retain()
+{
+	++m_referenceCount;
+}
+
+inline const b2Shape* b2SharedShape::GetShape() const
+{
+	return m_shape;
+}
+
+inline int32 b2SharedShape::GetReferenceCount() const
+{
+	return m_referenceCount;
+}
+
+#endif
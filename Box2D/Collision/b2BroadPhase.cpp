@@ -20,23 +20,56 @@
 #include <cstring>
 using namespace std;
 
-b2BroadPhase::b2BroadPhase()
+b2BroadPhase::b2BroadPhase(b2Allocator* allocator) : m_tree(allocator)
 {
+	m_allocator = allocator;
 	m_proxyCount = 0;
 
 	m_pairCapacity = 16;
 	m_pairCount = 0;
-	m_pairBuffer = (b2Pair*)b2Alloc(m_pairCapacity * sizeof(b2Pair));
+	m_pairBuffer = (b2Pair*)m_allocator->Allocate(m_pairCapacity * sizeof(b2Pair), e_allocTagBroadPhase);
 
 	m_moveCapacity = 16;
 	m_moveCount = 0;
-	m_moveBuffer = (int32*)b2Alloc(m_moveCapacity * sizeof(int32));
+	m_moveBuffer = (int32*)m_allocator->Allocate(m_moveCapacity * sizeof(int32), e_allocTagBroadPhase);
+
+	m_proxyMoveCount = 0;
+	m_proxyReinsertCount = 0;
+	m_pairPeak = 0;
+
+	m_growthCount = 0;
 }
 
 b2BroadPhase::~b2BroadPhase()
 {
-	b2Free(m_moveBuffer);
-	b2Free(m_pairBuffer);
+	m_allocator->Free(m_moveBuffer, m_moveCapacity * sizeof(int32), e_allocTagBroadPhase);
+	m_allocator->Free(m_pairBuffer, m_pairCapacity * sizeof(b2Pair), e_allocTagBroadPhase);
+}
+
+void b2BroadPhase::Clear()
+{
+	m_tree.Clear();
+	m_proxyCount = 0;
+	m_moveCount = 0;
+	m_pairCount = 0;
+}
+
+void b2BroadPhase::CopyFrom(const b2BroadPhase& broadPhase)
+{
+	m_tree.CopyFrom(broadPhase.m_tree);
+	m_proxyCount = broadPhase.m_proxyCount;
+
+	if (m_moveCapacity < broadPhase.m_moveCount)
+	{
+		m_allocator->Free(m_moveBuffer, m_moveCapacity * sizeof(int32), e_allocTagBroadPhase);
+		m_moveCapacity = broadPhase.m_moveCapacity;
+		m_moveBuffer = (int32*)m_allocator->Allocate(m_moveCapacity * sizeof(int32), e_allocTagBroadPhase);
+	}
+	memcpy(m_moveBuffer, broadPhase.m_moveBuffer, broadPhase.m_moveCount * sizeof(int32));
+	m_moveCount = broadPhase.m_moveCount;
+
+	// Pairs only live for the duration of UpdatePairs.
+	m_pairCount = 0;
 }
 
 int32 b2BroadPhase::CreateProxy(const b2AABB& aabb, void* userData)
@@ -54,11 +87,71 @@ void b2BroadPhase::DestroyProxy(int32 proxyId)
 	m_tree.DestroyProxy(proxyId);
 }
 
+void b2BroadPhase::CreateProxies(int32 count, const b2AABB* aabbs, void* const* userData, int32* proxyIds)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	m_tree.CreateProxies(count, aabbs, userData, proxyIds);
+	m_proxyCount += count;
+
+	int32 moveCount = m_moveCount + count;
+	if (moveCount > m_moveCapacity)
+	{
+		int32* oldBuffer = m_moveBuffer;
+		int32 oldCapacity = m_moveCapacity;
+		m_moveCapacity = b2Max(moveCount, 2 * m_moveCapacity);
+		m_moveBuffer = (int32*)m_allocator->Allocate(m_moveCapacity * sizeof(int32), e_allocTagBroadPhase);
+		memcpy(m_moveBuffer, oldBuffer, m_moveCount * sizeof(int32));
+		m_allocator->Free(oldBuffer, oldCapacity * sizeof(int32), e_allocTagBroadPhase);
+		++m_growthCount;
+	}
+
+	memcpy(m_moveBuffer + m_moveCount, proxyIds, count * sizeof(int32));
+	m_moveCount = moveCount;
+}
+
+void b2BroadPhase::DestroyProxies(int32 count, int32* proxyIds)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	if (count == 1)
+	{
+		// The linear search stops at the match.
+		DestroyProxy(proxyIds[0]);
+		return;
+	}
+
+	std::sort(proxyIds, proxyIds + count);
+
+	for (int32 i = 0; i < m_moveCount; ++i)
+	{
+		int32 proxyId = m_moveBuffer[i];
+		if (proxyId != e_nullProxy && std::binary_search(proxyIds, proxyIds + count, proxyId))
+		{
+			m_moveBuffer[i] = e_nullProxy;
+		}
+	}
+
+	for (int32 i = count - 1; i >= 0; --i)
+	{
+		m_tree.DestroyProxy(proxyIds[i]);
+	}
+	m_proxyCount -= count;
+}
+
 void b2BroadPhase::MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& displacement)
 {
+	++m_proxyMoveCount;
 	bool buffer = m_tree.MoveProxy(proxyId, aabb, displacement);
 	if (buffer)
 	{
+		++m_proxyReinsertCount;
 		BufferMove(proxyId);
 	}
 }
@@ -68,15 +161,45 @@ void b2BroadPhase::TouchProxy(int32 proxyId)
 	BufferMove(proxyId);
 }
 
+void b2BroadPhase::Reserve(int32 proxyCount, int32 pairCount)
+{
+	if (proxyCount > 0)
+	{
+		// Each new leaf brings one internal node with it.
+		m_tree.Reserve(2 * (m_proxyCount + proxyCount) - 1);
+	}
+
+	int32 moveCapacity = m_moveCount + proxyCount;
+	if (moveCapacity > m_moveCapacity)
+	{
+		int32* oldBuffer = m_moveBuffer;
+		int32 oldCapacity = m_moveCapacity;
+		m_moveCapacity = moveCapacity;
+		m_moveBuffer = (int32*)m_allocator->Allocate(m_moveCapacity * sizeof(int32), e_allocTagBroadPhase);
+		memcpy(m_moveBuffer, oldBuffer, m_moveCount * sizeof(int32));
+		m_allocator->Free(oldBuffer, oldCapacity * sizeof(int32), e_allocTagBroadPhase);
+	}
+
+	if (pairCount > m_pairCapacity)
+	{
+		// Pairs only live for the duration of UpdatePairs.
+		b2Assert(m_pairCount == 0);
+		m_allocator->Free(m_pairBuffer, m_pairCapacity * sizeof(b2Pair), e_allocTagBroadPhase);
+		m_pairCapacity = pairCount;
+		m_pairBuffer = (b2Pair*)m_allocator->Allocate(m_pairCapacity * sizeof(b2Pair), e_allocTagBroadPhase);
+	}
+}
+
 void b2BroadPhase::BufferMove(int32 proxyId)
 {
 	if (m_moveCount == m_moveCapacity)
 	{
 		int32* oldBuffer = m_moveBuffer;
 		m_moveCapacity *= 2;
-		m_moveBuffer = (int32*)b2Alloc(m_moveCapacity * sizeof(int32));
+		m_moveBuffer = (int32*)m_allocator->Allocate(m_moveCapacity * sizeof(int32), e_allocTagBroadPhase);
 		memcpy(m_moveBuffer, oldBuffer, m_moveCount * sizeof(int32));
-		b2Free(oldBuffer);
+		m_allocator->Free(oldBuffer, m_moveCount * sizeof(int32), e_allocTagBroadPhase);
+		++m_growthCount;
 	}
 
 	m_moveBuffer[m_moveCount] = proxyId;
@@ -109,9 +232,10 @@ bool b2BroadPhase::QueryCallback(int32 proxyId)
 	{
 		b2Pair* oldBuffer = m_pairBuffer;
 		m_pairCapacity *= 2;
-		m_pairBuffer = (b2Pair*)b2Alloc(m_pairCapacity * sizeof(b2Pair));
+		m_pairBuffer = (b2Pair*)m_allocator->Allocate(m_pairCapacity * sizeof(b2Pair), e_allocTagBroadPhase);
 		memcpy(m_pairBuffer, oldBuffer, m_pairCount * sizeof(b2Pair));
-		b2Free(oldBuffer);
+		m_allocator->Free(oldBuffer, m_pairCount * sizeof(b2Pair), e_allocTagBroadPhase);
+		++m_growthCount;
 	}
 
 	m_pairBuffer[m_pairCount].proxyIdA = b2Min(proxyId, m_queryProxyId);
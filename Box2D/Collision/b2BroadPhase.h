@@ -43,7 +43,8 @@ public:
 		e_nullProxy = -1
 	};
 
-	b2BroadPhase();
+	/// Buffers and tree nodes are taken from the given allocator.
+	b2BroadPhase(b2Allocator* allocator = &b2_defaultAllocator);
 	~b2BroadPhase();
 
 	/// Create a proxy with an initial AABB. Pairs are not reported until
@@ -53,6 +54,14 @@ public:
 	/// Destroy a proxy. It is up to the client to remove any pairs.
 	void DestroyProxy(int32 proxyId);
 
+	/// Create count proxies at once. The tree is updated in bulk, see
+	/// b2DynamicTree::CreateProxies. The proxy ids are written to proxyIds.
+	void CreateProxies(int32 count, const b2AABB* aabbs, void* const* userData, int32* proxyIds);
+
+	/// Destroy count proxies at once. The move buffer is swept once for the
+	/// whole batch instead of once per proxy. The ids are sorted in place.
+	void DestroyProxies(int32 count, int32* proxyIds);
+
 	/// Call MoveProxy as many times as you like, then when you are done
 	/// call UpdatePairs to finalized the proxy pairs (for your time step).
 	void MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& displacement);
@@ -66,6 +75,9 @@ public:
 	/// Get user data from a proxy. Returns NULL if the id is invalid.
 	void* GetUserData(int32 proxyId) const;
 
+	/// Set the user data of a proxy.
+	void SetUserData(int32 proxyId, void* userData);
+
 	/// Test overlap of fat AABBs.
 	bool TestOverlap(int32 proxyIdA, int32 proxyIdB) const;
 
@@ -100,6 +112,38 @@ public:
 	/// Get the quality metric of the embedded tree.
 	float32 GetTreeQuality() const;
 
+	/// Get the number of proxy moves since the counters were reset.
+	int32 GetProxyMoveCount() const;
+
+	/// Get the number of moves that left the fat AABB and were reinserted
+	/// into the tree since the counters were reset.
+	int32 GetProxyReinsertCount() const;
+
+	/// Get the largest number of pairs buffered by one UpdatePairs call since
+	/// the counters were reset. Pairs found from both proxies and pairs later
+	/// filtered out are included, so this is the pair count to reserve.
+	int32 GetPairPeak() const;
+
+	/// Reset the move counters and the pair peak.
+	void ResetCounters();
+
+	/// Make room for proxyCount more proxies and a pair buffer of pairCount
+	/// pairs, so that neither the tree nor the buffers grow until these are
+	/// exceeded. This is not counted as growth.
+	void Reserve(int32 proxyCount, int32 pairCount);
+
+	/// Get the number of times the tree or the move and pair buffers have
+	/// grown on demand.
+	int32 GetGrowthCount() const;
+
+	/// Copy the proxies and buffered moves of another broad-phase into this one,
+	/// replacing its contents. Proxy ids are preserved and user data is copied
+	/// verbatim, so the caller must fix up user data that points into the source.
+	void CopyFrom(const b2BroadPhase& broadPhase);
+
+	/// Destroy all proxies at once. The tree and the buffers keep their capacity.
+	void Clear();
+
 private:
 
 	friend class b2DynamicTree;
@@ -109,6 +153,8 @@ private:
 
 	bool QueryCallback(int32 proxyId);
 
+	b2Allocator* m_allocator;
+
 	b2DynamicTree m_tree;
 
 	int32 m_proxyCount;
@@ -122,6 +168,12 @@ private:
 	int32 m_pairCount;
 
 	int32 m_queryProxyId;
+
+	int32 m_proxyMoveCount;
+	int32 m_proxyReinsertCount;
+	int32 m_pairPeak;
+
+	int32 m_growthCount;
 };
 
 /// This is used to sort pairs.
@@ -145,6 +197,11 @@ inline void* b2BroadPhase::GetUserData(int32 proxyId) const
 	return m_tree.GetUserData(proxyId);
 }
 
+inline void b2BroadPhase::SetUserData(int32 proxyId, void* userData)
+{
+	m_tree.SetUserData(proxyId, userData);
+}
+
 inline bool b2BroadPhase::TestOverlap(int32 proxyIdA, int32 proxyIdB) const
 {
 	const b2AABB& aabbA = m_tree.GetFatAABB(proxyIdA);
@@ -162,6 +219,33 @@ inline int32 b2BroadPhase::GetProxyCount() const
 	return m_proxyCount;
 }
 
+inline int32 b2BroadPhase::GetProxyMoveCount() const
+{
+	return m_proxyMoveCount;
+}
+
+inline int32 b2BroadPhase::GetProxyReinsertCount() const
+{
+	return m_proxyReinsertCount;
+}
+
+inline int32 b2BroadPhase::GetPairPeak() const
+{
+	return m_pairPeak;
+}
+
+inline void b2BroadPhase::ResetCounters()
+{
+	m_proxyMoveCount = 0;
+	m_proxyReinsertCount = 0;
+	m_pairPeak = 0;
+}
+
+inline int32 b2BroadPhase::GetGrowthCount() const
+{
+	return m_growthCount + m_tree.GetGrowthCount();
+}
+
 inline int32 b2BroadPhase::GetTreeHeight() const
 {
 	return m_tree.GetHeight();
@@ -202,6 +286,7 @@ void b2BroadPhase::UpdatePairs(T* callback)
 
 	// Reset move buffer
 	m_moveCount = 0;
+	m_pairPeak = b2Max(m_pairPeak, m_pairCount);
 
 	// Sort the pair buffer to expose duplicates.
 	std::sort(m_pairBuffer, m_pairBuffer + m_pairCount, b2PairLessThan);
@@ -19,16 +19,19 @@
 #include <Box2D/Collision/b2DynamicTree.h>
 #include <cstring>
 #include <cfloat>
+#include <algorithm>
 using namespace std;
 
 
-b2DynamicTree::b2DynamicTree()
+b2DynamicTree::b2DynamicTree(b2Allocator* allocator)
 {
+	m_allocator = allocator;
 	m_root = b2_nullNode;
 
 	m_nodeCapacity = 16;
 	m_nodeCount = 0;
-	m_nodes = (b2TreeNode*)b2Alloc(m_nodeCapacity * sizeof(b2TreeNode));
+	m_growthCount = 0;
+	m_nodes = (b2TreeNode*)m_allocator->Allocate(m_nodeCapacity * sizeof(b2TreeNode), e_allocTagTree);
 	memset(m_nodes, 0, m_nodeCapacity * sizeof(b2TreeNode));
 
 	// Build a linked list for the free list.
@@ -49,7 +52,84 @@ b2DynamicTree::b2DynamicTree()
 b2DynamicTree::~b2DynamicTree()
 {
 	// This frees the entire tree in one shot.
-	b2Free(m_nodes);
+	m_allocator->Free(m_nodes, m_nodeCapacity * sizeof(b2TreeNode), e_allocTagTree);
+}
+
+void b2DynamicTree::CopyFrom(const b2DynamicTree& tree)
+{
+	if (m_nodeCapacity != tree.m_nodeCapacity)
+	{
+		m_allocator->Free(m_nodes, m_nodeCapacity * sizeof(b2TreeNode), e_allocTagTree);
+		m_nodeCapacity = tree.m_nodeCapacity;
+		m_nodes = (b2TreeNode*)m_allocator->Allocate(m_nodeCapacity * sizeof(b2TreeNode), e_allocTagTree);
+	}
+
+	// Free nodes are linked by index, so the pool can be copied as is.
+	memcpy(m_nodes, tree.m_nodes, m_nodeCapacity * sizeof(b2TreeNode));
+
+	m_root = tree.m_root;
+	m_nodeCount = tree.m_nodeCount;
+	m_freeList = tree.m_freeList;
+	m_path = tree.m_path;
+	m_insertionCount = tree.m_insertionCount;
+}
+
+void b2DynamicTree::Reserve(int32 nodeCount)
+{
+	if (nodeCount <= m_nodeCapacity)
+	{
+		return;
+	}
+
+	b2TreeNode* oldNodes = m_nodes;
+	int32 oldCapacity = m_nodeCapacity;
+	m_nodeCapacity = nodeCount;
+	m_nodes = (b2TreeNode*)m_allocator->Allocate(m_nodeCapacity * sizeof(b2TreeNode), e_allocTagTree);
+	memcpy(m_nodes, oldNodes, oldCapacity * sizeof(b2TreeNode));
+	m_allocator->Free(oldNodes, oldCapacity * sizeof(b2TreeNode), e_allocTagTree);
+
+	// Build a linked list for the new nodes behind the existing free list.
+	// The parent pointer becomes the "next" pointer. Nodes are handed out
+	// in the same order as without the reservation, so proxy ids and with
+	// them the simulation do not depend on it.
+	for (int32 i = oldCapacity; i < m_nodeCapacity - 1; ++i)
+	{
+		m_nodes[i].next = i + 1;
+		m_nodes[i].height = -1;
+	}
+	m_nodes[m_nodeCapacity-1].next = b2_nullNode;
+	m_nodes[m_nodeCapacity-1].height = -1;
+
+	if (m_freeList == b2_nullNode)
+	{
+		m_freeList = oldCapacity;
+	}
+	else
+	{
+		int32 tail = m_freeList;
+		while (m_nodes[tail].next != b2_nullNode)
+		{
+			tail = m_nodes[tail].next;
+		}
+		m_nodes[tail].next = oldCapacity;
+	}
+}
+
+void b2DynamicTree::Clear()
+{
+	for (int32 i = 0; i < m_nodeCapacity - 1; ++i)
+	{
+		m_nodes[i].next = i + 1;
+		m_nodes[i].height = -1;
+	}
+	m_nodes[m_nodeCapacity-1].next = b2_nullNode;
+	m_nodes[m_nodeCapacity-1].height = -1;
+	m_freeList = 0;
+
+	m_root = b2_nullNode;
+	m_nodeCount = 0;
+	m_path = 0;
+	m_insertionCount = 0;
 }
 
 // Allocate a node from the pool. Grow the pool if necessary.
@@ -61,22 +141,8 @@ int32 b2DynamicTree::AllocateNode()
 		b2Assert(m_nodeCount == m_nodeCapacity);
 
 		// The free list is empty. Rebuild a bigger pool.
-		b2TreeNode* oldNodes = m_nodes;
-		m_nodeCapacity *= 2;
-		m_nodes = (b2TreeNode*)b2Alloc(m_nodeCapacity * sizeof(b2TreeNode));
-		memcpy(m_nodes, oldNodes, m_nodeCount * sizeof(b2TreeNode));
-		b2Free(oldNodes);
-
-		// Build a linked list for the free list. The parent
-		// pointer becomes the "next" pointer.
-		for (int32 i = m_nodeCount; i < m_nodeCapacity - 1; ++i)
-		{
-			m_nodes[i].next = i + 1;
-			m_nodes[i].height = -1;
-		}
-		m_nodes[m_nodeCapacity-1].next = b2_nullNode;
-		m_nodes[m_nodeCapacity-1].height = -1;
-		m_freeList = m_nodeCount;
+		Reserve(2 * m_nodeCapacity);
+		++m_growthCount;
 	}
 
 	// Peel a node off the free list.
@@ -266,7 +332,7 @@ void b2DynamicTree::InsertLeaf(int32 leaf)
 	m_nodes[newParent].parent = oldParent;
 	m_nodes[newParent].userData = NULL;
 	m_nodes[newParent].aabb.Combine(leafAABB, m_nodes[sibling].aabb);
-	m_nodes[newParent].height = m_nodes[sibling].height + 1;
+	m_nodes[newParent].height = 1 + b2Max(m_nodes[sibling].height, m_nodes[leaf].height);
 
 	if (oldParent != b2_nullNode)
 	{
@@ -696,7 +762,8 @@ int32 b2DynamicTree::GetMaxBalance() const
 
 void b2DynamicTree::RebuildBottomUp()
 {
-	int32* nodes = (int32*)b2Alloc(m_nodeCount * sizeof(int32));
+	int32 nodesSize = m_nodeCount * sizeof(int32);
+	int32* nodes = (int32*)m_allocator->Allocate(nodesSize, e_allocTagTree);
 	int32 count = 0;
 
 	// Build array of leaves. Free the rest.
@@ -765,7 +832,144 @@ void b2DynamicTree::RebuildBottomUp()
 	}
 
 	m_root = nodes[0];
-	b2Free(nodes);
+	m_allocator->Free(nodes, nodesSize, e_allocTagTree);
 
 	Validate();
 }
+
+struct b2LeafCenterLessThan
+{
+	bool operator()(int32 a, int32 b) const
+	{
+		// Twice the centers, which orders the same.
+		float32 ca = nodes[a].aabb.lowerBound(axis) + nodes[a].aabb.upperBound(axis);
+		float32 cb = nodes[b].aabb.lowerBound(axis) + nodes[b].aabb.upperBound(axis);
+		return ca < cb;
+	}
+
+	const b2TreeNode* nodes;
+	int32 axis;
+};
+
+// Build a subtree over the given leaves by splitting them at the median center
+// along the longest axis. The leaf array is reordered. Returns the subtree root.
+int32 b2DynamicTree::BuildTopDown(int32* leaves, int32 count)
+{
+	b2Assert(count > 0);
+
+	if (count == 1)
+	{
+		m_nodes[leaves[0]].parent = b2_nullNode;
+		return leaves[0];
+	}
+
+	b2Vec2 lower(b2_maxFloat, b2_maxFloat);
+	b2Vec2 upper(-b2_maxFloat, -b2_maxFloat);
+	for (int32 i = 0; i < count; ++i)
+	{
+		const b2AABB& aabb = m_nodes[leaves[i]].aabb;
+		b2Vec2 center = aabb.lowerBound + aabb.upperBound;
+		lower = b2Min(lower, center);
+		upper = b2Max(upper, center);
+	}
+
+	b2LeafCenterLessThan lessThan;
+	lessThan.nodes = m_nodes;
+	lessThan.axis = upper.x - lower.x > upper.y - lower.y ? 0 : 1;
+
+	int32 half = count / 2;
+	std::nth_element(leaves, leaves + half, leaves + count, lessThan);
+
+	int32 child1 = BuildTopDown(leaves, half);
+	int32 child2 = BuildTopDown(leaves + half, count - half);
+
+	int32 parent = AllocateNode();
+	m_nodes[parent].child1 = child1;
+	m_nodes[parent].child2 = child2;
+	m_nodes[parent].height = 1 + b2Max(m_nodes[child1].height, m_nodes[child2].height);
+	m_nodes[parent].aabb.Combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+	m_nodes[parent].parent = b2_nullNode;
+
+	m_nodes[child1].parent = parent;
+	m_nodes[child2].parent = parent;
+
+	return parent;
+}
+
+void b2DynamicTree::CreateProxies(int32 count, const b2AABB* aabbs, void* const* userData, int32* proxyIds)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	// Each leaf brings one internal node with it. Grow once up front so the
+	// node array does not move during the build.
+	int32 nodeCount = m_nodeCount + 2 * count;
+	if (nodeCount > m_nodeCapacity)
+	{
+		Reserve(b2Max(nodeCount, 2 * m_nodeCapacity));
+		++m_growthCount;
+	}
+
+	int32 leafCount = m_root == b2_nullNode ? 0 : (m_nodeCount + 1) / 2;
+
+	// Hand out the leaves in ascending node order, so that the proxy ids
+	// follow the order of the input whatever state the free list is in.
+	for (int32 i = 0; i < count; ++i)
+	{
+		proxyIds[i] = AllocateNode();
+	}
+	std::sort(proxyIds, proxyIds + count);
+
+	b2Vec2 r(b2_aabbExtension, b2_aabbExtension);
+	for (int32 i = 0; i < count; ++i)
+	{
+		int32 proxyId = proxyIds[i];
+		m_nodes[proxyId].aabb.lowerBound = aabbs[i].lowerBound - r;
+		m_nodes[proxyId].aabb.upperBound = aabbs[i].upperBound + r;
+		m_nodes[proxyId].userData = userData[i];
+		m_nodes[proxyId].height = 0;
+	}
+
+	if (count < leafCount)
+	{
+		int32 leavesSize = count * sizeof(int32);
+		int32* leaves = (int32*)m_allocator->Allocate(leavesSize, e_allocTagTree);
+		memcpy(leaves, proxyIds, leavesSize);
+
+		int32 subtree = BuildTopDown(leaves, count);
+		m_allocator->Free(leaves, leavesSize, e_allocTagTree);
+
+		InsertLeaf(subtree);
+		return;
+	}
+
+	// The batch dominates, so rebuild everything. Gather the leaves and free
+	// the internal nodes.
+	leafCount += count;
+	int32 leavesSize = leafCount * sizeof(int32);
+	int32* leaves = (int32*)m_allocator->Allocate(leavesSize, e_allocTagTree);
+	int32 index = 0;
+	for (int32 i = 0; i < m_nodeCapacity; ++i)
+	{
+		if (m_nodes[i].height < 0)
+		{
+			continue;
+		}
+
+		if (m_nodes[i].IsLeaf())
+		{
+			leaves[index] = i;
+			++index;
+		}
+		else
+		{
+			FreeNode(i);
+		}
+	}
+	b2Assert(index == leafCount);
+
+	m_root = BuildTopDown(leaves, leafCount);
+	m_allocator->Free(leaves, leavesSize, e_allocTagTree);
+}
@@ -21,6 +21,7 @@
 
 #include <Box2D/Collision/b2Collision.h>
 #include <Box2D/Common/b2GrowableStack.h>
+#include <Box2D/Common/b2Allocator.h>
 
 #define b2_nullNode (-1)
 
@@ -61,8 +62,9 @@ struct b2TreeNode
 class b2DynamicTree
 {
 public:
-	/// Constructing the tree initializes the node pool.
-	b2DynamicTree();
+	/// Constructing the tree initializes the node pool. Nodes are taken
+	/// from the given allocator.
+	b2DynamicTree(b2Allocator* allocator = &b2_defaultAllocator);
 
 	/// Destroy the tree, freeing the node pool.
 	~b2DynamicTree();
@@ -83,9 +85,16 @@ public:
 	/// @return the proxy user data or 0 if the id is invalid.
 	void* GetUserData(int32 proxyId) const;
 
+	/// Set proxy user data.
+	void SetUserData(int32 proxyId, void* userData);
+
 	/// Get the fat AABB for a proxy.
 	const b2AABB& GetFatAABB(int32 proxyId) const;
 
+	/// Copy the node pool of another tree into this tree, replacing its contents.
+	/// Proxy ids are preserved. User data is copied verbatim.
+	void CopyFrom(const b2DynamicTree& tree);
+
 	/// Query an AABB for overlapping proxies. The callback class
 	/// is called for each proxy that overlaps the supplied AABB.
 	template <typename T>
@@ -118,6 +127,22 @@ public:
 	/// Build an optimal tree. Very expensive. For testing.
 	void RebuildBottomUp();
 
+	/// Create count proxies at once. The new leaves are built into a subtree
+	/// by median splits and the subtree is inserted as a single node. If the
+	/// batch is at least as large as the tree, the whole tree is rebuilt this
+	/// way instead. The proxy ids are written to proxyIds.
+	void CreateProxies(int32 count, const b2AABB* aabbs, void* const* userData, int32* proxyIds);
+
+	/// Grow the node pool so that it holds at least nodeCount nodes. A tree
+	/// with n proxies uses 2n - 1 nodes. This is not counted as growth.
+	void Reserve(int32 nodeCount);
+
+	/// Get the number of times the node pool has grown on demand.
+	int32 GetGrowthCount() const;
+
+	/// Remove all proxies but keep the node pool.
+	void Clear();
+
 private:
 
 	int32 AllocateNode();
@@ -128,6 +153,8 @@ private:
 
 	int32 Balance(int32 index);
 
+	int32 BuildTopDown(int32* leaves, int32 count);
+
 	int32 ComputeHeight() const;
 	int32 ComputeHeight(int32 nodeId) const;
 
@@ -136,9 +163,12 @@ private:
 
 	int32 m_root;
 
+	b2Allocator* m_allocator;
+
 	b2TreeNode* m_nodes;
 	int32 m_nodeCount;
 	int32 m_nodeCapacity;
+	int32 m_growthCount;
 
 	int32 m_freeList;
 
@@ -148,12 +178,23 @@ private:
 	int32 m_insertionCount;
 };
 
+inline int32 b2DynamicTree::GetGrowthCount() const
+{
+	return m_growthCount;
+}
+
 inline void* b2DynamicTree::GetUserData(int32 proxyId) const
 {
 	b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
 	return m_nodes[proxyId].userData;
 }
 
+inline void b2DynamicTree::SetUserData(int32 proxyId, void* userData)
+{
+	b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
+	m_nodes[proxyId].userData = userData;
+}
+
 inline const b2AABB& b2DynamicTree::GetFatAABB(int32 proxyId) const
 {
 	b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
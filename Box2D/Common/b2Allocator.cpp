@@ -0,0 +1,86 @@
+/*
+* Copyright (c) 2011 Erin Catto http://box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <Box2D/Common/b2Allocator.h>
+#include <Box2D/Common/b2Math.h>
+#include <cstring>
+
+b2DefaultAllocator b2_defaultAllocator;
+
+static const char* s_allocTagNames[e_allocTagCount] =
+{
+	"block",
+	"body",
+	"fixture",
+	"shape",
+	"proxy",
+	"contact",
+	"joint",
+	"tree",
+	"broadPhase",
+	"stack"
+};
+
+const char* b2GetAllocTagName(b2AllocTag tag)
+{
+	b2Assert(0 <= tag && tag < e_allocTagCount);
+	return s_allocTagNames[tag];
+}
+
+void* b2DefaultAllocator::Allocate(int32 size, b2AllocTag tag)
+{
+	B2_NOT_USED(tag);
+	return b2Alloc(size);
+}
+
+void b2DefaultAllocator::Free(void* p, int32 size, b2AllocTag tag)
+{
+	B2_NOT_USED(size);
+	B2_NOT_USED(tag);
+	b2Free(p);
+}
+
+b2TrackingAllocator::b2TrackingAllocator(b2Allocator* allocator)
+{
+	m_allocator = allocator;
+	memset(&m_report, 0, sizeof(b2MemoryReport));
+}
+
+void* b2TrackingAllocator::Allocate(int32 size, b2AllocTag tag)
+{
+	b2Assert(0 <= tag && tag < e_allocTagCount);
+	m_report.bytes[tag] += size;
+	++m_report.counts[tag];
+	m_report.totalBytes += size;
+	m_report.peakBytes = b2Max(m_report.peakBytes, m_report.totalBytes);
+	return m_allocator->Allocate(size, tag);
+}
+
+void b2TrackingAllocator::Free(void* p, int32 size, b2AllocTag tag)
+{
+	if (p == NULL)
+	{
+		return;
+	}
+
+	b2Assert(0 <= tag && tag < e_allocTagCount);
+	m_report.bytes[tag] -= size;
+	--m_report.counts[tag];
+	m_report.totalBytes -= size;
+	m_allocator->Free(p, size, tag);
+}
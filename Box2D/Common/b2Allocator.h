@@ -0,0 +1,107 @@
+/*
+* Copyright (c) 2011 Erin Catto http://box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_ALLOCATOR_H
+#define B2_ALLOCATOR_H
+
+#include <Box2D/Common/b2Settings.h>
+
+/// What an allocation is used for.
+enum b2AllocTag
+{
+	e_allocTagBlock,		///< block allocator chunks not occupied by tagged blocks
+	e_allocTagBody,
+	e_allocTagFixture,
+	e_allocTagShape,		///< shapes and chain vertices
+	e_allocTagProxy,		///< fixture proxy arrays
+	e_allocTagContact,
+	e_allocTagJoint,
+	e_allocTagTree,			///< dynamic tree nodes
+	e_allocTagBroadPhase,	///< broad-phase pair and move buffers
+	e_allocTagStack,		///< per step stack allocator
+	e_allocTagCount
+};
+
+/// Get a short name for a tag, for reports.
+const char* b2GetAllocTagName(b2AllocTag tag);
+
+/// Implement this to supply the memory of a world, for example from your own
+/// arenas or to enforce a budget. Allocate must not return NULL.
+class b2Allocator
+{
+public:
+	virtual ~b2Allocator() {}
+
+	/// Allocate memory for the given purpose.
+	virtual void* Allocate(int32 size, b2AllocTag tag) = 0;
+
+	/// Free memory. The size and tag match the call to Allocate.
+	virtual void Free(void* p, int32 size, b2AllocTag tag) = 0;
+};
+
+/// The default allocator uses b2Alloc and b2Free.
+class b2DefaultAllocator : public b2Allocator
+{
+public:
+	void* Allocate(int32 size, b2AllocTag tag);
+	void Free(void* p, int32 size, b2AllocTag tag);
+};
+
+extern b2DefaultAllocator b2_defaultAllocator;
+
+/// Live memory by tag. The bytes of all tags add up to totalBytes.
+struct b2MemoryReport
+{
+	int32 bytes[e_allocTagCount];
+	int32 counts[e_allocTagCount];	///< live allocations or blocks
+	int32 totalBytes;
+	int32 peakBytes;
+};
+
+/// An allocator that forwards to another allocator and accounts for the
+/// memory it hands out.
+class b2TrackingAllocator : public b2Allocator
+{
+public:
+	b2TrackingAllocator(b2Allocator* allocator);
+
+	void* Allocate(int32 size, b2AllocTag tag);
+	void Free(void* p, int32 size, b2AllocTag tag);
+
+	/// Get the allocator that supplies the memory.
+	b2Allocator* GetAllocator() const;
+
+	/// Get the memory handed out so far.
+	const b2MemoryReport& GetReport() const;
+
+private:
+	b2Allocator* m_allocator;
+	b2MemoryReport m_report;
+};
+
+inline b2Allocator* b2TrackingAllocator::GetAllocator() const
+{
+	return m_allocator;
+}
+
+inline const b2MemoryReport& b2TrackingAllocator::GetReport() const
+{
+	return m_report;
+}
+
+#endif
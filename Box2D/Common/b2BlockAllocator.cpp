@@ -21,6 +21,7 @@
 #include <climits>
 #include <cstring>
 #include <memory>
+#include <algorithm>
 using namespace std;
 
 int32 b2BlockAllocator::s_blockSizes[b2_blockSizes] =
@@ -49,21 +50,22 @@ struct b2Chunk
 	b2Block* blocks;
 };
 
-struct b2Block
-{
-	b2Block* next;
-};
-
-b2BlockAllocator::b2BlockAllocator()
+b2BlockAllocator::b2BlockAllocator(b2Allocator* allocator)
 {
 	b2Assert(b2_blockSizes < UCHAR_MAX);
 
+	m_allocator = allocator;
+
 	m_chunkSpace = b2_chunkArrayIncrement;
 	m_chunkCount = 0;
-	m_chunks = (b2Chunk*)b2Alloc(m_chunkSpace * sizeof(b2Chunk));
+	m_growthCount = 0;
+	m_chunks = (b2Chunk*)m_allocator->Allocate(m_chunkSpace * sizeof(b2Chunk), e_allocTagBlock);
 
 	memset(m_chunks, 0, m_chunkSpace * sizeof(b2Chunk));
 	memset(m_freeLists, 0, sizeof(m_freeLists));
+	memset(m_liveCounts, 0, sizeof(m_liveCounts));
+	memset(m_tagBytes, 0, sizeof(m_tagBytes));
+	memset(m_tagCounts, 0, sizeof(m_tagCounts));
 
 	if (s_blockSizeLookupInitialized == false)
 	{
@@ -90,13 +92,13 @@ b2BlockAllocator::~b2BlockAllocator()
 {
 	for (int32 i = 0; i < m_chunkCount; ++i)
 	{
-		b2Free(m_chunks[i].blocks);
+		m_allocator->Free(m_chunks[i].blocks, b2_chunkSize, e_allocTagBlock);
 	}
 
-	b2Free(m_chunks);
+	m_allocator->Free(m_chunks, m_chunkSpace * sizeof(b2Chunk), e_allocTagBlock);
 }
 
-void* b2BlockAllocator::Allocate(int32 size)
+void* b2BlockAllocator::Allocate(int32 size, b2AllocTag tag)
 {
 	if (size == 0)
 		return NULL;
@@ -105,56 +107,116 @@ void* b2BlockAllocator::Allocate(int32 size)
 
 	if (size > b2_maxBlockSize)
 	{
-		return b2Alloc(size);
+		return m_allocator->Allocate(size, tag);
 	}
 
 	int32 index = s_blockSizeLookup[size];
 	b2Assert(0 <= index && index < b2_blockSizes);
 
-	if (m_freeLists[index])
+	++m_liveCounts[index];
+	m_tagBytes[tag] += s_blockSizes[index];
+	++m_tagCounts[tag];
+
+	if (m_freeLists[index] == NULL)
 	{
-		b2Block* block = m_freeLists[index];
-		m_freeLists[index] = block->next;
-		return block;
+		AddChunk(index);
+		++m_growthCount;
 	}
-	else
+
+	b2Block* block = m_freeLists[index];
+	m_freeLists[index] = block->next;
+	return block;
+}
+
+// Carve a new chunk into blocks of the given size class and push them onto its free list.
+void b2BlockAllocator::AddChunk(int32 index)
+{
+	if (m_chunkCount == m_chunkSpace)
 	{
-		if (m_chunkCount == m_chunkSpace)
-		{
-			b2Chunk* oldChunks = m_chunks;
-			m_chunkSpace += b2_chunkArrayIncrement;
-			m_chunks = (b2Chunk*)b2Alloc(m_chunkSpace * sizeof(b2Chunk));
-			memcpy(m_chunks, oldChunks, m_chunkCount * sizeof(b2Chunk));
-			memset(m_chunks + m_chunkCount, 0, b2_chunkArrayIncrement * sizeof(b2Chunk));
-			b2Free(oldChunks);
-		}
+		b2Chunk* oldChunks = m_chunks;
+		int32 oldSpace = m_chunkSpace;
+		m_chunkSpace += b2_chunkArrayIncrement;
+		m_chunks = (b2Chunk*)m_allocator->Allocate(m_chunkSpace * sizeof(b2Chunk), e_allocTagBlock);
+		memcpy(m_chunks, oldChunks, m_chunkCount * sizeof(b2Chunk));
+		memset(m_chunks + m_chunkCount, 0, b2_chunkArrayIncrement * sizeof(b2Chunk));
+		m_allocator->Free(oldChunks, oldSpace * sizeof(b2Chunk), e_allocTagBlock);
+	}
+
+	b2Chunk* chunk = m_chunks + m_chunkCount;
+	chunk->blocks = (b2Block*)m_allocator->Allocate(b2_chunkSize, e_allocTagBlock);
+	CarveChunk(chunk, index);
+	++m_chunkCount;
+}
 
-		b2Chunk* chunk = m_chunks + m_chunkCount;
-		chunk->blocks = (b2Block*)b2Alloc(b2_chunkSize);
+// Link all blocks of a chunk and push them onto the free list of the size class.
+void b2BlockAllocator::CarveChunk(b2Chunk* chunk, int32 index)
+{
 #if defined(_DEBUG)
-		memset(chunk->blocks, 0xcd, b2_chunkSize);
+	memset(chunk->blocks, 0xcd, b2_chunkSize);
 #endif
-		int32 blockSize = s_blockSizes[index];
-		chunk->blockSize = blockSize;
-		int32 blockCount = b2_chunkSize / blockSize;
-		b2Assert(blockCount * blockSize <= b2_chunkSize);
-		for (int32 i = 0; i < blockCount - 1; ++i)
-		{
-			b2Block* block = (b2Block*)((int8*)chunk->blocks + blockSize * i);
-			b2Block* next = (b2Block*)((int8*)chunk->blocks + blockSize * (i + 1));
-			block->next = next;
-		}
-		b2Block* last = (b2Block*)((int8*)chunk->blocks + blockSize * (blockCount - 1));
-		last->next = NULL;
+	int32 blockSize = s_blockSizes[index];
+	chunk->blockSize = blockSize;
+	int32 blockCount = b2_chunkSize / blockSize;
+	b2Assert(blockCount * blockSize <= b2_chunkSize);
+	for (int32 i = 0; i < blockCount - 1; ++i)
+	{
+		b2Block* block = (b2Block*)((int8*)chunk->blocks + blockSize * i);
+		b2Block* next = (b2Block*)((int8*)chunk->blocks + blockSize * (i + 1));
+		block->next = next;
+	}
+	b2Block* last = (b2Block*)((int8*)chunk->blocks + blockSize * (blockCount - 1));
+	last->next = m_freeLists[index];
+
+	m_freeLists[index] = chunk->blocks;
+}
+
+void b2BlockAllocator::Reserve(int32 size, int32 count)
+{
+	int32 index = GetSizeClass(size);
+	if (index != -1)
+	{
+		ReserveClass(index, count);
+	}
+}
+
+void b2BlockAllocator::Reserve(const int32 counts[b2_blockSizes])
+{
+	for (int32 i = 0; i < b2_blockSizes; ++i)
+	{
+		ReserveClass(i, counts[i]);
+	}
+}
+
+int32 b2BlockAllocator::GetSizeClass(int32 size)
+{
+	b2Assert(s_blockSizeLookupInitialized);
+	if (size <= 0 || size > b2_maxBlockSize)
+	{
+		return -1;
+	}
+
+	return s_blockSizeLookup[size];
+}
+
+void b2BlockAllocator::ReserveClass(int32 index, int32 count)
+{
+	b2Assert(0 <= index && index < b2_blockSizes);
 
-		m_freeLists[index] = chunk->blocks->next;
-		++m_chunkCount;
+	int32 freeCount = 0;
+	for (b2Block* block = m_freeLists[index]; block && freeCount < count; block = block->next)
+	{
+		++freeCount;
+	}
 
-		return chunk->blocks;
+	int32 blocksPerChunk = b2_chunkSize / s_blockSizes[index];
+	while (freeCount < count)
+	{
+		AddChunk(index);
+		freeCount += blocksPerChunk;
 	}
 }
 
-void b2BlockAllocator::Free(void* p, int32 size)
+void b2BlockAllocator::Free(void* p, int32 size, b2AllocTag tag)
 {
 	if (size == 0)
 	{
@@ -165,13 +227,17 @@ void b2BlockAllocator::Free(void* p, int32 size)
 
 	if (size > b2_maxBlockSize)
 	{
-		b2Free(p);
+		m_allocator->Free(p, size, tag);
 		return;
 	}
 
 	int32 index = s_blockSizeLookup[size];
 	b2Assert(0 <= index && index < b2_blockSizes);
 
+	--m_liveCounts[index];
+	m_tagBytes[tag] -= s_blockSizes[index];
+	--m_tagCounts[tag];
+
 #ifdef _DEBUG
 	// Verify the memory address and size is valid.
 	int32 blockSize = s_blockSizes[index];
@@ -207,11 +273,256 @@ void b2BlockAllocator::Clear()
 {
 	for (int32 i = 0; i < m_chunkCount; ++i)
 	{
-		b2Free(m_chunks[i].blocks);
+		m_allocator->Free(m_chunks[i].blocks, b2_chunkSize, e_allocTagBlock);
 	}
 
 	m_chunkCount = 0;
 	memset(m_chunks, 0, m_chunkSpace * sizeof(b2Chunk));
 
 	memset(m_freeLists, 0, sizeof(m_freeLists));
+	memset(m_liveCounts, 0, sizeof(m_liveCounts));
+	memset(m_tagBytes, 0, sizeof(m_tagBytes));
+	memset(m_tagCounts, 0, sizeof(m_tagCounts));
+}
+
+void b2BlockAllocator::Reset()
+{
+	memset(m_freeLists, 0, sizeof(m_freeLists));
+
+	// Carve in reverse so the free lists hand out the first chunks first.
+	for (int32 i = m_chunkCount - 1; i >= 0; --i)
+	{
+		b2Chunk* chunk = m_chunks + i;
+		CarveChunk(chunk, s_blockSizeLookup[chunk->blockSize]);
+	}
+
+	memset(m_liveCounts, 0, sizeof(m_liveCounts));
+	memset(m_tagBytes, 0, sizeof(m_tagBytes));
+	memset(m_tagCounts, 0, sizeof(m_tagCounts));
+}
+
+int32 b2BlockAllocator::Trim()
+{
+	if (m_chunkCount == 0)
+	{
+		return 0;
+	}
+
+	// Count the free blocks of each chunk.
+	b2BlockRelocator chunkIndex(this, this);
+	int32 freeCountBytes = m_chunkCount * sizeof(int32);
+	int32* freeCounts = (int32*)m_allocator->Allocate(freeCountBytes, e_allocTagBlock);
+	memset(freeCounts, 0, freeCountBytes);
+	for (int32 i = 0; i < b2_blockSizes; ++i)
+	{
+		for (b2Block* block = m_freeLists[i]; block; block = block->next)
+		{
+			int32 chunk = chunkIndex.FindChunk(block);
+			b2Assert(chunk != -1);
+			++freeCounts[chunk];
+		}
+	}
+
+	// A chunk is empty when all of its blocks are free. Reuse the
+	// counts as flags.
+	int32 emptyCount = 0;
+	for (int32 i = 0; i < m_chunkCount; ++i)
+	{
+		bool empty = freeCounts[i] == b2_chunkSize / m_chunks[i].blockSize;
+		freeCounts[i] = empty ? 1 : 0;
+		emptyCount += freeCounts[i];
+	}
+
+	if (emptyCount == 0)
+	{
+		m_allocator->Free(freeCounts, freeCountBytes, e_allocTagBlock);
+		return 0;
+	}
+
+	// Unlink the blocks of empty chunks from the free lists.
+	for (int32 i = 0; i < b2_blockSizes; ++i)
+	{
+		b2Block** link = m_freeLists + i;
+		while (*link)
+		{
+			if (freeCounts[chunkIndex.FindChunk(*link)])
+			{
+				*link = (*link)->next;
+			}
+			else
+			{
+				link = &(*link)->next;
+			}
+		}
+	}
+
+	// Release the empty chunks and close the gaps.
+	int32 count = 0;
+	for (int32 i = 0; i < m_chunkCount; ++i)
+	{
+		if (freeCounts[i])
+		{
+			m_allocator->Free(m_chunks[i].blocks, b2_chunkSize, e_allocTagBlock);
+		}
+		else
+		{
+			m_chunks[count++] = m_chunks[i];
+		}
+	}
+	memset(m_chunks + count, 0, (m_chunkCount - count) * sizeof(b2Chunk));
+	m_chunkCount = count;
+
+	m_allocator->Free(freeCounts, freeCountBytes, e_allocTagBlock);
+	return emptyCount * b2_chunkSize;
+}
+
+void b2BlockAllocator::GetSizeStats(b2BlockSizeStats stats[b2_blockSizes]) const
+{
+	for (int32 i = 0; i < b2_blockSizes; ++i)
+	{
+		stats[i].blockSize = s_blockSizes[i];
+		stats[i].chunkCount = 0;
+		stats[i].liveCount = m_liveCounts[i];
+		stats[i].freeCount = 0;
+	}
+
+	for (int32 i = 0; i < m_chunkCount; ++i)
+	{
+		int32 index = s_blockSizeLookup[m_chunks[i].blockSize];
+		++stats[index].chunkCount;
+		stats[index].freeCount += b2_chunkSize / m_chunks[i].blockSize;
+	}
+
+	for (int32 i = 0; i < b2_blockSizes; ++i)
+	{
+		stats[i].freeCount -= stats[i].liveCount;
+	}
+}
+
+void b2BlockAllocator::CopyFrom(const b2BlockAllocator& source)
+{
+	b2Assert(m_chunkCount == 0);
+
+	if (m_chunkSpace < source.m_chunkCount)
+	{
+		m_allocator->Free(m_chunks, m_chunkSpace * sizeof(b2Chunk), e_allocTagBlock);
+		m_chunkSpace = source.m_chunkSpace;
+		m_chunks = (b2Chunk*)m_allocator->Allocate(m_chunkSpace * sizeof(b2Chunk), e_allocTagBlock);
+		memset(m_chunks, 0, m_chunkSpace * sizeof(b2Chunk));
+	}
+
+	for (int32 i = 0; i < source.m_chunkCount; ++i)
+	{
+		b2Chunk* chunk = m_chunks + i;
+		chunk->blockSize = source.m_chunks[i].blockSize;
+		chunk->blocks = (b2Block*)m_allocator->Allocate(b2_chunkSize, e_allocTagBlock);
+		memcpy(chunk->blocks, source.m_chunks[i].blocks, b2_chunkSize);
+	}
+	m_chunkCount = source.m_chunkCount;
+
+	memcpy(m_liveCounts, source.m_liveCounts, sizeof(m_liveCounts));
+	memcpy(m_tagBytes, source.m_tagBytes, sizeof(m_tagBytes));
+	memcpy(m_tagCounts, source.m_tagCounts, sizeof(m_tagCounts));
+
+	// The free blocks were copied with the chunks, so their links still
+	// point into the source chunks.
+	b2BlockRelocator relocator(&source, this);
+	for (int32 i = 0; i < b2_blockSizes; ++i)
+	{
+		m_freeLists[i] = relocator.Relocate(source.m_freeLists[i]);
+		for (b2Block* block = m_freeLists[i]; block; block = block->next)
+		{
+			block->next = relocator.Relocate(block->next);
+		}
+	}
+}
+
+struct b2ChunkAddressLessThan
+{
+	bool operator()(int32 a, int32 b) const
+	{
+		return chunks[a].blocks < chunks[b].blocks;
+	}
+
+	const b2Chunk* chunks;
+};
+
+b2BlockRelocator::b2BlockRelocator(const b2BlockAllocator* source, const b2BlockAllocator* target)
+{
+	b2Assert(source->m_chunkCount == target->m_chunkCount);
+
+	m_source = source;
+	m_target = target;
+
+	int32 count = source->m_chunkCount;
+	m_orderBytes = (count > 0 ? count : 1) * sizeof(int32);
+	m_order = (int32*)m_target->m_allocator->Allocate(m_orderBytes, e_allocTagBlock);
+	for (int32 i = 0; i < count; ++i)
+	{
+		m_order[i] = i;
+	}
+
+	b2ChunkAddressLessThan lessThan;
+	lessThan.chunks = source->m_chunks;
+	std::sort(m_order, m_order + count, lessThan);
+}
+
+b2BlockRelocator::~b2BlockRelocator()
+{
+	m_target->m_allocator->Free(m_order, m_orderBytes, e_allocTagBlock);
+}
+
+void* b2BlockRelocator::Relocate(const void* p) const
+{
+	if (p == NULL)
+	{
+		return NULL;
+	}
+
+	int32 chunkIndex = FindChunk(p);
+	if (chunkIndex == -1)
+	{
+		return (void*)p;
+	}
+
+	const int8* start = (const int8*)m_source->m_chunks[chunkIndex].blocks;
+	return (int8*)m_target->m_chunks[chunkIndex].blocks + ((const int8*)p - start);
+}
+
+int32 b2BlockRelocator::FindChunk(const void* p) const
+{
+	const int8* address = (const int8*)p;
+	const b2Chunk* chunks = m_source->m_chunks;
+
+	// Find the last chunk that starts at or before the address.
+	int32 low = 0;
+	int32 high = m_source->m_chunkCount - 1;
+	int32 index = -1;
+	while (low <= high)
+	{
+		int32 mid = (low + high) >> 1;
+		if ((const int8*)chunks[m_order[mid]].blocks <= address)
+		{
+			index = mid;
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid - 1;
+		}
+	}
+
+	if (index == -1)
+	{
+		return -1;
+	}
+
+	int32 chunkIndex = m_order[index];
+	const int8* start = (const int8*)chunks[chunkIndex].blocks;
+	if (address >= start + b2_chunkSize)
+	{
+		return -1;
+	}
+
+	return chunkIndex;
 }
@@ -19,44 +19,171 @@
 #ifndef B2_BLOCK_ALLOCATOR_H
 #define B2_BLOCK_ALLOCATOR_H
 
-#include <Box2D/Common/b2Settings.h>
+#include <Box2D/Common/b2Allocator.h>
 
 const int32 b2_chunkSize = 16 * 1024;
 const int32 b2_maxBlockSize = 640;
 const int32 b2_blockSizes = 14;
 const int32 b2_chunkArrayIncrement = 128;
 
-struct b2Block;
 struct b2Chunk;
 
+struct b2Block
+{
+	b2Block* next;
+};
+
+/// Usage of one block size class.
+struct b2BlockSizeStats
+{
+	int32 blockSize;
+	int32 chunkCount;
+	int32 liveCount;	///< blocks in use
+	int32 freeCount;	///< blocks on the free list
+};
+
 /// This is a small object allocator used for allocating small
 /// objects that persist for more than one time step.
 /// See: http://www.codeproject.com/useritems/Small_Block_Allocator.asp
 class b2BlockAllocator
 {
 public:
-	b2BlockAllocator();
+	/// Chunks and large blocks are taken from the given allocator.
+	b2BlockAllocator(b2Allocator* allocator = &b2_defaultAllocator);
 	~b2BlockAllocator();
 
-	/// Allocate memory. This will use b2Alloc if the size is larger than b2_maxBlockSize.
-	void* Allocate(int32 size);
+	/// Allocate memory. This will use the backing allocator directly if the size
+	/// is larger than b2_maxBlockSize.
+	void* Allocate(int32 size, b2AllocTag tag);
 
-	/// Free memory. This will use b2Free if the size is larger than b2_maxBlockSize.
-	void Free(void* p, int32 size);
+	/// Free memory. The size and tag must match the call to Allocate.
+	void Free(void* p, int32 size, b2AllocTag tag);
 
 	void Clear();
 
+	/// Free every block at once but keep the chunks, so refilling the
+	/// allocator does not grow it. Large blocks are not tracked here and must
+	/// be freed by the caller first. This is linear in the number of blocks.
+	void Reset();
+
+	/// Return chunks that hold no live blocks to the backing allocator. This
+	/// walks every free block, so call it occasionally, e.g. after a burst of
+	/// destruction. Returns the number of bytes released.
+	int32 Trim();
+
+	/// Add chunks until at least count blocks of the given size can be
+	/// allocated without growing. Reserved chunks are not counted as growth.
+	void Reserve(int32 size, int32 count);
+
+	/// Add chunks until at least counts[i] blocks of size class i can be
+	/// allocated without growing. Use this when objects of different sizes
+	/// share a block size. Reserved chunks are not counted as growth.
+	void Reserve(const int32 counts[b2_blockSizes]);
+
+	/// Get the size class that serves allocations of the given size, or -1 if
+	/// they go to the backing allocator.
+	static int32 GetSizeClass(int32 size);
+
+	/// Get the number of bytes held in chunks. Large blocks are not included.
+	int32 GetChunkBytes() const;
+
+	/// Get the bytes of the live chunk blocks with the given tag, rounded up
+	/// to the block sizes. Large blocks are not included.
+	int32 GetBlockBytes(b2AllocTag tag) const;
+
+	/// Get the number of live chunk blocks with the given tag.
+	int32 GetBlockCount(b2AllocTag tag) const;
+
+	/// Get the number of chunks added on demand by Allocate.
+	int32 GetGrowthCount() const;
+
+	/// Get the usage of each size class.
+	void GetSizeStats(b2BlockSizeStats stats[b2_blockSizes]) const;
+
+	/// Copy the chunks and free lists of another allocator into this one. This
+	/// allocator must be empty. Use b2BlockRelocator to translate pointers into
+	/// the source blocks to the matching blocks of this allocator.
+	void CopyFrom(const b2BlockAllocator& source);
+
 private:
 
+	friend class b2BlockRelocator;
+	friend class b2BlockPool;
+	friend class b2BlockCache;
+
+	void AddChunk(int32 index);
+	void CarveChunk(b2Chunk* chunk, int32 index);
+	void ReserveClass(int32 index, int32 count);
+
+	b2Allocator* m_allocator;
+
 	b2Chunk* m_chunks;
 	int32 m_chunkCount;
 	int32 m_chunkSpace;
+	int32 m_growthCount;
 
 	b2Block* m_freeLists[b2_blockSizes];
 
+	int32 m_liveCounts[b2_blockSizes];
+	int32 m_tagBytes[e_allocTagCount];
+	int32 m_tagCounts[e_allocTagCount];
+
 	static int32 s_blockSizes[b2_blockSizes];
 	static uint8 s_blockSizeLookup[b2_maxBlockSize + 1];
 	static bool s_blockSizeLookupInitialized;
 };
 
+inline int32 b2BlockAllocator::GetChunkBytes() const
+{
+	return m_chunkCount * b2_chunkSize;
+}
+
+inline int32 b2BlockAllocator::GetBlockBytes(b2AllocTag tag) const
+{
+	return m_tagBytes[tag];
+}
+
+inline int32 b2BlockAllocator::GetBlockCount(b2AllocTag tag) const
+{
+	return m_tagCounts[tag];
+}
+
+inline int32 b2BlockAllocator::GetGrowthCount() const
+{
+	return m_growthCount;
+}
+
+/// This translates pointers into the blocks of one allocator to the matching
+/// blocks of a copy made with b2BlockAllocator::CopyFrom. Pointers that were
+/// not allocated from a chunk (NULL, or large blocks from the backing allocator) are returned
+/// unchanged.
+class b2BlockRelocator
+{
+public:
+	b2BlockRelocator(const b2BlockAllocator* source, const b2BlockAllocator* target);
+	~b2BlockRelocator();
+
+	/// Translate a pointer to any byte inside a source block.
+	void* Relocate(const void* p) const;
+
+	/// Get the index of the source chunk holding the address, or -1 if the
+	/// address is not inside a chunk. This is a binary search.
+	int32 FindChunk(const void* p) const;
+
+	template <typename T>
+	T* Relocate(T* p) const
+	{
+		return (T*)Relocate((const void*)p);
+	}
+
+private:
+
+	const b2BlockAllocator* m_source;
+	const b2BlockAllocator* m_target;
+
+	// Source chunk indices sorted by address, from the target's allocator.
+	int32* m_order;
+	int32 m_orderBytes;
+};
+
 #endif
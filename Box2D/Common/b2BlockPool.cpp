@@ -0,0 +1,216 @@
+/*
+* Copyright (c) 2011 Erin Catto http://box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <Box2D/Common/b2BlockPool.h>
+#include <cstring>
+using namespace std;
+
+b2BlockPool::b2BlockPool(b2Allocator* allocator) : m_blocks(allocator)
+{
+	m_lockCount = 0;
+}
+
+b2BlockPool::~b2BlockPool()
+{
+}
+
+int32 b2BlockPool::Trim()
+{
+	b2MutexLock lock(&m_mutex);
+	++m_lockCount;
+	return m_blocks.Trim();
+}
+
+int32 b2BlockPool::GetChunkBytes()
+{
+	b2MutexLock lock(&m_mutex);
+	++m_lockCount;
+	return m_blocks.GetChunkBytes();
+}
+
+void b2BlockPool::GetSizeStats(b2BlockSizeStats stats[b2_blockSizes])
+{
+	b2MutexLock lock(&m_mutex);
+	++m_lockCount;
+	m_blocks.GetSizeStats(stats);
+}
+
+int32 b2BlockPool::GetLockCount()
+{
+	b2MutexLock lock(&m_mutex);
+	return m_lockCount;
+}
+
+// Take count blocks of a size class, adding chunks as needed. The
+// blocks are returned as a NULL terminated list.
+b2Block* b2BlockPool::Acquire(int32 index, int32 count)
+{
+	b2MutexLock lock(&m_mutex);
+	++m_lockCount;
+
+	b2Block** freeList = m_blocks.m_freeLists + index;
+	b2Block* first = NULL;
+	for (int32 i = 0; i < count; ++i)
+	{
+		if (*freeList == NULL)
+		{
+			m_blocks.AddChunk(index);
+			++m_blocks.m_growthCount;
+		}
+
+		b2Block* block = *freeList;
+		*freeList = block->next;
+		block->next = first;
+		first = block;
+	}
+
+	m_blocks.m_liveCounts[index] += count;
+	return first;
+}
+
+// Give back a list of count blocks of a size class.
+void b2BlockPool::Release(int32 index, b2Block* first, b2Block* last, int32 count)
+{
+	b2MutexLock lock(&m_mutex);
+	++m_lockCount;
+
+	last->next = m_blocks.m_freeLists[index];
+	m_blocks.m_freeLists[index] = first;
+	m_blocks.m_liveCounts[index] -= count;
+}
+
+void* b2BlockPool::AllocateLarge(int32 size, b2AllocTag tag)
+{
+	b2MutexLock lock(&m_mutex);
+	++m_lockCount;
+	return m_blocks.m_allocator->Allocate(size, tag);
+}
+
+void b2BlockPool::FreeLarge(void* p, int32 size, b2AllocTag tag)
+{
+	b2MutexLock lock(&m_mutex);
+	++m_lockCount;
+	m_blocks.m_allocator->Free(p, size, tag);
+}
+
+b2BlockCache::b2BlockCache(b2BlockPool* pool)
+{
+	m_pool = pool;
+	memset(m_freeLists, 0, sizeof(m_freeLists));
+	memset(m_freeCounts, 0, sizeof(m_freeCounts));
+	memset(m_tagBytes, 0, sizeof(m_tagBytes));
+}
+
+b2BlockCache::~b2BlockCache()
+{
+	Flush();
+}
+
+void* b2BlockCache::Allocate(int32 size, b2AllocTag tag)
+{
+	if (size == 0)
+	{
+		return NULL;
+	}
+
+	b2Assert(0 < size);
+
+	if (size > b2_maxBlockSize)
+	{
+		return m_pool->AllocateLarge(size, tag);
+	}
+
+	int32 index = b2BlockAllocator::s_blockSizeLookup[size];
+	b2Assert(0 <= index && index < b2_blockSizes);
+
+	if (m_freeLists[index] == NULL)
+	{
+		m_freeLists[index] = m_pool->Acquire(index, b2_blockBatchSize);
+		m_freeCounts[index] = b2_blockBatchSize;
+	}
+
+	m_tagBytes[tag] += b2BlockAllocator::s_blockSizes[index];
+
+	b2Block* block = m_freeLists[index];
+	m_freeLists[index] = block->next;
+	--m_freeCounts[index];
+	return block;
+}
+
+void b2BlockCache::Free(void* p, int32 size, b2AllocTag tag)
+{
+	if (size == 0)
+	{
+		return;
+	}
+
+	b2Assert(0 < size);
+
+	if (size > b2_maxBlockSize)
+	{
+		m_pool->FreeLarge(p, size, tag);
+		return;
+	}
+
+	int32 index = b2BlockAllocator::s_blockSizeLookup[size];
+	b2Assert(0 <= index && index < b2_blockSizes);
+
+	m_tagBytes[tag] -= b2BlockAllocator::s_blockSizes[index];
+
+	b2Block* block = (b2Block*)p;
+	block->next = m_freeLists[index];
+	m_freeLists[index] = block;
+	++m_freeCounts[index];
+
+	// Keep one batch for the next allocations and give the rest back,
+	// so a thread that only frees does not hoard blocks.
+	if (m_freeCounts[index] >= 2 * b2_blockBatchSize)
+	{
+		b2Block* first = m_freeLists[index];
+		b2Block* last = first;
+		for (int32 i = 1; i < b2_blockBatchSize; ++i)
+		{
+			last = last->next;
+		}
+
+		m_freeLists[index] = last->next;
+		m_freeCounts[index] -= b2_blockBatchSize;
+		m_pool->Release(index, first, last, b2_blockBatchSize);
+	}
+}
+
+void b2BlockCache::Flush()
+{
+	for (int32 i = 0; i < b2_blockSizes; ++i)
+	{
+		if (m_freeLists[i] == NULL)
+		{
+			continue;
+		}
+
+		b2Block* last = m_freeLists[i];
+		while (last->next)
+		{
+			last = last->next;
+		}
+
+		m_pool->Release(i, m_freeLists[i], last, m_freeCounts[i]);
+		m_freeLists[i] = NULL;
+		m_freeCounts[i] = 0;
+	}
+}
@@ -0,0 +1,113 @@
+/*
+* Copyright (c) 2011 Erin Catto http://box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_BLOCK_POOL_H
+#define B2_BLOCK_POOL_H
+
+#include <Box2D/Common/b2BlockAllocator.h>
+#include <Box2D/Common/b2Mutex.h>
+
+/// The number of blocks a b2BlockCache takes from or gives back to its pool
+/// at once.
+const int32 b2_blockBatchSize = 32;
+
+/// A small object allocator that can be shared by several threads. Threads
+/// do not allocate from the pool directly. Each thread owns a b2BlockCache,
+/// which keeps its own free lists and trades blocks with the pool in batches,
+/// so the pool is locked about once per b2_blockBatchSize allocations.
+class b2BlockPool
+{
+public:
+	/// Chunks and large blocks are taken from the given allocator. The
+	/// pool serializes its calls to it.
+	b2BlockPool(b2Allocator* allocator = &b2_defaultAllocator);
+
+	/// All caches must be destroyed first.
+	~b2BlockPool();
+
+	/// Return chunks that hold no blocks in use or in a cache. Returns the
+	/// number of bytes released.
+	int32 Trim();
+
+	/// Get the number of bytes held in chunks.
+	int32 GetChunkBytes();
+
+	/// Get the usage of each size class. Blocks held by caches count as live.
+	void GetSizeStats(b2BlockSizeStats stats[b2_blockSizes]);
+
+	/// Get the number of times the pool was locked.
+	int32 GetLockCount();
+
+private:
+
+	friend class b2BlockCache;
+
+	b2Block* Acquire(int32 index, int32 count);
+	void Release(int32 index, b2Block* first, b2Block* last, int32 count);
+
+	void* AllocateLarge(int32 size, b2AllocTag tag);
+	void FreeLarge(void* p, int32 size, b2AllocTag tag);
+
+	b2Mutex m_mutex;
+	b2BlockAllocator m_blocks;
+	int32 m_lockCount;
+};
+
+/// A per-thread front end of a b2BlockPool with the interface of
+/// b2BlockAllocator. A cache must only be used by one thread at a time.
+/// Blocks may be freed through a different cache of the same pool than
+/// the one they were allocated from.
+class b2BlockCache
+{
+public:
+	b2BlockCache(b2BlockPool* pool);
+
+	/// Give all cached blocks back to the pool.
+	~b2BlockCache();
+
+	/// Allocate memory. Sizes above b2_maxBlockSize go to the backing
+	/// allocator of the pool.
+	void* Allocate(int32 size, b2AllocTag tag);
+
+	/// Free memory. The size and tag must match the call to Allocate.
+	void Free(void* p, int32 size, b2AllocTag tag);
+
+	/// Give all cached blocks back to the pool, for example before the
+	/// thread goes idle.
+	void Flush();
+
+	/// Get the bytes of the blocks with the given tag allocated through
+	/// this cache minus those freed through it.
+	int32 GetBlockBytes(b2AllocTag tag) const;
+
+private:
+
+	b2BlockPool* m_pool;
+
+	b2Block* m_freeLists[b2_blockSizes];
+	int32 m_freeCounts[b2_blockSizes];
+
+	int32 m_tagBytes[e_allocTagCount];
+};
+
+inline int32 b2BlockCache::GetBlockBytes(b2AllocTag tag) const
+{
+	return m_tagBytes[tag];
+}
+
+#endif
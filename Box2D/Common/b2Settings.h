@@ -31,6 +31,8 @@ typedef signed int int32;
 typedef unsigned char uint8;
 typedef unsigned short uint16;
 typedef unsigned int uint32;
+typedef signed long long int64;
+typedef unsigned long long uint64;
 typedef float float32;
 typedef double float64;
 
@@ -78,6 +80,12 @@ typedef double float64;
 /// Maximum number of sub-steps per contact in continuous physics simulation.
 #define b2_maxSubSteps			8
 
+/// With manifold reuse a contact keeps its manifold until the bodies have moved
+/// against each other by more than these tolerances since it was computed.
+/// @see b2World::SetManifoldReuse
+#define b2_manifoldReuseLinearTolerance		(0.25f * b2_linearSlop)
+#define b2_manifoldReuseAngularTolerance	(0.25f * b2_angularSlop)
+
 
 // Dynamics
 
@@ -112,6 +120,17 @@ typedef double float64;
 #define b2_baumgarte				0.2f
 #define b2_toiBaugarte				0.75f
 
+/// The stiffness of contacts in the soft step solver, in Hertz. It is limited
+/// to a quarter of the sub-step rate.
+#define b2_contactHertz				60.0f
+
+/// The damping ratio of contacts in the soft step solver. Contacts are over-damped
+/// so overlap is removed without bounce.
+#define b2_contactDampingRatio		10.0f
+
+/// The maximum speed at which the soft step solver pushes overlapping shapes apart.
+#define b2_contactPushVelocity		3.0f
+
 
 // Sleep
 
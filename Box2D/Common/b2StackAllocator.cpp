@@ -19,8 +19,12 @@
 #include <Box2D/Common/b2StackAllocator.h>
 #include <Box2D/Common/b2Math.h>
 
-b2StackAllocator::b2StackAllocator()
+b2StackAllocator::b2StackAllocator(b2Allocator* allocator)
 {
+	m_allocator = allocator;
+	m_data = (char*)m_allocator->Allocate(b2_stackSize, e_allocTagStack);
+	m_capacity = b2_stackSize;
+	m_growthCount = 0;
 	m_index = 0;
 	m_allocation = 0;
 	m_maxAllocation = 0;
@@ -31,17 +35,21 @@ b2StackAllocator::~b2StackAllocator()
 {
 	b2Assert(m_index == 0);
 	b2Assert(m_entryCount == 0);
+	m_allocator->Free(m_data, m_capacity, e_allocTagStack);
 }
 
 void* b2StackAllocator::Allocate(int32 size)
 {
 	b2Assert(m_entryCount < b2_maxStackEntries);
 
+	// Round up so the next block stays aligned for pointers.
+	size = (size + b2_stackAlignment - 1) & ~(b2_stackAlignment - 1);
+
 	b2StackEntry* entry = m_entries + m_entryCount;
 	entry->size = size;
-	if (m_index + size > b2_stackSize)
+	if (m_index + size > m_capacity)
 	{
-		entry->data = (char*)b2Alloc(size);
+		entry->data = (char*)m_allocator->Allocate(size, e_allocTagStack);
 		entry->usedMalloc = true;
 	}
 	else
@@ -65,7 +73,7 @@ void b2StackAllocator::Free(void* p)
 	b2Assert(p == entry->data);
 	if (entry->usedMalloc)
 	{
-		b2Free(p);
+		m_allocator->Free(p, entry->size, e_allocTagStack);
 	}
 	else
 	{
@@ -74,10 +82,44 @@ void b2StackAllocator::Free(void* p)
 	m_allocation -= entry->size;
 	--m_entryCount;
 
+	// Leave some slack so a slowly rising peak does not grow every step.
+	if (m_entryCount == 0 && m_maxAllocation > m_capacity)
+	{
+		Grow(m_maxAllocation + m_maxAllocation / 4);
+		++m_growthCount;
+	}
+
 	p = NULL;
 }
 
+void b2StackAllocator::Reserve(int32 size)
+{
+	b2Assert(m_entryCount == 0);
+	if (m_entryCount == 0 && size > m_capacity)
+	{
+		Grow(size);
+	}
+}
+
+void b2StackAllocator::Grow(int32 capacity)
+{
+	b2Assert(m_index == 0);
+	m_allocator->Free(m_data, m_capacity, e_allocTagStack);
+	m_data = (char*)m_allocator->Allocate(capacity, e_allocTagStack);
+	m_capacity = capacity;
+}
+
 int32 b2StackAllocator::GetMaxAllocation() const
 {
 	return m_maxAllocation;
 }
+
+int32 b2StackAllocator::GetCapacity() const
+{
+	return m_capacity;
+}
+
+int32 b2StackAllocator::GetGrowthCount() const
+{
+	return m_growthCount;
+}
@@ -19,10 +19,11 @@
 #ifndef B2_STACK_ALLOCATOR_H
 #define B2_STACK_ALLOCATOR_H
 
-#include <Box2D/Common/b2Settings.h>
+#include <Box2D/Common/b2Allocator.h>
 
-const int32 b2_stackSize = 100 * 1024;	// 100k
+const int32 b2_stackSize = 100 * 1024;	// 100k initial capacity
 const int32 b2_maxStackEntries = 32;
+const int32 b2_stackAlignment = 8;
 
 struct b2StackEntry
 {
@@ -34,20 +35,40 @@ struct b2StackEntry
 // This is a stack allocator used for fast per step allocations.
 // You must nest allocate/free pairs. The code will assert
 // if you try to interleave multiple allocate/free pairs.
+// Allocations that do not fit fall back to b2Alloc. Once the stack is
+// empty again the buffer grows to the high-water mark, so a repeated
+// workload stops touching the heap after its first pass.
 class b2StackAllocator
 {
 public:
-	b2StackAllocator();
+	/// The buffer and overflow allocations are taken from the given allocator.
+	b2StackAllocator(b2Allocator* allocator = &b2_defaultAllocator);
 	~b2StackAllocator();
 
 	void* Allocate(int32 size);
 	void Free(void* p);
 
+	/// Grow the buffer to at least the given size. The stack must be empty.
+	/// This is not counted as growth.
+	void Reserve(int32 size);
+
 	int32 GetMaxAllocation() const;
 
+	/// Get the size of the buffer.
+	int32 GetCapacity() const;
+
+	/// Get the number of times the buffer has grown to a new high-water mark.
+	int32 GetGrowthCount() const;
+
 private:
 
-	char m_data[b2_stackSize];
+	void Grow(int32 capacity);
+
+	b2Allocator* m_allocator;
+
+	char* m_data;
+	int32 m_capacity;
+	int32 m_growthCount;
 	int32 m_index;
 
 	int32 m_allocation;
@@ -18,83 +18,143 @@
 
 #include <Box2D/Common/b2Timer.h>
 
-#if defined(_WIN32)
+#if defined(B2_TIMER_RDTSC) && (defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64))
 
-float64 b2Timer::s_invFrequency = 0.0f;
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
 
+#if defined(_WIN32)
 #include <windows.h>
+#else
+#include <time.h>
+#endif
 
-b2Timer::b2Timer()
+// The reference clock used to calibrate the time stamp counter.
+static int64 b2ReferenceClock()
 {
-	LARGE_INTEGER largeInteger;
+#if defined(_WIN32)
+	LARGE_INTEGER count, frequency;
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&frequency);
+	return int64(float64(count.QuadPart) * 1.0e9 / float64(frequency.QuadPart));
+#else
+	timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return int64(t.tv_sec) * 1000000000 + t.tv_nsec;
+#endif
+}
+
+static float64 s_nanosecondsPerTick = 0.0;
 
-	if (s_invFrequency == 0.0f)
+// Measure the counter frequency against the reference clock over a few
+// milliseconds. This runs once, on first use.
+static float64 b2CalibrateTicks()
+{
+	int64 clock0 = b2ReferenceClock();
+	uint64 tick0 = __rdtsc();
+	int64 clock1 = clock0;
+	while (clock1 - clock0 < 5000000)
 	{
-		QueryPerformanceFrequency(&largeInteger);
-		s_invFrequency = float64(largeInteger.QuadPart);
-		if (s_invFrequency > 0.0f)
-		{
-			s_invFrequency = 1000.0f / s_invFrequency;
-		}
+		clock1 = b2ReferenceClock();
 	}
-
-	QueryPerformanceCounter(&largeInteger);
-	m_start = float64(largeInteger.QuadPart);
+	uint64 tick1 = __rdtsc();
+	return float64(clock1 - clock0) / float64(tick1 - tick0);
 }
 
-void b2Timer::Reset()
+int64 b2Timer::GetTimestamp()
 {
-	LARGE_INTEGER largeInteger;
-	QueryPerformanceCounter(&largeInteger);
-	m_start = float64(largeInteger.QuadPart);
+	if (s_nanosecondsPerTick == 0.0)
+	{
+		s_nanosecondsPerTick = b2CalibrateTicks();
+	}
+
+	return int64(float64(__rdtsc()) * s_nanosecondsPerTick);
 }
 
-float32 b2Timer::GetMilliseconds() const
+#elif defined(_WIN32)
+
+#include <windows.h>
+
+static int64 s_frequency = 0;
+
+int64 b2Timer::GetTimestamp()
 {
 	LARGE_INTEGER largeInteger;
+
+	if (s_frequency == 0)
+	{
+		QueryPerformanceFrequency(&largeInteger);
+		s_frequency = largeInteger.QuadPart;
+	}
+
 	QueryPerformanceCounter(&largeInteger);
-	float64 count = float64(largeInteger.QuadPart);
-	float32 ms = float32(s_invFrequency * (count - m_start));
-	return ms;
+	int64 count = largeInteger.QuadPart;
+
+	// Split the conversion so the multiplication cannot overflow.
+	int64 seconds = count / s_frequency;
+	int64 remainder = count % s_frequency;
+	return seconds * 1000000000 + remainder * 1000000000 / s_frequency;
 }
 
-#elif defined(__linux__) || defined (__APPLE__)
+#elif defined(__APPLE__)
 
-#include <sys/time.h>
+#include <mach/mach_time.h>
 
-b2Timer::b2Timer()
+static mach_timebase_info_data_t s_timebase;
+
+int64 b2Timer::GetTimestamp()
 {
-    Reset();
+	if (s_timebase.denom == 0)
+	{
+		mach_timebase_info(&s_timebase);
+	}
+
+	// Split the conversion so the multiplication cannot overflow.
+	uint64 ticks = mach_absolute_time();
+	uint64 high = (ticks / s_timebase.denom) * s_timebase.numer;
+	uint64 low = (ticks % s_timebase.denom) * s_timebase.numer / s_timebase.denom;
+	return int64(high + low);
 }
 
-void b2Timer::Reset()
+#elif defined(__linux__)
+
+#include <time.h>
+
+int64 b2Timer::GetTimestamp()
 {
-    timeval t;
-    gettimeofday(&t, 0);
-    m_start_sec = t.tv_sec;
-    m_start_msec = t.tv_usec * 0.001f;
+	timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return int64(t.tv_sec) * 1000000000 + t.tv_nsec;
 }
 
-float32 b2Timer::GetMilliseconds() const
+#else
+
+int64 b2Timer::GetTimestamp()
 {
-    timeval t;
-    gettimeofday(&t, 0);
-    return (t.tv_sec - m_start_sec) * 1000 + t.tv_usec * 0.001f - m_start_msec;
+	return 0;
 }
 
-#else
+#endif
 
 b2Timer::b2Timer()
 {
+	Reset();
 }
 
 void b2Timer::Reset()
 {
+	m_start = GetTimestamp();
 }
 
 float32 b2Timer::GetMilliseconds() const
 {
-	return 0.0f;
+	return float32(1.0e-6 * float64(GetTimestamp() - m_start));
 }
 
-#endif
+int64 b2Timer::GetNanoseconds() const
+{
+	return GetTimestamp() - m_start;
+}
@@ -19,7 +19,10 @@
 #include <Box2D/Common/b2Settings.h>
 
 /// Timer for profiling. This has platform specific code and may
-/// not work on every platform.
+/// not work on every platform. The clock is monotonic: QueryPerformanceCounter
+/// on Windows, mach_absolute_time on Apple and CLOCK_MONOTONIC on Linux.
+/// Define B2_TIMER_RDTSC to read the x86 time stamp counter instead, which is
+/// cheaper but assumes an invariant TSC that is synchronized across cores.
 class b2Timer
 {
 public:
@@ -33,13 +36,14 @@ public:
 	/// Get the time since construction or the last reset.
 	float32 GetMilliseconds() const;
 
+	/// Get the time since construction or the last reset in nanoseconds.
+	int64 GetNanoseconds() const;
+
+	/// Get the current time of the clock in nanoseconds. Only differences
+	/// between two readings are meaningful.
+	static int64 GetTimestamp();
+
 private:
 
-#if defined(_WIN32)
-	float64 m_start;
-	static float64 s_invFrequency;
-#elif defined(__linux__) || defined (__APPLE__)
-	unsigned long m_start_sec;
-	unsigned long m_start_msec;
-#endif
+	int64 m_start;
 };
@@ -0,0 +1,133 @@
+/*
+* Copyright (c) 2011 Erin Catto http://box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <Box2D/Common/b2Trace.h>
+#include <Box2D/Common/b2Timer.h>
+
+#include <cstdio>
+#include <cstring>
+
+bool b2_traceActive = false;
+
+static b2TraceEvent* s_traceEvents = NULL;
+static int32 s_traceCapacity = 0;
+static int32 s_traceCount = 0;
+static int32 s_traceNext = 0;
+
+static int64 s_traceOrigin = 0;
+
+void b2TraceStart(int32 capacity)
+{
+	b2Assert(capacity > 0);
+
+	if (capacity != s_traceCapacity)
+	{
+		b2TraceFree();
+		s_traceEvents = (b2TraceEvent*)b2Alloc(capacity * sizeof(b2TraceEvent));
+		s_traceCapacity = capacity;
+	}
+
+	s_traceCount = 0;
+	s_traceNext = 0;
+	s_traceOrigin = b2Timer::GetTimestamp();
+	b2_traceActive = true;
+}
+
+void b2TraceStop()
+{
+	b2_traceActive = false;
+}
+
+void b2TraceFree()
+{
+	b2_traceActive = false;
+	b2Free(s_traceEvents);
+	s_traceEvents = NULL;
+	s_traceCapacity = 0;
+	s_traceCount = 0;
+	s_traceNext = 0;
+}
+
+int32 b2TraceGetEventCount()
+{
+	return s_traceCount;
+}
+
+const b2TraceEvent* b2TraceGetEvent(int32 index)
+{
+	b2Assert(0 <= index && index < s_traceCount);
+	int32 oldest = s_traceCount < s_traceCapacity ? 0 : s_traceNext;
+	return s_traceEvents + (oldest + index) % s_traceCapacity;
+}
+
+float64 b2TraceNow()
+{
+	return 1.0e-3 * float64(b2Timer::GetTimestamp() - s_traceOrigin);
+}
+
+void b2TraceRecord(const char* name, b2TraceEventType type, float64 time, float64 duration, float32 value)
+{
+	if (s_traceCapacity == 0)
+	{
+		return;
+	}
+
+	b2TraceEvent* event = s_traceEvents + s_traceNext;
+	event->name = name;
+	event->type = type;
+	event->time = time;
+	event->duration = duration;
+	event->value = value;
+
+	s_traceNext = (s_traceNext + 1) % s_traceCapacity;
+	if (s_traceCount < s_traceCapacity)
+	{
+		++s_traceCount;
+	}
+}
+
+static void b2TraceWrite(b2TraceWriteFcn* fcn, void* context, const char* text)
+{
+	fcn(text, (int32)strlen(text), context);
+}
+
+void b2TraceExport(b2TraceWriteFcn* fcn, void* context)
+{
+	char buffer[256];
+
+	b2TraceWrite(fcn, context, "{\"traceEvents\":[\n");
+	for (int32 i = 0; i < s_traceCount; ++i)
+	{
+		const b2TraceEvent* event = b2TraceGetEvent(i);
+		const char* separator = i + 1 < s_traceCount ? ",\n" : "\n";
+		if (event->type == e_traceZone)
+		{
+			sprintf(buffer, "{\"name\":\"%.64s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+				"\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"value\":%g}}%s",
+				event->name, event->time, event->duration, event->value, separator);
+		}
+		else
+		{
+			sprintf(buffer, "{\"name\":\"%.64s\",\"ph\":\"C\",\"pid\":1,\"tid\":1,"
+				"\"ts\":%.3f,\"args\":{\"value\":%g}}%s",
+				event->name, event->time, event->value, separator);
+		}
+		b2TraceWrite(fcn, context, buffer);
+	}
+	b2TraceWrite(fcn, context, "],\"displayTimeUnit\":\"ms\"}\n");
+}
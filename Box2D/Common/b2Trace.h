@@ -0,0 +1,123 @@
+/*
+* Copyright (c) 2011 Erin Catto http://box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_TRACE_H
+#define B2_TRACE_H
+
+#include <Box2D/Common/b2Settings.h>
+
+/// Instrumentation for profiling captures. The engine marks its phases with
+/// the b2TraceScope and b2TraceCounter macros. These compile to nothing unless
+/// B2_ENABLE_TRACE is defined. When compiled in, events are only recorded
+/// between b2TraceStart and b2TraceStop. Recording is not thread safe.
+
+enum b2TraceEventType
+{
+	e_traceZone,
+	e_traceCounter
+};
+
+/// A recorded event. Times are in microseconds since b2TraceStart.
+struct b2TraceEvent
+{
+	const char* name;			///< static string given to the macro
+	b2TraceEventType type;
+	float64 time;				///< zone start or counter sample time
+	float64 duration;			///< zone duration, zero for counters
+	float32 value;				///< counter value or zone argument
+};
+
+/// Receives the exported trace text in pieces.
+typedef void b2TraceWriteFcn(const char* text, int32 length, void* context);
+
+/// Start recording. The ring buffer keeps the most recent capacity events
+/// and replaces any events from a previous capture.
+void b2TraceStart(int32 capacity);
+
+/// Stop recording. Recorded events stay available until the next start.
+void b2TraceStop();
+
+/// Release the ring buffer.
+void b2TraceFree();
+
+/// Get the number of events held in the ring buffer.
+int32 b2TraceGetEventCount();
+
+/// Get an event from the ring buffer, oldest first.
+const b2TraceEvent* b2TraceGetEvent(int32 index);
+
+/// Write the held events as Chrome trace-event JSON (chrome://tracing).
+void b2TraceExport(b2TraceWriteFcn* fcn, void* context);
+
+/// Current trace time in microseconds.
+float64 b2TraceNow();
+
+/// Append an event to the ring buffer.
+void b2TraceRecord(const char* name, b2TraceEventType type, float64 time, float64 duration, float32 value);
+
+extern bool b2_traceActive;
+
+/// Records a zone covering its own lifetime.
+class b2TraceZone
+{
+public:
+	b2TraceZone(const char* name, float32 value)
+	{
+		m_name = name;
+		m_value = value;
+		m_start = b2_traceActive ? b2TraceNow() : -1.0;
+	}
+
+	~b2TraceZone()
+	{
+		if (b2_traceActive && m_start >= 0.0)
+		{
+			b2TraceRecord(m_name, e_traceZone, m_start, b2TraceNow() - m_start, m_value);
+		}
+	}
+
+private:
+	const char* m_name;
+	float64 m_start;
+	float32 m_value;
+};
+
+#define b2TraceJoin2(a, b) a##b
+#define b2TraceJoin(a, b) b2TraceJoin2(a, b)
+
+#ifdef B2_ENABLE_TRACE
+
+/// Trace the enclosing scope.
+#define b2TraceScope(name) b2TraceZone b2TraceJoin(b2_traceZone, __LINE__)(name, 0.0f)
+
+/// Trace the enclosing scope, tagged with a value such as an island size.
+#define b2TraceScopeValue(name, value) b2TraceZone b2TraceJoin(b2_traceZone, __LINE__)(name, float32(value))
+
+/// Sample a counter.
+#define b2TraceCounter(name, value) \
+	do { if (b2_traceActive) b2TraceRecord(name, e_traceCounter, b2TraceNow(), 0.0, float32(value)); } while (0)
+
+#else
+
+#define b2TraceScope(name)
+#define b2TraceScopeValue(name, value) B2_NOT_USED(value)
+#define b2TraceCounter(name, value) B2_NOT_USED(value)
+
+#endif
+
+#endif
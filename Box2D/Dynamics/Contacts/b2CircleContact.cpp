@@ -28,14 +28,14 @@ using namespace std;
 
 b2Contact* b2CircleContact::Create(b2Fixture* fixtureA, int32, b2Fixture* fixtureB, int32, b2BlockAllocator* allocator)
 {
-	void* mem = allocator->Allocate(sizeof(b2CircleContact));
+	void* mem = allocator->Allocate(sizeof(b2CircleContact), e_allocTagContact);
 	return new (mem) b2CircleContact(fixtureA, fixtureB);
 }
 
 void b2CircleContact::Destroy(b2Contact* contact, b2BlockAllocator* allocator)
 {
 	((b2CircleContact*)contact)->~b2CircleContact();
-	allocator->Free(contact, sizeof(b2CircleContact));
+	allocator->Free(contact, sizeof(b2CircleContact), e_allocTagContact);
 }
 
 b2CircleContact::b2CircleContact(b2Fixture* fixtureA, b2Fixture* fixtureB)
@@ -51,3 +51,10 @@ void b2CircleContact::Evaluate(b2Manifold* manifold, const b2Transform& xfA, con
 					(b2CircleShape*)m_fixtureA->GetShape(), xfA,
 					(b2CircleShape*)m_fixtureB->GetShape(), xfB);
 }
+
+void b2CircleContact::Evaluate(b2Manifold* manifold, const b2Transform& xfA, const b2Transform& xfB, float32 speculativeDistance)
+{
+	b2CollideCircles(manifold,
+					(b2CircleShape*)m_fixtureA->GetShape(), xfA,
+					(b2CircleShape*)m_fixtureB->GetShape(), xfB, speculativeDistance);
+}
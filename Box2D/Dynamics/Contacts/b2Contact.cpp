@@ -25,6 +25,7 @@
 #include <Box2D/Dynamics/Contacts/b2ChainAndCircleContact.h>
 #include <Box2D/Dynamics/Contacts/b2ChainAndPolygonContact.h>
 #include <Box2D/Dynamics/Contacts/b2ContactSolver.h>
+#include <Box2D/Dynamics/Contacts/b2ContactCache.h>
 
 #include <Box2D/Collision/b2Collision.h>
 #include <Box2D/Collision/b2TimeOfImpact.h>
@@ -128,7 +129,11 @@ b2Contact::b2Contact(b2Fixture* fA, int32 indexA, b2Fixture* fB, int32 indexB)
 	m_indexA = indexA;
 	m_indexB = indexB;
 
+	m_pairType = fA->GetType() * b2Shape::e_typeCount + fB->GetType();
+
 	m_manifold.pointCount = 0;
+	m_manifoldXf.SetIdentity();
+	m_manifoldDistance = 0.0f;
 
 	m_prev = NULL;
 	m_next = NULL;
@@ -149,16 +154,49 @@ b2Contact::b2Contact(b2Fixture* fA, int32 indexA, b2Fixture* fB, int32 indexB)
 	m_restitution = b2MixRestitution(m_fixtureA->m_restitution, m_fixtureB->m_restitution);
 }
 
+b2ContactCacheKey b2Contact::GetCacheKey() const
+{
+	b2ContactCacheKey key;
+	key.proxyIdA = m_fixtureA->m_proxies[m_indexA].proxyId;
+	key.proxyIdB = m_fixtureB->m_proxies[m_indexB].proxyId;
+	key.bodyIdA = m_fixtureA->GetBody()->GetId();
+	key.bodyIdB = m_fixtureB->GetBody()->GetId();
+	return key;
+}
+
+void b2Contact::Evaluate(b2Manifold* manifold, const b2Transform& xfA, const b2Transform& xfB, float32 speculativeDistance)
+{
+	B2_NOT_USED(speculativeDistance);
+	Evaluate(manifold, xfA, xfB);
+}
+
+// Calls the Evaluate of the contact class T. The qualified call binds
+// statically. b2Contact itself uses virtual dispatch.
+template <typename T>
+inline void b2EvaluateAs(b2Contact* contact, b2Manifold* manifold, const b2Transform& xfA, const b2Transform& xfB, float32 speculativeDistance)
+{
+	static_cast<T*>(contact)->T::Evaluate(manifold, xfA, xfB, speculativeDistance);
+}
+
+template <>
+inline void b2EvaluateAs<b2Contact>(b2Contact* contact, b2Manifold* manifold, const b2Transform& xfA, const b2Transform& xfB, float32 speculativeDistance)
+{
+	contact->Evaluate(manifold, xfA, xfB, speculativeDistance);
+}
+
 // Update the contact manifold and touching status.
 // Note: do not assume the fixture AABBs are overlapping or are valid.
-void b2Contact::Update(b2ContactListener* listener)
+template <typename T>
+void b2Contact::UpdateAs(b2ContactListener* listener, b2ContactCache* cache, float32 speculativeTime, bool reuseManifold)
 {
 	b2Manifold oldManifold = m_manifold;
 
 	// Re-enable this contact.
 	m_flags |= e_enabledFlag;
+	m_flags &= ~e_reusedFlag;
 
 	bool touching = false;
+	bool speculative = false;
 	bool wasTouching = (m_flags & e_touchingFlag) == e_touchingFlag;
 
 	bool sensorA = m_fixtureA->IsSensor();
@@ -182,9 +220,72 @@ void b2Contact::Update(b2ContactListener* listener)
 	}
 	else
 	{
-		Evaluate(&m_manifold, xfA, xfB);
+		// Keep the points the shapes could reach within the time. The margin
+		// is doubled because collisions in the step can speed the bodies up.
+		float32 speculativeDistance = 0.0f;
+		if (speculativeTime > 0.0f)
+		{
+			b2Vec2 dv = bodyB->GetLinearVelocity() - bodyA->GetLinearVelocity();
+			speculativeDistance = 2.0f * speculativeTime * dv.Length();
+		}
+
+		// The manifold points are in body coordinates, so the world points and
+		// separations still follow the bodies if the manifold is kept. Points
+		// of a larger speculative distance only add gaps the solver may close.
+		b2Transform xfAB = b2MulT(xfA, xfB);
+		bool reuse = false;
+		if (reuseManifold && m_manifold.pointCount > 0 && speculativeDistance <= m_manifoldDistance)
+		{
+			b2Rot dq = b2MulT(m_manifoldXf.q, xfAB.q);
+			float32 linearTolerance = b2_manifoldReuseLinearTolerance;
+			reuse = b2DistanceSquared(xfAB.p, m_manifoldXf.p) < linearTolerance * linearTolerance &&
+				b2Abs(dq.s) < b2_manifoldReuseAngularTolerance && dq.c > 0.0f;
+		}
+
+		if (reuse)
+		{
+			m_flags |= e_reusedFlag;
+		}
+		else
+		{
+			b2EvaluateAs<T>(this, &m_manifold, xfA, xfB, speculativeDistance);
+			m_manifoldXf = xfAB;
+			m_manifoldDistance = speculativeDistance;
+		}
 		touching = m_manifold.pointCount > 0;
 
+		// The shapes only touch if a point has no gap. A kept manifold may
+		// hold speculative points even when this step has no margin.
+		if (touching && m_manifoldDistance > 0.0f)
+		{
+			b2WorldManifold worldManifold;
+			worldManifold.Initialize(&m_manifold, xfA, m_fixtureA->GetShape()->m_radius,
+				xfB, m_fixtureB->GetShape()->m_radius);
+
+			touching = false;
+			for (int32 i = 0; i < m_manifold.pointCount; ++i)
+			{
+				if (worldManifold.separations[i] <= 0.0f)
+				{
+					touching = true;
+					break;
+				}
+			}
+			speculative = touching == false;
+		}
+
+		b2ContactCacheKey cacheKey;
+		if (cache)
+		{
+			cacheKey = GetCacheKey();
+		}
+
+		bool kept[b2_maxManifoldPoints];
+		for (int32 j = 0; j < oldManifold.pointCount; ++j)
+		{
+			kept[j] = false;
+		}
+
 		// Match old contact ids to new contact ids and copy the
 		// stored impulses to warm start the solver.
 		for (int32 i = 0; i < m_manifold.pointCount; ++i)
@@ -194,6 +295,7 @@ void b2Contact::Update(b2ContactListener* listener)
 			mp2->tangentImpulse = 0.0f;
 			b2ContactID id2 = mp2->id;
 
+			bool found = false;
 			for (int32 j = 0; j < oldManifold.pointCount; ++j)
 			{
 				b2ManifoldPoint* mp1 = oldManifold.points + j;
@@ -202,9 +304,28 @@ void b2Contact::Update(b2ContactListener* listener)
 				{
 					mp2->normalImpulse = mp1->normalImpulse;
 					mp2->tangentImpulse = mp1->tangentImpulse;
+					kept[j] = true;
+					found = true;
 					break;
 				}
 			}
+
+			// A point that went away recently may be back.
+			if (found == false && cache)
+			{
+				cache->Fetch(cacheKey, mp2);
+			}
+		}
+
+		if (cache)
+		{
+			for (int32 j = 0; j < oldManifold.pointCount; ++j)
+			{
+				if (kept[j] == false)
+				{
+					cache->Store(cacheKey, oldManifold.points + j);
+				}
+			}
 		}
 
 		if (touching != wasTouching)
@@ -223,6 +344,15 @@ void b2Contact::Update(b2ContactListener* listener)
 		m_flags &= ~e_touchingFlag;
 	}
 
+	if (speculative)
+	{
+		m_flags |= e_speculativeFlag;
+	}
+	else
+	{
+		m_flags &= ~e_speculativeFlag;
+	}
+
 	if (wasTouching == false && touching == true && listener)
 	{
 		listener->BeginContact(this);
@@ -233,8 +363,23 @@ void b2Contact::Update(b2ContactListener* listener)
 		listener->EndContact(this);
 	}
 
-	if (sensor == false && touching && listener)
+	// Speculative points are solved too, so they can be disabled here.
+	if (sensor == false && (touching || speculative) && listener)
 	{
 		listener->PreSolve(this, &oldManifold);
 	}
 }
+
+void b2Contact::Update(b2ContactListener* listener, b2ContactCache* cache, float32 speculativeTime, bool reuseManifold)
+{
+	UpdateAs<b2Contact>(listener, cache, speculativeTime, reuseManifold);
+}
+
+// The contact manager updates each run of one pair type with these.
+template void b2Contact::UpdateAs<b2CircleContact>(b2ContactListener*, b2ContactCache*, float32, bool);
+template void b2Contact::UpdateAs<b2PolygonAndCircleContact>(b2ContactListener*, b2ContactCache*, float32, bool);
+template void b2Contact::UpdateAs<b2PolygonContact>(b2ContactListener*, b2ContactCache*, float32, bool);
+template void b2Contact::UpdateAs<b2EdgeAndCircleContact>(b2ContactListener*, b2ContactCache*, float32, bool);
+template void b2Contact::UpdateAs<b2EdgeAndPolygonContact>(b2ContactListener*, b2ContactCache*, float32, bool);
+template void b2Contact::UpdateAs<b2ChainAndCircleContact>(b2ContactListener*, b2ContactCache*, float32, bool);
+template void b2Contact::UpdateAs<b2ChainAndPolygonContact>(b2ContactListener*, b2ContactCache*, float32, bool);
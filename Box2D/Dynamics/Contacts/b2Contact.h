@@ -31,6 +31,8 @@ class b2World;
 class b2BlockAllocator;
 class b2StackAllocator;
 class b2ContactListener;
+class b2ContactCache;
+struct b2ContactCacheKey;
 
 /// Friction mixing law. The idea is to allow either fixture to drive the restitution to zero.
 /// For example, anything slides on ice.
@@ -58,6 +60,10 @@ struct b2ContactRegister
 	bool primary;
 };
 
+/// The number of shape type pairs of b2Contact::GetPairType. The contact list
+/// of the world keeps the contacts of one pair type together.
+const int32 b2_contactPairTypeCount = b2Shape::e_typeCount * b2Shape::e_typeCount;
+
 /// A contact edge is used to connect bodies and contacts together
 /// in a contact graph where each body is a node and each contact
 /// is an edge. A contact edge belongs to a doubly linked list
@@ -138,6 +144,12 @@ public:
 	/// Evaluate this contact with your own manifold and transforms.
 	virtual void Evaluate(b2Manifold* manifold, const b2Transform& xfA, const b2Transform& xfB) = 0;
 
+	/// Evaluate this contact keeping the points of shapes that are apart by up
+	/// to the speculative distance. Speculative contacts use this. The default
+	/// ignores the distance, so contact classes that only implement the
+	/// evaluation above still work.
+	virtual void Evaluate(b2Manifold* manifold, const b2Transform& xfA, const b2Transform& xfB, float32 speculativeDistance);
+
 protected:
 	friend class b2ContactManager;
 	friend class b2World;
@@ -164,7 +176,13 @@ protected:
 		e_bulletHitFlag		= 0x0010,
 
 		// This contact has a valid TOI in m_toi
-		e_toiFlag			= 0x0020
+		e_toiFlag			= 0x0020,
+
+		// Set when the shapes are apart but have speculative points.
+		e_speculativeFlag	= 0x0040,
+
+		// Set when the last update kept the manifold instead of evaluating it.
+		e_reusedFlag		= 0x0080
 	};
 
 	/// Flag this contact for filtering. Filtering will occur the next time step.
@@ -181,13 +199,30 @@ protected:
 	b2Contact(b2Fixture* fixtureA, int32 indexA, b2Fixture* fixtureB, int32 indexB);
 	virtual ~b2Contact() {}
 
-	void Update(b2ContactListener* listener);
+	// The cache, if any, keeps the impulses of points that go away and gives
+	// them back to points that return. A positive speculative time keeps the
+	// points of shapes that could meet within it. With manifold reuse the
+	// manifold is only evaluated again once the bodies moved against each other.
+	void Update(b2ContactListener* listener, b2ContactCache* cache, float32 speculativeTime, bool reuseManifold);
+
+	// Update with the Evaluate of the contact class T bound statically, so
+	// there is no virtual dispatch. It is instantiated for each contact class.
+	template <typename T>
+	void UpdateAs(b2ContactListener* listener, b2ContactCache* cache, float32 speculativeTime, bool reuseManifold);
+
+	// Index of the shape types of the fixtures, below b2_contactPairTypeCount.
+	int32 GetPairType() const;
+
+	b2ContactCacheKey GetCacheKey() const;
 
 	static b2ContactRegister s_registers[b2Shape::e_typeCount][b2Shape::e_typeCount];
 	static bool s_initialized;
 
 	uint32 m_flags;
 
+	// Kept here so walking the contacts by type does not touch the shapes.
+	int32 m_pairType;
+
 	// World pool and list pointers.
 	b2Contact* m_prev;
 	b2Contact* m_next;
@@ -204,6 +239,11 @@ protected:
 
 	b2Manifold m_manifold;
 
+	// Transform of body B in the frame of body A and the speculative
+	// distance when the manifold was last evaluated.
+	b2Transform m_manifoldXf;
+	float32 m_manifoldDistance;
+
 	int32 m_toiCount;
 	float32 m_toi;
 
@@ -293,6 +333,11 @@ inline int32 b2Contact::GetChildIndexB() const
 	return m_indexB;
 }
 
+inline int32 b2Contact::GetPairType() const
+{
+	return m_pairType;
+}
+
 inline void b2Contact::FlagForFiltering()
 {
 	m_flags |= e_filterFlag;
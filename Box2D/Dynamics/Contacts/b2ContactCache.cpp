@@ -0,0 +1,115 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <Box2D/Dynamics/Contacts/b2ContactCache.h>
+#include <Box2D/Collision/b2Collision.h>
+
+static uint32 b2HashContactPoint(const b2ContactCacheKey& key, uint32 featureKey)
+{
+	uint32 h = uint32(key.proxyIdA) * 0x9e3779b1u;
+	h ^= uint32(key.proxyIdB) * 0x85ebca77u;
+	h ^= featureKey * 0xc2b2ae3du;
+	h ^= h >> 16;
+	return h;
+}
+
+static bool b2IsSameKey(const b2ContactCacheKey& a, const b2ContactCacheKey& b)
+{
+	return a.proxyIdA == b.proxyIdA && a.proxyIdB == b.proxyIdB &&
+		a.bodyIdA == b.bodyIdA && a.bodyIdB == b.bodyIdB;
+}
+
+b2ContactCache::b2ContactCache()
+{
+	m_step = 1;
+	Clear();
+	ResetCounters();
+}
+
+void b2ContactCache::Clear()
+{
+	for (int32 i = 0; i < b2_contactCacheSize; ++i)
+	{
+		m_entries[i].step = 0;
+	}
+}
+
+void b2ContactCache::Store(const b2ContactCacheKey& key, const b2ManifoldPoint* point)
+{
+	if (point->normalImpulse == 0.0f && point->tangentImpulse == 0.0f)
+	{
+		return;
+	}
+
+	uint32 featureKey = point->id.key;
+	uint32 hash = b2HashContactPoint(key, featureKey);
+
+	// Take the slot of the same point, else the oldest probed slot. Free
+	// slots have step zero, so they are the oldest.
+	b2ContactCacheEntry* slot = NULL;
+	for (int32 i = 0; i < b2_contactCacheProbes; ++i)
+	{
+		b2ContactCacheEntry* entry = m_entries + ((hash + i) & (b2_contactCacheSize - 1));
+		if (entry->step != 0 && entry->featureKey == featureKey && b2IsSameKey(entry->key, key))
+		{
+			slot = entry;
+			break;
+		}
+
+		if (slot == NULL || entry->step < slot->step)
+		{
+			slot = entry;
+		}
+	}
+
+	slot->key = key;
+	slot->featureKey = featureKey;
+	slot->step = m_step;
+	slot->normalImpulse = point->normalImpulse;
+	slot->tangentImpulse = point->tangentImpulse;
+	++m_storeCount;
+}
+
+bool b2ContactCache::Fetch(const b2ContactCacheKey& key, b2ManifoldPoint* point)
+{
+	uint32 featureKey = point->id.key;
+	uint32 hash = b2HashContactPoint(key, featureKey);
+
+	for (int32 i = 0; i < b2_contactCacheProbes; ++i)
+	{
+		b2ContactCacheEntry* entry = m_entries + ((hash + i) & (b2_contactCacheSize - 1));
+		if (entry->step == 0 || entry->featureKey != featureKey || b2IsSameKey(entry->key, key) == false)
+		{
+			continue;
+		}
+
+		bool fresh = m_step - entry->step <= b2_contactCacheSteps;
+		entry->step = 0;
+		if (fresh == false)
+		{
+			return false;
+		}
+
+		point->normalImpulse = entry->normalImpulse;
+		point->tangentImpulse = entry->tangentImpulse;
+		++m_restoreCount;
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,113 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_CONTACT_CACHE_H
+#define B2_CONTACT_CACHE_H
+
+#include <Box2D/Common/b2Settings.h>
+
+struct b2ManifoldPoint;
+
+const int32 b2_contactCacheSize = 512;		// must be a power of two
+const int32 b2_contactCacheProbes = 4;
+const uint32 b2_contactCacheSteps = 4;		// steps an entry stays valid
+
+/// Identifies the fixture children of a contact. Proxy ids are reused, so the
+/// body ids guard against a new fixture taking over the proxy of an old one.
+struct b2ContactCacheKey
+{
+	int32 proxyIdA;
+	int32 proxyIdB;
+	uint32 bodyIdA;
+	uint32 bodyIdB;
+};
+
+struct b2ContactCacheEntry
+{
+	b2ContactCacheKey key;
+	uint32 featureKey;
+	uint32 step;				// zero when the entry is free
+	float32 normalImpulse;
+	float32 tangentImpulse;
+};
+
+/// Remembers the impulses of contact points that went away, either because
+/// the shapes separated or because the contact was destroyed, so a point that
+/// comes back within a few steps warm starts instead of starting cold. The
+/// cache is keyed by the fixture children and the feature id. It is small and
+/// lossy: when all probed slots are taken the oldest entry is overwritten.
+/// It holds no pointers, so a cloned world copies it as is.
+class b2ContactCache
+{
+public:
+	b2ContactCache();
+
+	/// Remember the impulses of a point in the current step. Points without
+	/// impulse are ignored.
+	void Store(const b2ContactCacheKey& key, const b2ManifoldPoint* point);
+
+	/// Give a new point the impulses stored for it in the last few steps.
+	/// The entry is consumed.
+	/// @return true if the point was found.
+	bool Fetch(const b2ContactCacheKey& key, b2ManifoldPoint* point);
+
+	/// Start a new step. The cache keeps its own step count so that nothing
+	/// but stepping the world ages the entries.
+	void Advance();
+
+	/// Forget everything.
+	void Clear();
+
+	/// Reset the store and restore counts.
+	void ResetCounters();
+
+	/// Get the number of points stored since the counters were reset.
+	int32 GetStoreCount() const;
+
+	/// Get the number of points restored since the counters were reset.
+	int32 GetRestoreCount() const;
+
+private:
+	b2ContactCacheEntry m_entries[b2_contactCacheSize];
+	uint32 m_step;
+	int32 m_storeCount;
+	int32 m_restoreCount;
+};
+
+inline void b2ContactCache::Advance()
+{
+	++m_step;
+}
+
+inline void b2ContactCache::ResetCounters()
+{
+	m_storeCount = 0;
+	m_restoreCount = 0;
+}
+
+inline int32 b2ContactCache::GetStoreCount() const
+{
+	return m_storeCount;
+}
+
+inline int32 b2ContactCache::GetRestoreCount() const
+{
+	return m_restoreCount;
+}
+
+#endif
@@ -41,6 +41,11 @@ struct b2ContactPositionConstraint
 	int32 pointCount;
 };
 
+int32 b2ContactSolver::GetStackSize(int32 contactCount)
+{
+	return contactCount * (sizeof(b2ContactPositionConstraint) + sizeof(b2ContactVelocityConstraint));
+}
+
 b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 {
 	m_step = def->step;
@@ -51,6 +56,8 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 	m_positions = def->positions;
 	m_velocities = def->velocities;
 	m_contacts = def->contacts;
+	m_softness.Set(0.0f, 0.0f, m_step.dt);
+	m_staticSoftness = m_softness;
 
 	// Initialize position independent portions of the constraints.
 	for (int32 i = 0; i < m_count; ++i)
@@ -121,6 +128,7 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 			vcp->normalMass = 0.0f;
 			vcp->tangentMass = 0.0f;
 			vcp->velocityBias = 0.0f;
+			vcp->separation = 0.0f;
 
 			pc->localPoints[j] = cp->localPoint;
 		}
@@ -136,6 +144,9 @@ b2ContactSolver::~b2ContactSolver()
 // Initialize position dependent portions of the velocity constraints.
 void b2ContactSolver::InitializeVelocityConstraints()
 {
+	// The soft step solver handles positive separation itself.
+	bool speculative = m_step.speculativeContacts && m_step.solverType == b2_sequentialImpulseSolver;
+
 	for (int32 i = 0; i < m_count; ++i)
 	{
 		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
@@ -148,10 +159,6 @@ void b2ContactSolver::InitializeVelocityConstraints()
 		int32 indexA = vc->indexA;
 		int32 indexB = vc->indexB;
 
-		float32 mA = vc->invMassA;
-		float32 mB = vc->invMassB;
-		float32 iA = vc->invIA;
-		float32 iB = vc->invIB;
 		b2Vec2 localCenterA = pc->localCenterA;
 		b2Vec2 localCenterB = pc->localCenterB;
 
@@ -186,22 +193,6 @@ void b2ContactSolver::InitializeVelocityConstraints()
 			vcp->rA = worldManifold.points[j] - cA;
 			vcp->rB = worldManifold.points[j] - cB;
 
-			float32 rnA = b2Cross(vcp->rA, vc->normal);
-			float32 rnB = b2Cross(vcp->rB, vc->normal);
-
-			float32 kNormal = mA + mB + iA * rnA * rnA + iB * rnB * rnB;
-
-			vcp->normalMass = kNormal > 0.0f ? 1.0f / kNormal : 0.0f;
-
-			b2Vec2 tangent = b2Cross(vc->normal, 1.0f);
-
-			float32 rtA = b2Cross(vcp->rA, tangent);
-			float32 rtB = b2Cross(vcp->rB, tangent);
-
-			float32 kTangent = mA + mB + iA * rtA * rtA + iB * rtB * rtB;
-
-			vcp->tangentMass = kTangent > 0.0f ? 1.0f /  kTangent : 0.0f;
-
 			// Setup a velocity bias for restitution.
 			vcp->velocityBias = 0.0f;
 			float32 vRel = b2Dot(vc->normal, vB + b2Cross(wB, vcp->rB) - vA - b2Cross(wA, vcp->rA));
@@ -209,39 +200,115 @@ void b2ContactSolver::InitializeVelocityConstraints()
 			{
 				vcp->velocityBias = -vc->restitution * vRel;
 			}
+			vcp->restitutionBias = vcp->velocityBias;
+
+			if (speculative)
+			{
+				float32 separation = worldManifold.separations[j];
+				if (separation > 0.0f)
+				{
+					// Let the gap close within the step. The point bounces
+					// after the iterations, if it was reached.
+					vcp->velocityBias = -separation * m_step.inv_dt;
+					continue;
+				}
+
+				// Touching points bounce in the iterations.
+				vcp->restitutionBias = 0.0f;
+			}
 		}
 
-		// If we have two points, then prepare the block solver.
-		if (vc->pointCount == 2)
+		InitializeMasses(vc);
+	}
+}
+
+void b2ContactSolver::InitializeMasses(b2ContactVelocityConstraint* vc)
+{
+	float32 mA = vc->invMassA;
+	float32 mB = vc->invMassB;
+	float32 iA = vc->invIA;
+	float32 iB = vc->invIB;
+
+	int32 pointCount = vc->pointCount;
+	for (int32 j = 0; j < pointCount; ++j)
+	{
+		b2VelocityConstraintPoint* vcp = vc->points + j;
+
+		float32 rnA = b2Cross(vcp->rA, vc->normal);
+		float32 rnB = b2Cross(vcp->rB, vc->normal);
+
+		float32 kNormal = mA + mB + iA * rnA * rnA + iB * rnB * rnB;
+
+		vcp->normalMass = kNormal > 0.0f ? 1.0f / kNormal : 0.0f;
+
+		b2Vec2 tangent = b2Cross(vc->normal, 1.0f);
+
+		float32 rtA = b2Cross(vcp->rA, tangent);
+		float32 rtB = b2Cross(vcp->rB, tangent);
+
+		float32 kTangent = mA + mB + iA * rtA * rtA + iB * rtB * rtB;
+
+		vcp->tangentMass = kTangent > 0.0f ? 1.0f /  kTangent : 0.0f;
+	}
+
+	// If we have two points, then prepare the block solver.
+	if (vc->pointCount == 2)
+	{
+		b2VelocityConstraintPoint* vcp1 = vc->points + 0;
+		b2VelocityConstraintPoint* vcp2 = vc->points + 1;
+
+		float32 rn1A = b2Cross(vcp1->rA, vc->normal);
+		float32 rn1B = b2Cross(vcp1->rB, vc->normal);
+		float32 rn2A = b2Cross(vcp2->rA, vc->normal);
+		float32 rn2B = b2Cross(vcp2->rB, vc->normal);
+
+		float32 k11 = mA + mB + iA * rn1A * rn1A + iB * rn1B * rn1B;
+		float32 k22 = mA + mB + iA * rn2A * rn2A + iB * rn2B * rn2B;
+		float32 k12 = mA + mB + iA * rn1A * rn2A + iB * rn1B * rn2B;
+
+		// Ensure a reasonable condition number.
+		const float32 k_maxConditionNumber = 1000.0f;
+		if (k11 * k11 < k_maxConditionNumber * (k11 * k22 - k12 * k12))
+		{
+			// K is safe to invert.
+			vc->K.ex.Set(k11, k12);
+			vc->K.ey.Set(k12, k22);
+			vc->normalMass = vc->K.GetInverse();
+		}
+		else
 		{
-			b2VelocityConstraintPoint* vcp1 = vc->points + 0;
-			b2VelocityConstraintPoint* vcp2 = vc->points + 1;
+			// The constraints are redundant, just use one.
+			// TODO_ERIN use deepest?
+			vc->pointCount = 1;
+		}
+	}
+}
 
-			float32 rn1A = b2Cross(vcp1->rA, vc->normal);
-			float32 rn1B = b2Cross(vcp1->rB, vc->normal);
-			float32 rn2A = b2Cross(vcp2->rA, vc->normal);
-			float32 rn2B = b2Cross(vcp2->rB, vc->normal);
+void b2ContactSolver::FreezeLowerBodies(const int32* levels)
+{
+	for (int32 i = 0; i < m_count; ++i)
+	{
+		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
 
-			float32 k11 = mA + mB + iA * rn1A * rn1A + iB * rn1B * rn1B;
-			float32 k22 = mA + mB + iA * rn2A * rn2A + iB * rn2B * rn2B;
-			float32 k12 = mA + mB + iA * rn1A * rn2A + iB * rn1B * rn2B;
+		int32 levelA = levels[vc->indexA];
+		int32 levelB = levels[vc->indexB];
+		if (levelA == levelB)
+		{
+			continue;
+		}
 
-			// Ensure a reasonable condition number.
-			const float32 k_maxConditionNumber = 1000.0f;
-			if (k11 * k11 < k_maxConditionNumber * (k11 * k22 - k12 * k12))
-			{
-				// K is safe to invert.
-				vc->K.ex.Set(k11, k12);
-				vc->K.ey.Set(k12, k22);
-				vc->normalMass = vc->K.GetInverse();
-			}
-			else
-			{
-				// The constraints are redundant, just use one.
-				// TODO_ERIN use deepest?
-				vc->pointCount = 1;
-			}
+		if (levelA < levelB)
+		{
+			vc->invMassA = 0.0f;
+			vc->invIA = 0.0f;
+		}
+		else
+		{
+			vc->invMassB = 0.0f;
+			vc->invIB = 0.0f;
 		}
+
+		InitializeMasses(vc);
 	}
 }
 
@@ -653,6 +720,13 @@ struct b2PositionSolverManifold
 				normal = -normal;
 			}
 			break;
+
+		default:
+			b2Assert(false);
+			normal.SetZero();
+			point.SetZero();
+			separation = 0.0f;
+			break;
 		}
 	}
 
@@ -830,3 +904,291 @@ bool b2ContactSolver::SolveTOIPositionConstraints(int32 toiIndexA, int32 toiInde
 	// push the separation above -b2_linearSlop.
 	return minSeparation >= -1.5f * b2_linearSlop;
 }
+
+// A soft constraint is a damped spring solved implicitly. With the spring
+// frequency omega, the damping ratio zeta and the sub-step h:
+// biasRate = omega / (2 zeta + h omega)
+// massScale = h omega (2 zeta + h omega) / (1 + h omega (2 zeta + h omega))
+// impulseScale = 1 / (1 + h omega (2 zeta + h omega))
+void b2Softness::Set(float32 hertz, float32 dampingRatio, float32 h)
+{
+	if (hertz == 0.0f)
+	{
+		biasRate = 0.0f;
+		massScale = 1.0f;
+		impulseScale = 0.0f;
+		return;
+	}
+
+	float32 omega = 2.0f * b2_pi * hertz;
+	float32 a1 = 2.0f * dampingRatio + h * omega;
+	float32 a2 = h * omega * a1;
+	float32 a3 = 1.0f / (1.0f + a2);
+	biasRate = omega / a1;
+	massScale = a2 * a3;
+	impulseScale = a3;
+}
+
+void b2ContactSolver::PrepareSoftConstraints(float32 contactHertz, float32 dampingRatio)
+{
+	m_softness.Set(contactHertz, dampingRatio, m_step.dt);
+	m_staticSoftness.Set(2.0f * contactHertz, dampingRatio, m_step.dt);
+
+	for (int32 i = 0; i < m_count; ++i)
+	{
+		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
+		b2ContactPositionConstraint* pc = m_positionConstraints + i;
+
+		int32 indexA = vc->indexA;
+		int32 indexB = vc->indexB;
+
+		b2Vec2 cA = m_positions[indexA].c;
+		float32 aA = m_positions[indexA].a;
+		b2Vec2 cB = m_positions[indexB].c;
+		float32 aB = m_positions[indexB].a;
+
+		b2Transform xfA, xfB;
+		xfA.q.Set(aA);
+		xfB.q.Set(aB);
+		xfA.p = cA - b2Mul(xfA.q, pc->localCenterA);
+		xfB.p = cB - b2Mul(xfB.q, pc->localCenterB);
+
+		for (int32 j = 0; j < vc->pointCount; ++j)
+		{
+			b2VelocityConstraintPoint* vcp = vc->points + j;
+
+			b2PositionSolverManifold psm;
+			psm.Initialize(pc, xfA, xfB, j);
+
+			// The anchors are added back as the bodies move.
+			vcp->separation = psm.separation - b2Dot(vcp->rB - vcp->rA, vc->normal);
+		}
+	}
+}
+
+void b2ContactSolver::SolveSoftConstraints(const b2Position* origins, const b2Rot* rotations, bool useBias)
+{
+	float32 inv_h = m_step.inv_dt;
+
+	for (int32 i = 0; i < m_count; ++i)
+	{
+		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
+
+		int32 indexA = vc->indexA;
+		int32 indexB = vc->indexB;
+		float32 mA = vc->invMassA;
+		float32 iA = vc->invIA;
+		float32 mB = vc->invMassB;
+		float32 iB = vc->invIB;
+		int32 pointCount = vc->pointCount;
+
+		b2Vec2 vA = m_velocities[indexA].v;
+		float32 wA = m_velocities[indexA].w;
+		b2Vec2 vB = m_velocities[indexB].v;
+		float32 wB = m_velocities[indexB].w;
+
+		b2Vec2 dcA = m_positions[indexA].c - origins[indexA].c;
+		b2Vec2 dcB = m_positions[indexB].c - origins[indexB].c;
+		b2Rot qA = rotations[indexA];
+		b2Rot qB = rotations[indexB];
+
+		b2Vec2 normal = vc->normal;
+		b2Vec2 tangent = b2Cross(normal, 1.0f);
+		float32 friction = vc->friction;
+
+		const b2Softness& softness = mA == 0.0f || mB == 0.0f ? m_staticSoftness : m_softness;
+
+		// The normal impulse of a point is
+		// lambda = -normalMass * massScale * (vn + bias) - impulseScale * normalImpulse
+		float32 bias[b2_maxManifoldPoints];
+		float32 massScale[b2_maxManifoldPoints];
+		float32 impulseScale[b2_maxManifoldPoints];
+		for (int32 j = 0; j < pointCount; ++j)
+		{
+			b2VelocityConstraintPoint* vcp = vc->points + j;
+
+			// Current separation
+			b2Vec2 d = dcB - dcA + b2Mul(qB, vcp->rB) - b2Mul(qA, vcp->rA);
+			float32 s = b2Dot(d, normal) + vcp->separation;
+
+			bias[j] = 0.0f;
+			massScale[j] = 1.0f;
+			impulseScale[j] = 0.0f;
+			if (s > 0.0f)
+			{
+				// Speculative: allow the gap to close in this sub-step.
+				bias[j] = s * inv_h;
+			}
+			else if (useBias)
+			{
+				bias[j] = b2Max(softness.biasRate * s, -b2_contactPushVelocity);
+				massScale[j] = softness.massScale;
+				impulseScale[j] = softness.impulseScale;
+			}
+		}
+
+		// Non-penetration first, so friction sees the new normal impulses. The
+		// anchors stay fixed for the whole step.
+		if (pointCount == 1)
+		{
+			b2VelocityConstraintPoint* vcp = vc->points + 0;
+
+			b2Vec2 dv = vB + b2Cross(wB, vcp->rB) - vA - b2Cross(wA, vcp->rA);
+			float32 vn = b2Dot(dv, normal);
+
+			float32 lambda = -vcp->normalMass * massScale[0] * (vn + bias[0]) - impulseScale[0] * vcp->normalImpulse;
+
+			float32 newImpulse = b2Max(vcp->normalImpulse + lambda, 0.0f);
+			lambda = newImpulse - vcp->normalImpulse;
+			vcp->normalImpulse = newImpulse;
+
+			b2Vec2 P = lambda * normal;
+			vA -= mA * P;
+			wA -= iA * b2Cross(vcp->rA, P);
+
+			vB += mB * P;
+			wB += iB * b2Cross(vcp->rB, P);
+		}
+		else
+		{
+			// Block solver, see SolveVelocityConstraints. Row i of the soft
+			// impulse is K * (x - a) = -massScale * (vn + bias) - impulseScale * K * a,
+			// so with b' = massScale * (vn + bias) - (1 - impulseScale) * K * a
+			// the mini LCP is again w = K * x + b', w >= 0, x >= 0, w_i * x_i = 0.
+			b2VelocityConstraintPoint* cp1 = vc->points + 0;
+			b2VelocityConstraintPoint* cp2 = vc->points + 1;
+
+			b2Vec2 a(cp1->normalImpulse, cp2->normalImpulse);
+
+			b2Vec2 dv1 = vB + b2Cross(wB, cp1->rB) - vA - b2Cross(wA, cp1->rA);
+			b2Vec2 dv2 = vB + b2Cross(wB, cp2->rB) - vA - b2Cross(wA, cp2->rA);
+
+			b2Vec2 Ka = b2Mul(vc->K, a);
+			b2Vec2 b;
+			b.x = massScale[0] * (b2Dot(dv1, normal) + bias[0]) - (1.0f - impulseScale[0]) * Ka.x;
+			b.y = massScale[1] * (b2Dot(dv2, normal) + bias[1]) - (1.0f - impulseScale[1]) * Ka.y;
+
+			// Case 1: w = 0
+			b2Vec2 x = - b2Mul(vc->normalMass, b);
+			if (x.x < 0.0f || x.y < 0.0f)
+			{
+				// Case 2: w1 = 0 and x2 = 0
+				x.Set(- cp1->normalMass * b.x, 0.0f);
+				if (x.x < 0.0f || vc->K.ex.y * x.x + b.y < 0.0f)
+				{
+					// Case 3: w2 = 0 and x1 = 0
+					x.Set(0.0f, - cp2->normalMass * b.y);
+					if (x.y < 0.0f || vc->K.ey.x * x.y + b.x < 0.0f)
+					{
+						// Case 4: x = 0. If this fails there is no solution, so
+						// leave the impulses as they are.
+						x.SetZero();
+						if (b.x < 0.0f || b.y < 0.0f)
+						{
+							x = a;
+						}
+					}
+				}
+			}
+
+			b2Vec2 d = x - a;
+
+			b2Vec2 P1 = d.x * normal;
+			b2Vec2 P2 = d.y * normal;
+			vA -= mA * (P1 + P2);
+			wA -= iA * (b2Cross(cp1->rA, P1) + b2Cross(cp2->rA, P2));
+
+			vB += mB * (P1 + P2);
+			wB += iB * (b2Cross(cp1->rB, P1) + b2Cross(cp2->rB, P2));
+
+			cp1->normalImpulse = x.x;
+			cp2->normalImpulse = x.y;
+		}
+
+		for (int32 j = 0; j < pointCount; ++j)
+		{
+			b2VelocityConstraintPoint* vcp = vc->points + j;
+
+			b2Vec2 dv = vB + b2Cross(wB, vcp->rB) - vA - b2Cross(wA, vcp->rA);
+
+			float32 vt = b2Dot(dv, tangent);
+			float32 lambda = vcp->tangentMass * (-vt);
+
+			float32 maxFriction = friction * vcp->normalImpulse;
+			float32 newImpulse = b2Clamp(vcp->tangentImpulse + lambda, -maxFriction, maxFriction);
+			lambda = newImpulse - vcp->tangentImpulse;
+			vcp->tangentImpulse = newImpulse;
+
+			b2Vec2 P = lambda * tangent;
+			vA -= mA * P;
+			wA -= iA * b2Cross(vcp->rA, P);
+
+			vB += mB * P;
+			wB += iB * b2Cross(vcp->rB, P);
+		}
+
+		m_velocities[indexA].v = vA;
+		m_velocities[indexA].w = wA;
+		m_velocities[indexB].v = vB;
+		m_velocities[indexB].w = wB;
+	}
+}
+
+void b2ContactSolver::ApplyRestitution()
+{
+	for (int32 i = 0; i < m_count; ++i)
+	{
+		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
+		if (vc->restitution == 0.0f)
+		{
+			continue;
+		}
+
+		int32 indexA = vc->indexA;
+		int32 indexB = vc->indexB;
+		float32 mA = vc->invMassA;
+		float32 iA = vc->invIA;
+		float32 mB = vc->invMassB;
+		float32 iB = vc->invIB;
+		int32 pointCount = vc->pointCount;
+
+		b2Vec2 vA = m_velocities[indexA].v;
+		float32 wA = m_velocities[indexA].w;
+		b2Vec2 vB = m_velocities[indexB].v;
+		float32 wB = m_velocities[indexB].w;
+
+		b2Vec2 normal = vc->normal;
+
+		for (int32 j = 0; j < pointCount; ++j)
+		{
+			b2VelocityConstraintPoint* vcp = vc->points + j;
+
+			// Points that did not touch do not bounce.
+			if (vcp->restitutionBias == 0.0f || vcp->normalImpulse == 0.0f)
+			{
+				continue;
+			}
+
+			b2Vec2 dv = vB + b2Cross(wB, vcp->rB) - vA - b2Cross(wA, vcp->rA);
+			float32 vn = b2Dot(dv, normal);
+
+			float32 lambda = -vcp->normalMass * (vn - vcp->restitutionBias);
+
+			float32 newImpulse = b2Max(vcp->normalImpulse + lambda, 0.0f);
+			lambda = newImpulse - vcp->normalImpulse;
+			vcp->normalImpulse = newImpulse;
+
+			b2Vec2 P = lambda * normal;
+			vA -= mA * P;
+			wA -= iA * b2Cross(vcp->rA, P);
+
+			vB += mB * P;
+			wB += iB * b2Cross(vcp->rB, P);
+		}
+
+		m_velocities[indexA].v = vA;
+		m_velocities[indexA].w = wA;
+		m_velocities[indexB].v = vB;
+		m_velocities[indexB].w = wB;
+	}
+}
@@ -37,6 +37,8 @@ struct b2VelocityConstraintPoint
 	float32 normalMass;
 	float32 tangentMass;
 	float32 velocityBias;
+	float32 restitutionBias;	// restitution velocity that ApplyRestitution enforces
+	float32 separation;	// soft step: separation at the start of the step, less the anchor offset
 };
 
 struct b2ContactVelocityConstraint
@@ -65,6 +67,19 @@ struct b2ContactSolverDef
 	b2StackAllocator* allocator;
 };
 
+/// The coefficients of a soft constraint for a given sub-step.
+struct b2Softness
+{
+	/// Make a soft constraint that behaves like a damped spring with the
+	/// given frequency in Hertz and damping ratio. A frequency of zero makes
+	/// a rigid constraint without position bias.
+	void Set(float32 hertz, float32 dampingRatio, float32 h);
+
+	float32 biasRate;
+	float32 massScale;
+	float32 impulseScale;
+};
+
 class b2ContactSolver
 {
 public:
@@ -80,6 +95,31 @@ public:
 	bool SolvePositionConstraints();
 	bool SolveTOIPositionConstraints(int32 toiIndexA, int32 toiIndexB);
 
+	/// Soft step solver. Call after InitializeVelocityConstraints. The step
+	/// of the definition must be the sub-step.
+	void PrepareSoftConstraints(float32 contactHertz, float32 dampingRatio);
+
+	/// Solve the contacts once with the current separation, which is estimated
+	/// from the body motion since PrepareSoftConstraints. The origins are the
+	/// body positions at that time and the rotations the body rotations since.
+	/// Without bias the overlap is not pushed out, which relaxes the velocities.
+	void SolveSoftConstraints(const b2Position* origins, const b2Rot* rotations, bool useBias);
+
+	/// Apply restitution once to the points that were reached. The soft step
+	/// solver calls this after the sub-steps. The sequential solver calls it
+	/// after the iterations for speculative points, which cannot bounce before
+	/// they are reached.
+	void ApplyRestitution();
+
+	/// Shock propagation. Make the body with the lower level immovable in
+	/// each contact between different levels, for the remaining velocity
+	/// iterations. The position constraints keep both masses. The levels are
+	/// indexed by island body.
+	void FreezeLowerBodies(const int32* levels);
+
+	/// Get the stack memory needed to solve the given number of contacts.
+	static int32 GetStackSize(int32 contactCount);
+
 	b2TimeStep m_step;
 	b2Position* m_positions;
 	b2Velocity* m_velocities;
@@ -88,6 +128,15 @@ public:
 	b2ContactVelocityConstraint* m_velocityConstraints;
 	b2Contact** m_contacts;
 	int m_count;
+
+	// Soft contact coefficients. Contacts with a static or kinematic body
+	// are twice as stiff.
+	b2Softness m_softness;
+	b2Softness m_staticSoftness;
+
+private:
+	// Compute the effective masses from the anchors and the body masses.
+	void InitializeMasses(b2ContactVelocityConstraint* vc);
 };
 
 #endif
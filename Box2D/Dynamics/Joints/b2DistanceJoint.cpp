@@ -18,6 +18,7 @@
 
 #include <Box2D/Dynamics/Joints/b2DistanceJoint.h>
 #include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Dynamics/b2Recorder.h>
 #include <Box2D/Dynamics/b2TimeStep.h>
 
 // 1-D constrained system
@@ -258,3 +259,39 @@ void b2DistanceJoint::Dump()
 	b2Log("  jd.dampingRatio = %.15lef;\n", m_dampingRatio);
 	b2Log("  joints[%d] = m_world->CreateJoint(&jd);\n", m_index);
 }
+
+void b2DistanceJoint::SetLength(float32 length)
+{
+	b2RecordScope scope(m_bodyA->GetWorld());
+
+	m_length = length;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetLength, this, length);
+	}
+}
+
+void b2DistanceJoint::SetFrequency(float32 hz)
+{
+	b2RecordScope scope(m_bodyA->GetWorld());
+
+	m_frequencyHz = hz;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetFrequency, this, hz);
+	}
+}
+
+void b2DistanceJoint::SetDampingRatio(float32 ratio)
+{
+	b2RecordScope scope(m_bodyA->GetWorld());
+
+	m_dampingRatio = ratio;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetDampingRatio, this, ratio);
+	}
+}
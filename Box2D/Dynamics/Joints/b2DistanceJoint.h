@@ -104,6 +104,7 @@ public:
 protected:
 
 	friend class b2Joint;
+	friend class b2JointTreeSolver;
 	b2DistanceJoint(const b2DistanceJointDef* data);
 
 	void InitVelocityConstraints(const b2SolverData& data);
@@ -136,31 +137,16 @@ protected:
 	float32 m_mass;
 };
 
-inline void b2DistanceJoint::SetLength(float32 length)
-{
-	m_length = length;
-}
-
 inline float32 b2DistanceJoint::GetLength() const
 {
 	return m_length;
 }
 
-inline void b2DistanceJoint::SetFrequency(float32 hz)
-{
-	m_frequencyHz = hz;
-}
-
 inline float32 b2DistanceJoint::GetFrequency() const
 {
 	return m_frequencyHz;
 }
 
-inline void b2DistanceJoint::SetDampingRatio(float32 ratio)
-{
-	m_dampingRatio = ratio;
-}
-
 inline float32 b2DistanceJoint::GetDampingRatio() const
 {
 	return m_dampingRatio;
@@ -18,6 +18,7 @@
 
 #include <Box2D/Dynamics/Joints/b2FrictionJoint.h>
 #include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Dynamics/b2Recorder.h>
 #include <Box2D/Dynamics/b2TimeStep.h>
 
 // Point-to-point constraint
@@ -214,8 +215,15 @@ float32 b2FrictionJoint::GetReactionTorque(float32 inv_dt) const
 
 void b2FrictionJoint::SetMaxForce(float32 force)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	b2Assert(b2IsValid(force) && force >= 0.0f);
 	m_maxForce = force;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetMaxForce, this, force);
+	}
 }
 
 float32 b2FrictionJoint::GetMaxForce() const
@@ -225,8 +233,15 @@ float32 b2FrictionJoint::GetMaxForce() const
 
 void b2FrictionJoint::SetMaxTorque(float32 torque)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	b2Assert(b2IsValid(torque) && torque >= 0.0f);
 	m_maxTorque = torque;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetMaxTorque, this, torque);
+	}
 }
 
 float32 b2FrictionJoint::GetMaxTorque() const
@@ -20,7 +20,9 @@
 #include <Box2D/Dynamics/Joints/b2RevoluteJoint.h>
 #include <Box2D/Dynamics/Joints/b2PrismaticJoint.h>
 #include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Dynamics/b2Recorder.h>
 #include <Box2D/Dynamics/b2TimeStep.h>
+#include <Box2D/Common/b2BlockAllocator.h>
 
 // Gear Joint:
 // C0 = (coordinate1 + ratio * coordinate2)_initial
@@ -393,10 +395,27 @@ float32 b2GearJoint::GetReactionTorque(float32 inv_dt) const
 	return inv_dt * L;
 }
 
+void b2GearJoint::Relocate(const b2BlockRelocator& relocator)
+{
+	b2Joint::Relocate(relocator);
+
+	m_joint1 = relocator.Relocate(m_joint1);
+	m_joint2 = relocator.Relocate(m_joint2);
+	m_bodyC = relocator.Relocate(m_bodyC);
+	m_bodyD = relocator.Relocate(m_bodyD);
+}
+
 void b2GearJoint::SetRatio(float32 ratio)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	b2Assert(b2IsValid(ratio));
 	m_ratio = ratio;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetRatio, this, ratio);
+	}
 }
 
 float32 b2GearJoint::GetRatio() const
@@ -84,6 +84,8 @@ protected:
 	void SolveVelocityConstraints(const b2SolverData& data);
 	bool SolvePositionConstraints(const b2SolverData& data);
 
+	void Relocate(const b2BlockRelocator& relocator);
+
 	b2Joint* m_joint1;
 	b2Joint* m_joint2;
 
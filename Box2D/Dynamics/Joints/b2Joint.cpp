@@ -41,70 +41,70 @@ b2Joint* b2Joint::Create(const b2JointDef* def, b2BlockAllocator* allocator)
 	{
 	case e_distanceJoint:
 		{
-			void* mem = allocator->Allocate(sizeof(b2DistanceJoint));
+			void* mem = allocator->Allocate(sizeof(b2DistanceJoint), e_allocTagJoint);
 			joint = new (mem) b2DistanceJoint((b2DistanceJointDef*)def);
 		}
 		break;
 
 	case e_mouseJoint:
 		{
-			void* mem = allocator->Allocate(sizeof(b2MouseJoint));
+			void* mem = allocator->Allocate(sizeof(b2MouseJoint), e_allocTagJoint);
 			joint = new (mem) b2MouseJoint((b2MouseJointDef*)def);
 		}
 		break;
 
 	case e_prismaticJoint:
 		{
-			void* mem = allocator->Allocate(sizeof(b2PrismaticJoint));
+			void* mem = allocator->Allocate(sizeof(b2PrismaticJoint), e_allocTagJoint);
 			joint = new (mem) b2PrismaticJoint((b2PrismaticJointDef*)def);
 		}
 		break;
 
 	case e_revoluteJoint:
 		{
-			void* mem = allocator->Allocate(sizeof(b2RevoluteJoint));
+			void* mem = allocator->Allocate(sizeof(b2RevoluteJoint), e_allocTagJoint);
 			joint = new (mem) b2RevoluteJoint((b2RevoluteJointDef*)def);
 		}
 		break;
 
 	case e_pulleyJoint:
 		{
-			void* mem = allocator->Allocate(sizeof(b2PulleyJoint));
+			void* mem = allocator->Allocate(sizeof(b2PulleyJoint), e_allocTagJoint);
 			joint = new (mem) b2PulleyJoint((b2PulleyJointDef*)def);
 		}
 		break;
 
 	case e_gearJoint:
 		{
-			void* mem = allocator->Allocate(sizeof(b2GearJoint));
+			void* mem = allocator->Allocate(sizeof(b2GearJoint), e_allocTagJoint);
 			joint = new (mem) b2GearJoint((b2GearJointDef*)def);
 		}
 		break;
 
 	case e_wheelJoint:
 		{
-			void* mem = allocator->Allocate(sizeof(b2WheelJoint));
+			void* mem = allocator->Allocate(sizeof(b2WheelJoint), e_allocTagJoint);
 			joint = new (mem) b2WheelJoint((b2WheelJointDef*)def);
 		}
 		break;
 
 	case e_weldJoint:
 		{
-			void* mem = allocator->Allocate(sizeof(b2WeldJoint));
+			void* mem = allocator->Allocate(sizeof(b2WeldJoint), e_allocTagJoint);
 			joint = new (mem) b2WeldJoint((b2WeldJointDef*)def);
 		}
 		break;
 
 	case e_frictionJoint:
 		{
-			void* mem = allocator->Allocate(sizeof(b2FrictionJoint));
+			void* mem = allocator->Allocate(sizeof(b2FrictionJoint), e_allocTagJoint);
 			joint = new (mem) b2FrictionJoint((b2FrictionJointDef*)def);
 		}
 		break;
 
 	case e_ropeJoint:
 		{
-			void* mem = allocator->Allocate(sizeof(b2RopeJoint));
+			void* mem = allocator->Allocate(sizeof(b2RopeJoint), e_allocTagJoint);
 			joint = new (mem) b2RopeJoint((b2RopeJointDef*)def);
 		}
 		break;
@@ -123,43 +123,43 @@ void b2Joint::Destroy(b2Joint* joint, b2BlockAllocator* allocator)
 	switch (joint->m_type)
 	{
 	case e_distanceJoint:
-		allocator->Free(joint, sizeof(b2DistanceJoint));
+		allocator->Free(joint, sizeof(b2DistanceJoint), e_allocTagJoint);
 		break;
 
 	case e_mouseJoint:
-		allocator->Free(joint, sizeof(b2MouseJoint));
+		allocator->Free(joint, sizeof(b2MouseJoint), e_allocTagJoint);
 		break;
 
 	case e_prismaticJoint:
-		allocator->Free(joint, sizeof(b2PrismaticJoint));
+		allocator->Free(joint, sizeof(b2PrismaticJoint), e_allocTagJoint);
 		break;
 
 	case e_revoluteJoint:
-		allocator->Free(joint, sizeof(b2RevoluteJoint));
+		allocator->Free(joint, sizeof(b2RevoluteJoint), e_allocTagJoint);
 		break;
 
 	case e_pulleyJoint:
-		allocator->Free(joint, sizeof(b2PulleyJoint));
+		allocator->Free(joint, sizeof(b2PulleyJoint), e_allocTagJoint);
 		break;
 
 	case e_gearJoint:
-		allocator->Free(joint, sizeof(b2GearJoint));
+		allocator->Free(joint, sizeof(b2GearJoint), e_allocTagJoint);
 		break;
 
 	case e_wheelJoint:
-		allocator->Free(joint, sizeof(b2WheelJoint));
+		allocator->Free(joint, sizeof(b2WheelJoint), e_allocTagJoint);
 		break;
 
 	case e_weldJoint:
-		allocator->Free(joint, sizeof(b2WeldJoint));
+		allocator->Free(joint, sizeof(b2WeldJoint), e_allocTagJoint);
 		break;
 
 	case e_frictionJoint:
-		allocator->Free(joint, sizeof(b2FrictionJoint));
+		allocator->Free(joint, sizeof(b2FrictionJoint), e_allocTagJoint);
 		break;
 
 	case e_ropeJoint:
-		allocator->Free(joint, sizeof(b2RopeJoint));
+		allocator->Free(joint, sizeof(b2RopeJoint), e_allocTagJoint);
 		break;
 
 	default:
@@ -168,6 +168,107 @@ void b2Joint::Destroy(b2Joint* joint, b2BlockAllocator* allocator)
 	}
 }
 
+template <typename T>
+bool b2Joint::SolveRun(b2JointSolverPass pass, b2Joint** joints, int32 count, const b2SolverData& data)
+{
+	// The qualified calls bind statically, so the loop has no virtual dispatch.
+	bool okay = true;
+	switch (pass)
+	{
+	case e_initVelocityPass:
+		for (int32 i = 0; i < count; ++i)
+		{
+			static_cast<T*>(joints[i])->T::InitVelocityConstraints(data);
+		}
+		break;
+
+	case e_solveVelocityPass:
+		for (int32 i = 0; i < count; ++i)
+		{
+			static_cast<T*>(joints[i])->T::SolveVelocityConstraints(data);
+		}
+		break;
+
+	case e_solvePositionPass:
+		for (int32 i = 0; i < count; ++i)
+		{
+			bool jointOkay = static_cast<T*>(joints[i])->T::SolvePositionConstraints(data);
+			okay = okay && jointOkay;
+		}
+		break;
+	}
+
+	return okay;
+}
+
+bool b2Joint::SolveBatch(b2JointSolverPass pass, b2Joint** joints, int32 count, const b2SolverData& data)
+{
+	bool okay = true;
+	int32 i = 0;
+	while (i < count)
+	{
+		b2JointType type = joints[i]->m_type;
+		int32 n = 1;
+		while (i + n < count && joints[i + n]->m_type == type)
+		{
+			++n;
+		}
+
+		bool runOkay = true;
+		switch (type)
+		{
+		case e_distanceJoint:
+			runOkay = SolveRun<b2DistanceJoint>(pass, joints + i, n, data);
+			break;
+
+		case e_mouseJoint:
+			runOkay = SolveRun<b2MouseJoint>(pass, joints + i, n, data);
+			break;
+
+		case e_prismaticJoint:
+			runOkay = SolveRun<b2PrismaticJoint>(pass, joints + i, n, data);
+			break;
+
+		case e_revoluteJoint:
+			runOkay = SolveRun<b2RevoluteJoint>(pass, joints + i, n, data);
+			break;
+
+		case e_pulleyJoint:
+			runOkay = SolveRun<b2PulleyJoint>(pass, joints + i, n, data);
+			break;
+
+		case e_gearJoint:
+			runOkay = SolveRun<b2GearJoint>(pass, joints + i, n, data);
+			break;
+
+		case e_wheelJoint:
+			runOkay = SolveRun<b2WheelJoint>(pass, joints + i, n, data);
+			break;
+
+		case e_weldJoint:
+			runOkay = SolveRun<b2WeldJoint>(pass, joints + i, n, data);
+			break;
+
+		case e_frictionJoint:
+			runOkay = SolveRun<b2FrictionJoint>(pass, joints + i, n, data);
+			break;
+
+		case e_ropeJoint:
+			runOkay = SolveRun<b2RopeJoint>(pass, joints + i, n, data);
+			break;
+
+		default:
+			b2Assert(false);
+			break;
+		}
+
+		okay = okay && runOkay;
+		i += n;
+	}
+
+	return okay;
+}
+
 b2Joint::b2Joint(const b2JointDef* def)
 {
 	b2Assert(def->bodyA != def->bodyB);
@@ -180,6 +281,7 @@ b2Joint::b2Joint(const b2JointDef* def)
 	m_index = 0;
 	m_collideConnected = def->collideConnected;
 	m_islandFlag = false;
+	m_id = 0;
 	m_userData = def->userData;
 
 	m_edgeA.joint = NULL;
@@ -193,6 +295,25 @@ b2Joint::b2Joint(const b2JointDef* def)
 	m_edgeB.next = NULL;
 }
 
+void b2Joint::Relocate(const b2BlockRelocator& relocator)
+{
+	m_prev = relocator.Relocate(m_prev);
+	m_next = relocator.Relocate(m_next);
+
+	m_edgeA.joint = this;
+	m_edgeA.other = relocator.Relocate(m_edgeA.other);
+	m_edgeA.prev = relocator.Relocate(m_edgeA.prev);
+	m_edgeA.next = relocator.Relocate(m_edgeA.next);
+
+	m_edgeB.joint = this;
+	m_edgeB.other = relocator.Relocate(m_edgeB.other);
+	m_edgeB.prev = relocator.Relocate(m_edgeB.prev);
+	m_edgeB.next = relocator.Relocate(m_edgeB.next);
+
+	m_bodyA = relocator.Relocate(m_bodyA);
+	m_bodyB = relocator.Relocate(m_bodyB);
+}
+
 bool b2Joint::IsActive() const
 {
 	return m_bodyA->IsActive() && m_bodyB->IsActive();
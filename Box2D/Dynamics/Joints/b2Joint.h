@@ -25,6 +25,7 @@ class b2Body;
 class b2Joint;
 struct b2SolverData;
 class b2BlockAllocator;
+class b2BlockRelocator;
 
 enum b2JointType
 {
@@ -41,6 +42,16 @@ enum b2JointType
 	e_ropeJoint
 };
 
+const int32 b2_jointTypeCount = e_ropeJoint + 1;
+
+/// The joint solver passes run by b2Joint::SolveBatch. This is an internal enum.
+enum b2JointSolverPass
+{
+	e_initVelocityPass,
+	e_solveVelocityPass,
+	e_solvePositionPass
+};
+
 enum b2LimitState
 {
 	e_inactiveLimit,
@@ -142,6 +153,9 @@ public:
 	/// the flag is only checked when fixture AABBs begin to overlap.
 	bool GetCollideConnected() const;
 
+	/// Get the identifier of this joint. Joints are numbered in creation order.
+	uint32 GetId() const;
+
 	/// Dump this joint to the log file.
 	virtual void Dump() { b2Log("// Dump is not supported for this joint type.\n"); }
 
@@ -150,6 +164,7 @@ protected:
 	friend class b2Body;
 	friend class b2Island;
 	friend class b2GearJoint;
+	friend class b2JointTreeSolver;
 
 	static b2Joint* Create(const b2JointDef* def, b2BlockAllocator* allocator);
 	static void Destroy(b2Joint* joint, b2BlockAllocator* allocator);
@@ -163,6 +178,17 @@ protected:
 	// This returns true if the position errors are within tolerance.
 	virtual bool SolvePositionConstraints(const b2SolverData& data) = 0;
 
+	// Run one solver pass over joints grouped by type. Each run of joints of
+	// the same type is solved with direct calls instead of virtual dispatch.
+	// The position pass returns true if all joints are within tolerance.
+	static bool SolveBatch(b2JointSolverPass pass, b2Joint** joints, int32 count, const b2SolverData& data);
+
+	template <typename T>
+	static bool SolveRun(b2JointSolverPass pass, b2Joint** joints, int32 count, const b2SolverData& data);
+
+	// Translate the body and joint pointers of a joint copied by b2World::Clone.
+	virtual void Relocate(const b2BlockRelocator& relocator);
+
 	b2JointType m_type;
 	b2Joint* m_prev;
 	b2Joint* m_next;
@@ -176,6 +202,8 @@ protected:
 	bool m_islandFlag;
 	bool m_collideConnected;
 
+	uint32 m_id;
+
 	void* m_userData;
 };
 
@@ -204,6 +232,11 @@ inline const b2Joint* b2Joint::GetNext() const
 	return m_next;
 }
 
+inline uint32 b2Joint::GetId() const
+{
+	return m_id;
+}
+
 inline void* b2Joint::GetUserData() const
 {
 	return m_userData;
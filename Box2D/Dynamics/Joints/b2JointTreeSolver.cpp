@@ -0,0 +1,579 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <Box2D/Dynamics/Joints/b2JointTreeSolver.h>
+#include <Box2D/Dynamics/Joints/b2DistanceJoint.h>
+#include <Box2D/Dynamics/Joints/b2RevoluteJoint.h>
+#include <Box2D/Dynamics/Joints/b2WeldJoint.h>
+#include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Common/b2StackAllocator.h>
+
+// The matrix H = [M J^T; J 0] of a tree of bodies and joints has the sparsity of
+// the tree. Eliminating the nodes from the leaves up fills in nothing, so
+// H = L D L^T is found and solved with one pass over the nodes in each direction.
+// Joints have a zero diagonal block, so every joint must have a body below it.
+// The roots are joints for that reason, and a joint to the ground is always a
+// root because it has only one body.
+
+static b2Mat33 b2Transpose(const b2Mat33& A)
+{
+	return b2Mat33(b2Vec3(A.ex.x, A.ey.x, A.ez.x), b2Vec3(A.ex.y, A.ey.y, A.ez.y), b2Vec3(A.ex.z, A.ey.z, A.ez.z));
+}
+
+// A * B
+static b2Mat33 b2MulMM(const b2Mat33& A, const b2Mat33& B)
+{
+	return b2Mat33(b2Mul(A, B.ex), b2Mul(A, B.ey), b2Mul(A, B.ez));
+}
+
+// A^T * v
+static b2Vec3 b2MulTV(const b2Mat33& A, const b2Vec3& v)
+{
+	return b2Vec3(b2Dot(A.ex, v), b2Dot(A.ey, v), b2Dot(A.ez, v));
+}
+
+// The rows of a point constraint on the anchor r of a body.
+static void b2SetPointRows(b2Mat33* J, const b2Vec2& r, float32 sign)
+{
+	J->ex.Set(sign, 0.0f, 0.0f);
+	J->ey.Set(0.0f, sign, 0.0f);
+	J->ez.Set(-sign * r.y, sign * r.x, 0.0f);
+}
+
+static b2Vec2 b2ClampLength(const b2Vec2& v, float32 maxLength)
+{
+	float32 length = v.Length();
+	if (length > maxLength)
+	{
+		return (maxLength / length) * v;
+	}
+	return v;
+}
+
+static int32 b2FindSet(int32* sets, int32 i)
+{
+	while (sets[i] != i)
+	{
+		sets[i] = sets[sets[i]];
+		i = sets[i];
+	}
+	return i;
+}
+
+b2JointTreeSolver::b2JointTreeSolver(b2JointTreeSolverDef* def)
+{
+	m_step = def->step;
+	m_allocator = def->allocator;
+	m_positions = def->positions;
+	m_velocities = def->velocities;
+
+	b2Joint** joints = def->joints;
+	int32 count = def->count;
+	int32 bodyCount = def->bodyCount;
+
+	m_rows = (b2JointTreeRow*)m_allocator->Allocate(count * sizeof(b2JointTreeRow));
+	m_nodes = (b2JointTreeNode*)m_allocator->Allocate((count + bodyCount) * sizeof(b2JointTreeNode));
+	m_rowCount = 0;
+	m_nodeCount = 0;
+
+	// Grow a forest with union-find. All static and kinematic bodies are one
+	// ground set, so a second joint to the ground closes a loop.
+	int32 iterativeCount = 0;
+	int32 ground = bodyCount;
+	int32* sets = (int32*)m_allocator->Allocate((bodyCount + 1) * sizeof(int32));
+	for (int32 i = 0; i <= bodyCount; ++i)
+	{
+		sets[i] = i;
+	}
+
+	for (int32 i = 0; i < count; ++i)
+	{
+		b2Joint* joint = joints[i];
+		int32 dimension = GetDimension(joint);
+
+		b2Body* bodyA = joint->m_bodyA;
+		b2Body* bodyB = joint->m_bodyB;
+		int32 setA = bodyA->m_type == b2_dynamicBody ? bodyA->m_islandIndex : ground;
+		int32 setB = bodyB->m_type == b2_dynamicBody ? bodyB->m_islandIndex : ground;
+		int32 rootA = b2FindSet(sets, setA);
+		int32 rootB = b2FindSet(sets, setB);
+
+		if (dimension == 0 || rootA == rootB)
+		{
+			joints[iterativeCount++] = joint;
+			continue;
+		}
+
+		sets[rootA] = rootB;
+
+		b2JointTreeRow* row = m_rows + m_rowCount++;
+		row->joint = joint;
+		row->indexA = bodyA->m_islandIndex;
+		row->indexB = bodyB->m_islandIndex;
+		row->nodeA = setA != ground ? setA : -1;
+		row->nodeB = setB != ground ? setB : -1;
+		row->node = -1;
+		row->dimension = dimension;
+	}
+
+	m_allocator->Free(sets);
+
+	for (int32 i = 0; i < m_rowCount; ++i)
+	{
+		joints[iterativeCount + i] = m_rows[i].joint;
+	}
+
+	if (m_rowCount == 0)
+	{
+		return;
+	}
+
+	// Adjacency of the dynamic bodies. The body ends of a row temporarily hold
+	// island indices.
+	int32* bodyNodes = (int32*)m_allocator->Allocate(bodyCount * sizeof(int32));
+	int32* adjacencyStarts = (int32*)m_allocator->Allocate((bodyCount + 1) * sizeof(int32));
+	int32* adjacency = (int32*)m_allocator->Allocate(2 * m_rowCount * sizeof(int32));
+	int32* stack = (int32*)m_allocator->Allocate((bodyCount + m_rowCount) * sizeof(int32));
+
+	for (int32 i = 0; i <= bodyCount; ++i)
+	{
+		adjacencyStarts[i] = 0;
+	}
+
+	for (int32 i = 0; i < bodyCount; ++i)
+	{
+		bodyNodes[i] = -1;
+	}
+
+	for (int32 i = 0; i < m_rowCount; ++i)
+	{
+		const b2JointTreeRow* row = m_rows + i;
+		if (row->nodeA != -1)
+		{
+			++adjacencyStarts[row->nodeA + 1];
+		}
+		if (row->nodeB != -1)
+		{
+			++adjacencyStarts[row->nodeB + 1];
+		}
+	}
+
+	for (int32 i = 0; i < bodyCount; ++i)
+	{
+		adjacencyStarts[i + 1] += adjacencyStarts[i];
+	}
+
+	for (int32 i = 0; i < m_rowCount; ++i)
+	{
+		const b2JointTreeRow* row = m_rows + i;
+		if (row->nodeA != -1)
+		{
+			adjacency[adjacencyStarts[row->nodeA]++] = i;
+		}
+		if (row->nodeB != -1)
+		{
+			adjacency[adjacencyStarts[row->nodeB]++] = i;
+		}
+	}
+
+	// The fill pass moved each start to the next one.
+	for (int32 i = bodyCount; i > 0; --i)
+	{
+		adjacencyStarts[i] = adjacencyStarts[i - 1];
+	}
+	adjacencyStarts[0] = 0;
+
+	// Number the nodes in discovery order from the roots, so every node comes
+	// after its parent. Joints to the ground go first so they become roots.
+	for (int32 pass = 0; pass < 2; ++pass)
+	{
+		for (int32 i = 0; i < m_rowCount; ++i)
+		{
+			b2JointTreeRow* root = m_rows + i;
+			bool toGround = root->nodeA == -1 || root->nodeB == -1;
+			if (root->node != -1 || toGround != (pass == 0))
+			{
+				continue;
+			}
+
+			root->node = m_nodeCount;
+			b2JointTreeNode* rootNode = m_nodes + m_nodeCount++;
+			rootNode->parent = -1;
+			rootNode->index = i;
+			rootNode->mass = 0.0f;
+			rootNode->I = 0.0f;
+			rootNode->isBody = false;
+
+			int32 stackCount = 0;
+			stack[stackCount++] = -(i + 1);
+			while (stackCount > 0)
+			{
+				int32 item = stack[--stackCount];
+				if (item < 0)
+				{
+					const b2JointTreeRow* row = m_rows + (-item - 1);
+					for (int32 j = 0; j < 2; ++j)
+					{
+						int32 body = j == 0 ? row->nodeA : row->nodeB;
+						if (body == -1 || bodyNodes[body] != -1)
+						{
+							continue;
+						}
+
+						b2Body* b = j == 0 ? row->joint->m_bodyA : row->joint->m_bodyB;
+						bodyNodes[body] = m_nodeCount;
+						b2JointTreeNode* node = m_nodes + m_nodeCount++;
+						node->parent = row->node;
+						node->index = body;
+						node->mass = b->m_mass;
+						node->I = b->m_invI > 0.0f ? b->m_I : 0.0f;
+						node->isBody = true;
+						stack[stackCount++] = body;
+					}
+				}
+				else
+				{
+					for (int32 j = adjacencyStarts[item]; j < adjacencyStarts[item + 1]; ++j)
+					{
+						b2JointTreeRow* row = m_rows + adjacency[j];
+						if (row->node != -1)
+						{
+							continue;
+						}
+
+						row->node = m_nodeCount;
+						b2JointTreeNode* node = m_nodes + m_nodeCount++;
+						node->parent = bodyNodes[item];
+						node->index = adjacency[j];
+						node->mass = 0.0f;
+						node->I = 0.0f;
+						node->isBody = false;
+						stack[stackCount++] = -(adjacency[j] + 1);
+					}
+				}
+			}
+		}
+	}
+
+	// Reverse the numbering so children come before their parents.
+	int32 last = m_nodeCount - 1;
+	for (int32 i = 0; i < m_nodeCount / 2; ++i)
+	{
+		b2Swap(m_nodes[i], m_nodes[last - i]);
+	}
+
+	for (int32 i = 0; i < m_nodeCount; ++i)
+	{
+		b2JointTreeNode* node = m_nodes + i;
+		if (node->parent != -1)
+		{
+			node->parent = last - node->parent;
+		}
+	}
+
+	for (int32 i = 0; i < m_rowCount; ++i)
+	{
+		b2JointTreeRow* row = m_rows + i;
+		row->node = last - row->node;
+		row->nodeA = row->nodeA != -1 ? last - bodyNodes[row->nodeA] : -1;
+		row->nodeB = row->nodeB != -1 ? last - bodyNodes[row->nodeB] : -1;
+	}
+
+	m_allocator->Free(stack);
+	m_allocator->Free(adjacency);
+	m_allocator->Free(adjacencyStarts);
+	m_allocator->Free(bodyNodes);
+}
+
+b2JointTreeSolver::~b2JointTreeSolver()
+{
+	m_allocator->Free(m_nodes);
+	m_allocator->Free(m_rows);
+}
+
+int32 b2JointTreeSolver::GetDimension(const b2Joint* joint)
+{
+	switch (joint->m_type)
+	{
+	case e_revoluteJoint:
+		{
+			const b2RevoluteJoint* revolute = (const b2RevoluteJoint*)joint;
+			return revolute->m_enableLimit || revolute->m_enableMotor ? 0 : 2;
+		}
+
+	case e_distanceJoint:
+		return ((const b2DistanceJoint*)joint)->m_frequencyHz > 0.0f ? 0 : 1;
+
+	case e_weldJoint:
+		{
+			// A weld to a body that can not rotate has a zero pivot on its
+			// angular row, but the row still couples to the other body, so
+			// the factorization can not treat it as unused. Such welds are
+			// left to the iterative solver.
+			const b2Body* bodyA = joint->m_bodyA;
+			const b2Body* bodyB = joint->m_bodyB;
+			bool fixedA = bodyA->m_type == b2_dynamicBody && bodyA->m_invI == 0.0f;
+			bool fixedB = bodyB->m_type == b2_dynamicBody && bodyB->m_invI == 0.0f;
+			if (((const b2WeldJoint*)joint)->m_frequencyHz > 0.0f || fixedA || fixedB)
+			{
+				return 0;
+			}
+			return 3;
+		}
+
+	default:
+		return 0;
+	}
+}
+
+b2Mat33 b2JointTreeSolver::GetParentBlock(int32 index) const
+{
+	const b2JointTreeNode* node = m_nodes + index;
+	if (node->isBody)
+	{
+		// The parent is a joint and the block is in J^T.
+		const b2JointTreeRow* row = m_rows + m_nodes[node->parent].index;
+		return b2Transpose(row->nodeA == index ? row->JA : row->JB);
+	}
+
+	const b2JointTreeRow* row = m_rows + node->index;
+	return row->nodeA == node->parent ? row->JA : row->JB;
+}
+
+void b2JointTreeSolver::Factor()
+{
+	// Put the diagonal blocks of H in invD until each node is eliminated. A
+	// fixed rotation body is reduced to its translation by a unit placeholder.
+	for (int32 i = 0; i < m_nodeCount; ++i)
+	{
+		b2JointTreeNode* node = m_nodes + i;
+		node->invD.SetZero();
+		if (node->isBody)
+		{
+			node->invD.ex.x = node->mass;
+			node->invD.ey.y = node->mass;
+			node->invD.ez.z = node->I > 0.0f ? node->I : 1.0f;
+		}
+	}
+
+	for (int32 i = 0; i < m_nodeCount; ++i)
+	{
+		b2JointTreeNode* node = m_nodes + i;
+		b2Mat33 D = node->invD;
+
+		if (node->isBody == false)
+		{
+			// Unused and degenerate rows are zero throughout. Give them a unit
+			// placeholder so they solve to zero.
+			if (D.ex.x == 0.0f)
+			{
+				D.ex.x = 1.0f;
+			}
+			if (D.ey.y == 0.0f)
+			{
+				D.ey.y = 1.0f;
+			}
+			if (D.ez.z == 0.0f)
+			{
+				D.ez.z = 1.0f;
+			}
+		}
+
+		D.GetSymInverse33(&node->invD);
+
+		if (node->parent != -1)
+		{
+			b2Mat33 H = GetParentBlock(i);
+			node->L = b2MulMM(node->invD, H);
+
+			// D_parent -= H^T * D^-1 * H
+			b2JointTreeNode* parent = m_nodes + node->parent;
+			b2Mat33 S = b2MulMM(b2Transpose(H), node->L);
+			parent->invD.ex -= S.ex;
+			parent->invD.ey -= S.ey;
+			parent->invD.ez -= S.ez;
+		}
+	}
+}
+
+void b2JointTreeSolver::Solve()
+{
+	for (int32 i = 0; i < m_nodeCount; ++i)
+	{
+		const b2JointTreeNode* node = m_nodes + i;
+		if (node->parent != -1)
+		{
+			b2JointTreeNode* parent = m_nodes + node->parent;
+			parent->x -= b2MulTV(node->L, node->x);
+		}
+	}
+
+	for (int32 i = m_nodeCount - 1; i >= 0; --i)
+	{
+		b2JointTreeNode* node = m_nodes + i;
+		node->x = b2Mul(node->invD, node->x);
+		if (node->parent != -1)
+		{
+			node->x -= b2Mul(node->L, m_nodes[node->parent].x);
+		}
+	}
+}
+
+void b2JointTreeSolver::InitializeVelocityConstraints()
+{
+	for (int32 i = 0; i < m_rowCount; ++i)
+	{
+		b2JointTreeRow* row = m_rows + i;
+		b2Joint* joint = row->joint;
+
+		switch (joint->m_type)
+		{
+		case e_revoluteJoint:
+			{
+				const b2RevoluteJoint* revolute = (const b2RevoluteJoint*)joint;
+				b2SetPointRows(&row->JA, revolute->m_rA, -1.0f);
+				b2SetPointRows(&row->JB, revolute->m_rB, 1.0f);
+				b2Vec2 C = m_positions[row->indexB].c + revolute->m_rB - m_positions[row->indexA].c - revolute->m_rA;
+				C = b2ClampLength(C, b2_maxLinearCorrection);
+				row->bias.Set(C.x, C.y, 0.0f);
+			}
+			break;
+
+		case e_distanceJoint:
+			{
+				const b2DistanceJoint* distance = (const b2DistanceJoint*)joint;
+				b2Vec2 u = distance->m_u;
+				b2Vec2 d = m_positions[row->indexB].c + distance->m_rB - m_positions[row->indexA].c - distance->m_rA;
+				float32 C = b2Clamp(d.Length() - distance->m_length, -b2_maxLinearCorrection, b2_maxLinearCorrection);
+				row->bias.Set(C, 0.0f, 0.0f);
+				row->JA.SetZero();
+				row->JB.SetZero();
+				row->JA.ex.x = -u.x;
+				row->JA.ey.x = -u.y;
+				row->JA.ez.x = -b2Cross(distance->m_rA, u);
+				row->JB.ex.x = u.x;
+				row->JB.ey.x = u.y;
+				row->JB.ez.x = b2Cross(distance->m_rB, u);
+			}
+			break;
+
+		case e_weldJoint:
+			{
+				const b2WeldJoint* weld = (const b2WeldJoint*)joint;
+				b2SetPointRows(&row->JA, weld->m_rA, -1.0f);
+				b2SetPointRows(&row->JB, weld->m_rB, 1.0f);
+				row->JA.ez.z = -1.0f;
+				row->JB.ez.z = 1.0f;
+				b2Vec2 C1 = m_positions[row->indexB].c + weld->m_rB - m_positions[row->indexA].c - weld->m_rA;
+				C1 = b2ClampLength(C1, b2_maxLinearCorrection);
+				float32 C2 = m_positions[row->indexB].a - m_positions[row->indexA].a - weld->m_referenceAngle;
+				C2 = b2Clamp(C2, -b2_maxAngularCorrection, b2_maxAngularCorrection);
+				row->bias.Set(C1.x, C1.y, C2);
+			}
+			break;
+
+		default:
+			b2Assert(false);
+			break;
+		}
+
+		// Feed a fraction of the position error back into the velocity
+		// solve. The exact solve keeps no velocity drift of its own, so this
+		// is what pulls the anchors together between position passes.
+		row->bias *= b2_baumgarte * m_step.inv_dt;
+
+		// A fixed rotation body does not turn.
+		if (row->nodeA != -1 && m_nodes[row->nodeA].I == 0.0f)
+		{
+			row->JA.ez.SetZero();
+		}
+		if (row->nodeB != -1 && m_nodes[row->nodeB].I == 0.0f)
+		{
+			row->JB.ez.SetZero();
+		}
+	}
+
+	Factor();
+}
+
+void b2JointTreeSolver::SolveVelocityConstraints()
+{
+	for (int32 i = 0; i < m_nodeCount; ++i)
+	{
+		m_nodes[i].x.SetZero();
+	}
+
+	// Cdot = J * v + bias
+	for (int32 i = 0; i < m_rowCount; ++i)
+	{
+		const b2JointTreeRow* row = m_rows + i;
+		const b2Velocity& velA = m_velocities[row->indexA];
+		const b2Velocity& velB = m_velocities[row->indexB];
+		b2Vec3 vA(velA.v.x, velA.v.y, velA.w);
+		b2Vec3 vB(velB.v.x, velB.v.y, velB.w);
+		b2Vec3 Cdot = b2Mul(row->JA, vA) + b2Mul(row->JB, vB);
+		m_nodes[row->node].x = -(Cdot + row->bias);
+	}
+
+	Solve();
+
+	for (int32 i = 0; i < m_nodeCount; ++i)
+	{
+		const b2JointTreeNode* node = m_nodes + i;
+		if (node->isBody)
+		{
+			b2Velocity& vel = m_velocities[node->index];
+			vel.v.x += node->x.x;
+			vel.v.y += node->x.y;
+			vel.w += node->x.z;
+		}
+	}
+
+	// The joint solution is the negated impulse.
+	for (int32 i = 0; i < m_rowCount; ++i)
+	{
+		const b2JointTreeRow* row = m_rows + i;
+		b2Vec3 impulse = -m_nodes[row->node].x;
+		b2Joint* joint = row->joint;
+
+		switch (joint->m_type)
+		{
+		case e_revoluteJoint:
+			{
+				b2RevoluteJoint* revolute = (b2RevoluteJoint*)joint;
+				revolute->m_impulse.x += impulse.x;
+				revolute->m_impulse.y += impulse.y;
+			}
+			break;
+
+		case e_distanceJoint:
+			((b2DistanceJoint*)joint)->m_impulse += impulse.x;
+			break;
+
+		case e_weldJoint:
+			{
+				b2WeldJoint* weld = (b2WeldJoint*)joint;
+				weld->m_impulse += impulse;
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+}
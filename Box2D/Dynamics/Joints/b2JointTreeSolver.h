@@ -0,0 +1,114 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_JOINT_TREE_SOLVER_H
+#define B2_JOINT_TREE_SOLVER_H
+
+#include <Box2D/Common/b2Math.h>
+#include <Box2D/Dynamics/b2TimeStep.h>
+
+class b2Joint;
+class b2StackAllocator;
+
+/// A rigid joint solved by the tree solver. The Jacobian blocks map the
+/// velocity (v.x, v.y, w) of each body to the constraint rows. Unused rows
+/// are zero. The bias feeds the position error back into the velocities.
+struct b2JointTreeRow
+{
+	b2Joint* joint;
+	b2Mat33 JA;
+	b2Mat33 JB;
+	b2Vec3 bias;
+	int32 indexA;
+	int32 indexB;
+	int32 nodeA;		// tree node of body A, or -1 if it is not dynamic
+	int32 nodeB;
+	int32 node;
+	int32 dimension;
+};
+
+/// A node of the factored tree. Nodes are bodies and joints, with each body
+/// adjacent to the joints that touch it.
+struct b2JointTreeNode
+{
+	b2Mat33 invD;		// inverse of the diagonal block of the factor
+	b2Mat33 L;			// off-diagonal block of the factor, towards the parent
+	b2Vec3 x;
+	int32 parent;
+	int32 index;		// island index of a body, or row index of a joint
+	float32 mass;		// body mass and rotational inertia, zero for a joint
+	float32 I;
+	bool isBody;
+};
+
+struct b2JointTreeSolverDef
+{
+	b2TimeStep step;
+	b2Joint** joints;
+	int32 count;
+	int32 bodyCount;
+	b2Position* positions;
+	b2Velocity* velocities;
+	b2StackAllocator* allocator;
+};
+
+/// Solves rigid revolute, distance and weld joints that form trees exactly,
+/// in time linear in the number of joints. It factors the sparse matrix
+/// [M J^T; J 0] in tree order (Baraff, "Linear-Time Dynamics using Lagrange
+/// Multipliers", 1996), so long chains do not stretch however few iterations
+/// are used. Joints that close a loop, through other joints or through the
+/// ground, joints with limits, motors or springs, and welds to a body that can
+/// not rotate are left to the iterative solver. Static and kinematic bodies are not part of the trees.
+/// Only velocities are solved this way. The position pass stays per joint,
+/// since a linearized solve of a whole tree overshoots when the tree whips.
+class b2JointTreeSolver
+{
+public:
+	/// This moves the joints it solves to the end of the joint array. The
+	/// other joints keep their order at the front.
+	b2JointTreeSolver(b2JointTreeSolverDef* def);
+	~b2JointTreeSolver();
+
+	/// Factor the velocity constraints. Call after the joints initialized
+	/// their velocity constraints.
+	void InitializeVelocityConstraints();
+
+	/// Remove the relative velocity of all tree joints in one pass and add
+	/// the impulses to the joints.
+	void SolveVelocityConstraints();
+
+	b2TimeStep m_step;
+	b2Position* m_positions;
+	b2Velocity* m_velocities;
+	b2StackAllocator* m_allocator;
+	b2JointTreeRow* m_rows;
+	b2JointTreeNode* m_nodes;
+	int32 m_rowCount;
+	int32 m_nodeCount;
+
+private:
+	static int32 GetDimension(const b2Joint* joint);
+
+	// The off-diagonal block of [M J^T; J 0] between a node and its parent.
+	b2Mat33 GetParentBlock(int32 index) const;
+
+	void Factor();
+	void Solve();
+};
+
+#endif
@@ -18,6 +18,7 @@
 
 #include <Box2D/Dynamics/Joints/b2MouseJoint.h>
 #include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Dynamics/b2Recorder.h>
 #include <Box2D/Dynamics/b2TimeStep.h>
 
 // p = attached point, m = mouse point
@@ -51,11 +52,18 @@ b2MouseJoint::b2MouseJoint(const b2MouseJointDef* def)
 
 void b2MouseJoint::SetTarget(const b2Vec2& target)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	if (m_bodyB->IsAwake() == false)
 	{
 		m_bodyB->SetAwake(true);
 	}
 	m_targetA = target;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetTarget, this, target.x, target.y);
+	}
 }
 
 const b2Vec2& b2MouseJoint::GetTarget() const
@@ -65,7 +73,14 @@ const b2Vec2& b2MouseJoint::GetTarget() const
 
 void b2MouseJoint::SetMaxForce(float32 force)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	m_maxForce = force;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetMaxForce, this, force);
+	}
 }
 
 float32 b2MouseJoint::GetMaxForce() const
@@ -75,7 +90,14 @@ float32 b2MouseJoint::GetMaxForce() const
 
 void b2MouseJoint::SetFrequency(float32 hz)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	m_frequencyHz = hz;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetFrequency, this, hz);
+	}
 }
 
 float32 b2MouseJoint::GetFrequency() const
@@ -85,7 +107,14 @@ float32 b2MouseJoint::GetFrequency() const
 
 void b2MouseJoint::SetDampingRatio(float32 ratio)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	m_dampingRatio = ratio;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetDampingRatio, this, ratio);
+	}
 }
 
 float32 b2MouseJoint::GetDampingRatio() const
@@ -18,6 +18,7 @@
 
 #include <Box2D/Dynamics/Joints/b2PrismaticJoint.h>
 #include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Dynamics/b2Recorder.h>
 #include <Box2D/Dynamics/b2TimeStep.h>
 
 // Linear constraint (point-to-line)
@@ -551,6 +552,8 @@ bool b2PrismaticJoint::IsLimitEnabled() const
 
 void b2PrismaticJoint::EnableLimit(bool flag)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	if (flag != m_enableLimit)
 	{
 		m_bodyA->SetAwake(true);
@@ -558,6 +561,11 @@ void b2PrismaticJoint::EnableLimit(bool flag)
 		m_enableLimit = flag;
 		m_impulse.z = 0.0f;
 	}
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointEnableLimit, this, flag ? 1.0f : 0.0f);
+	}
 }
 
 float32 b2PrismaticJoint::GetLowerLimit() const
@@ -572,6 +580,8 @@ float32 b2PrismaticJoint::GetUpperLimit() const
 
 void b2PrismaticJoint::SetLimits(float32 lower, float32 upper)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	b2Assert(lower <= upper);
 	if (lower != m_lowerTranslation || upper != m_upperTranslation)
 	{
@@ -581,6 +591,11 @@ void b2PrismaticJoint::SetLimits(float32 lower, float32 upper)
 		m_upperTranslation = upper;
 		m_impulse.z = 0.0f;
 	}
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetLimits, this, lower, upper);
+	}
 }
 
 bool b2PrismaticJoint::IsMotorEnabled() const
@@ -590,23 +605,44 @@ bool b2PrismaticJoint::IsMotorEnabled() const
 
 void b2PrismaticJoint::EnableMotor(bool flag)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	m_bodyA->SetAwake(true);
 	m_bodyB->SetAwake(true);
 	m_enableMotor = flag;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointEnableMotor, this, flag ? 1.0f : 0.0f);
+	}
 }
 
 void b2PrismaticJoint::SetMotorSpeed(float32 speed)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	m_bodyA->SetAwake(true);
 	m_bodyB->SetAwake(true);
 	m_motorSpeed = speed;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetMotorSpeed, this, speed);
+	}
 }
 
 void b2PrismaticJoint::SetMaxMotorForce(float32 force)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	m_bodyA->SetAwake(true);
 	m_bodyB->SetAwake(true);
 	m_maxMotorForce = force;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetMaxMotorForce, this, force);
+	}
 }
 
 float32 b2PrismaticJoint::GetMotorForce(float32 inv_dt) const
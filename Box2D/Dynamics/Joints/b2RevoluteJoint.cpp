@@ -18,6 +18,7 @@
 
 #include <Box2D/Dynamics/Joints/b2RevoluteJoint.h>
 #include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Dynamics/b2Recorder.h>
 #include <Box2D/Dynamics/b2TimeStep.h>
 
 // Point-to-point constraint
@@ -418,9 +419,16 @@ bool b2RevoluteJoint::IsMotorEnabled() const
 
 void b2RevoluteJoint::EnableMotor(bool flag)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	m_bodyA->SetAwake(true);
 	m_bodyB->SetAwake(true);
 	m_enableMotor = flag;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointEnableMotor, this, flag ? 1.0f : 0.0f);
+	}
 }
 
 float32 b2RevoluteJoint::GetMotorTorque(float32 inv_dt) const
@@ -430,16 +438,30 @@ float32 b2RevoluteJoint::GetMotorTorque(float32 inv_dt) const
 
 void b2RevoluteJoint::SetMotorSpeed(float32 speed)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	m_bodyA->SetAwake(true);
 	m_bodyB->SetAwake(true);
 	m_motorSpeed = speed;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetMotorSpeed, this, speed);
+	}
 }
 
 void b2RevoluteJoint::SetMaxMotorTorque(float32 torque)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	m_bodyA->SetAwake(true);
 	m_bodyB->SetAwake(true);
 	m_maxMotorTorque = torque;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetMaxMotorTorque, this, torque);
+	}
 }
 
 bool b2RevoluteJoint::IsLimitEnabled() const
@@ -449,6 +471,8 @@ bool b2RevoluteJoint::IsLimitEnabled() const
 
 void b2RevoluteJoint::EnableLimit(bool flag)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	if (flag != m_enableLimit)
 	{
 		m_bodyA->SetAwake(true);
@@ -456,6 +480,11 @@ void b2RevoluteJoint::EnableLimit(bool flag)
 		m_enableLimit = flag;
 		m_impulse.z = 0.0f;
 	}
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointEnableLimit, this, flag ? 1.0f : 0.0f);
+	}
 }
 
 float32 b2RevoluteJoint::GetLowerLimit() const
@@ -470,6 +499,8 @@ float32 b2RevoluteJoint::GetUpperLimit() const
 
 void b2RevoluteJoint::SetLimits(float32 lower, float32 upper)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	b2Assert(lower <= upper);
 
 	if (lower != m_lowerAngle || upper != m_upperAngle)
@@ -480,6 +511,11 @@ void b2RevoluteJoint::SetLimits(float32 lower, float32 upper)
 		m_lowerAngle = lower;
 		m_upperAngle = upper;
 	}
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetLimits, this, lower, upper);
+	}
 }
 
 void b2RevoluteJoint::Dump()
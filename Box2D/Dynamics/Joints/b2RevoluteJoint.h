@@ -158,6 +158,7 @@ protected:
 
 	friend class b2Joint;
 	friend class b2GearJoint;
+	friend class b2JointTreeSolver;
 
 	b2RevoluteJoint(const b2RevoluteJointDef* def);
 
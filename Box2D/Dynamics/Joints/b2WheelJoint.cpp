@@ -18,6 +18,7 @@
 
 #include <Box2D/Dynamics/Joints/b2WheelJoint.h>
 #include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Dynamics/b2Recorder.h>
 #include <Box2D/Dynamics/b2TimeStep.h>
 
 // Linear constraint (point-to-line)
@@ -374,23 +375,44 @@ bool b2WheelJoint::IsMotorEnabled() const
 
 void b2WheelJoint::EnableMotor(bool flag)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	m_bodyA->SetAwake(true);
 	m_bodyB->SetAwake(true);
 	m_enableMotor = flag;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointEnableMotor, this, flag ? 1.0f : 0.0f);
+	}
 }
 
 void b2WheelJoint::SetMotorSpeed(float32 speed)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	m_bodyA->SetAwake(true);
 	m_bodyB->SetAwake(true);
 	m_motorSpeed = speed;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetMotorSpeed, this, speed);
+	}
 }
 
 void b2WheelJoint::SetMaxMotorTorque(float32 torque)
 {
+	b2RecordScope scope(m_bodyA->GetWorld());
+
 	m_bodyA->SetAwake(true);
 	m_bodyB->SetAwake(true);
 	m_maxMotorTorque = torque;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetMaxMotorTorque, this, torque);
+	}
 }
 
 float32 b2WheelJoint::GetMotorTorque(float32 inv_dt) const
@@ -417,3 +439,27 @@ void b2WheelJoint::Dump()
 	b2Log("  jd.dampingRatio = %.15lef;\n", m_dampingRatio);
 	b2Log("  joints[%d] = m_world->CreateJoint(&jd);\n", m_index);
 }
+
+void b2WheelJoint::SetSpringFrequencyHz(float32 hz)
+{
+	b2RecordScope scope(m_bodyA->GetWorld());
+
+	m_frequencyHz = hz;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetSpringFrequency, this, hz);
+	}
+}
+
+void b2WheelJoint::SetSpringDampingRatio(float32 ratio)
+{
+	b2RecordScope scope(m_bodyA->GetWorld());
+
+	m_dampingRatio = ratio;
+
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordJoint(e_recordJointSetSpringDampingRatio, this, ratio);
+	}
+}
@@ -190,21 +190,11 @@ inline float32 b2WheelJoint::GetMaxMotorTorque() const
 	return m_maxMotorTorque;
 }
 
-inline void b2WheelJoint::SetSpringFrequencyHz(float32 hz)
-{
-	m_frequencyHz = hz;
-}
-
 inline float32 b2WheelJoint::GetSpringFrequencyHz() const
 {
 	return m_frequencyHz;
 }
 
-inline void b2WheelJoint::SetSpringDampingRatio(float32 ratio)
-{
-	m_dampingRatio = ratio;
-}
-
 inline float32 b2WheelJoint::GetSpringDampingRatio() const
 {
 	return m_dampingRatio;
@@ -19,6 +19,7 @@
 #include "Box2D/Dynamics/b2Body.h"
 #include <Box2D/Dynamics/b2Fixture.h>
 #include <Box2D/Dynamics/b2World.h>
+#include <Box2D/Dynamics/b2Recorder.h>
 #include <Box2D/Dynamics/Contacts/b2Contact.h>
 #include <Box2D/Dynamics/Joints/b2Joint.h>
 
@@ -83,6 +84,9 @@ b2Body::b2Body(const b2BodyDef* bd, b2World* world)
 
 	m_sleepTime = 0.0f;
 
+	m_id = 0;
+	m_changeEpoch = world->GetEpoch();
+
 	m_type = bd->type;
 
 	if (m_type == b2_dynamicBody)
@@ -112,6 +116,12 @@ b2Body::~b2Body()
 
 void b2Body::SetType(b2BodyType type)
 {
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordSetType, this, (float32)type);
+	}
+
 	b2Assert(m_world->IsLocked() == false);
 	if (m_world->IsLocked() == true)
 	{
@@ -133,10 +143,11 @@ void b2Body::SetType(b2BodyType type)
 		m_angularVelocity = 0.0f;
 		m_sweep.a0 = m_sweep.a;
 		m_sweep.c0 = m_sweep.c;
-		SynchronizeFixtures();
+		SynchronizeFixtures(0.0f);
 	}
 
 	SetAwake(true);
+	SetChanged();
 
 	m_force.SetZero();
 	m_torque = 0.0f;
@@ -156,9 +167,15 @@ b2Fixture* b2Body::CreateFixture(const b2FixtureDef* def)
 		return NULL;
 	}
 
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordCreateFixture(this, def);
+	}
+
 	b2BlockAllocator* allocator = &m_world->m_blockAllocator;
 
-	void* memory = allocator->Allocate(sizeof(b2Fixture));
+	void* memory = allocator->Allocate(sizeof(b2Fixture), e_allocTagFixture);
 	b2Fixture* fixture = new (memory) b2Fixture;
 	fixture->Create(allocator, this, def);
 
@@ -196,6 +213,15 @@ b2Fixture* b2Body::CreateFixture(const b2Shape* shape, float32 density)
 	return CreateFixture(&def);
 }
 
+b2Fixture* b2Body::CreateFixture(b2SharedShape* shape, float32 density)
+{
+	b2FixtureDef def;
+	def.sharedShape = shape;
+	def.density = density;
+
+	return CreateFixture(&def);
+}
+
 void b2Body::DestroyFixture(b2Fixture* fixture)
 {
 	b2Assert(m_world->IsLocked() == false);
@@ -206,6 +232,12 @@ void b2Body::DestroyFixture(b2Fixture* fixture)
 
 	b2Assert(fixture->m_body == this);
 
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordFixture(e_recordDestroyFixture, fixture, NULL, 0);
+	}
+
 	// Remove the fixture from this body's singly linked list.
 	b2Assert(m_fixtureCount > 0);
 	b2Fixture** node = &m_fixtureList;
@@ -255,7 +287,7 @@ void b2Body::DestroyFixture(b2Fixture* fixture)
 	fixture->m_body = NULL;
 	fixture->m_next = NULL;
 	fixture->~b2Fixture();
-	allocator->Free(fixture, sizeof(b2Fixture));
+	allocator->Free(fixture, sizeof(b2Fixture), e_allocTagFixture);
 
 	--m_fixtureCount;
 
@@ -265,6 +297,12 @@ void b2Body::DestroyFixture(b2Fixture* fixture)
 
 void b2Body::ResetMassData()
 {
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordResetMassData, this);
+	}
+
 	// Compute mass data from shapes. Each shape has its own density.
 	m_mass = 0.0f;
 	m_invMass = 0.0f;
@@ -337,6 +375,13 @@ void b2Body::ResetMassData()
 
 void b2Body::SetMassData(const b2MassData* massData)
 {
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		float32 values[4] = { massData->mass, massData->center.x, massData->center.y, massData->I };
+		scope.GetRecorder()->RecordBody(e_recordSetMassData, this, values, 4);
+	}
+
 	b2Assert(m_world->IsLocked() == false);
 	if (m_world->IsLocked() == true)
 	{
@@ -401,6 +446,13 @@ bool b2Body::ShouldCollide(const b2Body* other) const
 
 void b2Body::SetTransform(const b2Vec2& position, float32 angle)
 {
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		float32 values[3] = { position.x, position.y, angle };
+		scope.GetRecorder()->RecordBody(e_recordSetTransform, this, values, 3);
+	}
+
 	b2Assert(m_world->IsLocked() == false);
 	if (m_world->IsLocked() == true)
 	{
@@ -416,30 +468,58 @@ void b2Body::SetTransform(const b2Vec2& position, float32 angle)
 	m_sweep.c0 = m_sweep.c;
 	m_sweep.a0 = angle;
 
+	SetChanged();
+
 	b2BroadPhase* broadPhase = &m_world->m_contactManager.m_broadPhase;
 	for (b2Fixture* f = m_fixtureList; f; f = f->m_next)
 	{
-		f->Synchronize(broadPhase, m_xf, m_xf);
+		f->Synchronize(broadPhase, m_xf, m_xf, b2Vec2_zero);
 	}
 
 	m_world->m_contactManager.FindNewContacts();
 }
 
-void b2Body::SynchronizeFixtures()
+void b2Body::SetChanged()
 {
+	m_changeEpoch = m_world->m_epoch;
+}
+
+void b2Body::SynchronizeFixtures(float32 speculativeTime)
+{
+	SetChanged();
+
 	b2Transform xf1;
 	xf1.q.Set(m_sweep.a0);
 	xf1.p = m_sweep.c0 - b2Mul(xf1.q, m_sweep.localCenter);
 
+	// With speculative contacts only bullets need the sweep, for time of
+	// impact. All bodies cover where they could get in the next step, with
+	// the margin of the speculative points, so the contacts exist in time.
+	b2Vec2 reach = b2Vec2_zero;
+	if (speculativeTime > 0.0f)
+	{
+		reach = (2.0f * speculativeTime) * m_linearVelocity;
+		if (IsBullet() == false)
+		{
+			xf1 = m_xf;
+		}
+	}
+
 	b2BroadPhase* broadPhase = &m_world->m_contactManager.m_broadPhase;
 	for (b2Fixture* f = m_fixtureList; f; f = f->m_next)
 	{
-		f->Synchronize(broadPhase, xf1, m_xf);
+		f->Synchronize(broadPhase, xf1, m_xf, reach);
 	}
 }
 
 void b2Body::SetActive(bool flag)
 {
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordSetActive, this, flag ? 1.0f : 0.0f);
+	}
+
 	b2Assert(m_world->IsLocked() == false);
 
 	if (flag == IsActive())
@@ -483,6 +563,280 @@ void b2Body::SetActive(bool flag)
 	}
 }
 
+void b2Body::SetLinearVelocity(const b2Vec2& v)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		float32 values[2] = { v.x, v.y };
+		scope.GetRecorder()->RecordBody(e_recordSetLinearVelocity, this, values, 2);
+	}
+
+	if (m_type == b2_staticBody)
+	{
+		return;
+	}
+
+	if (b2Dot(v,v) > 0.0f)
+	{
+		SetAwake(true);
+	}
+
+	m_linearVelocity = v;
+	SetChanged();
+}
+
+void b2Body::SetAngularVelocity(float32 w)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordSetAngularVelocity, this, w);
+	}
+
+	if (m_type == b2_staticBody)
+	{
+		return;
+	}
+
+	if (w * w > 0.0f)
+	{
+		SetAwake(true);
+	}
+
+	m_angularVelocity = w;
+	SetChanged();
+}
+
+void b2Body::SetLinearDamping(float32 linearDamping)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordSetLinearDamping, this, linearDamping);
+	}
+
+	m_linearDamping = linearDamping;
+}
+
+void b2Body::SetAngularDamping(float32 angularDamping)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordSetAngularDamping, this, angularDamping);
+	}
+
+	m_angularDamping = angularDamping;
+}
+
+void b2Body::SetGravityScale(float32 scale)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordSetGravityScale, this, scale);
+	}
+
+	m_gravityScale = scale;
+}
+
+void b2Body::SetBullet(bool flag)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordSetBullet, this, flag ? 1.0f : 0.0f);
+	}
+
+	if (flag)
+	{
+		m_flags |= e_bulletFlag;
+	}
+	else
+	{
+		m_flags &= ~e_bulletFlag;
+	}
+}
+
+void b2Body::SetAwake(bool flag)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordSetAwake, this, flag ? 1.0f : 0.0f);
+	}
+
+	if (flag)
+	{
+		if ((m_flags & e_awakeFlag) == 0)
+		{
+			m_flags |= e_awakeFlag;
+			m_sleepTime = 0.0f;
+			SetChanged();
+		}
+	}
+	else
+	{
+		m_flags &= ~e_awakeFlag;
+		m_sleepTime = 0.0f;
+		m_linearVelocity.SetZero();
+		m_angularVelocity = 0.0f;
+		m_force.SetZero();
+		m_torque = 0.0f;
+		SetChanged();
+	}
+}
+
+void b2Body::SetFixedRotation(bool flag)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordSetFixedRotation, this, flag ? 1.0f : 0.0f);
+	}
+
+	if (flag)
+	{
+		m_flags |= e_fixedRotationFlag;
+	}
+	else
+	{
+		m_flags &= ~e_fixedRotationFlag;
+	}
+
+	ResetMassData();
+}
+
+void b2Body::SetSleepingAllowed(bool flag)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordSetSleepingAllowed, this, flag ? 1.0f : 0.0f);
+	}
+
+	if (flag)
+	{
+		m_flags |= e_autoSleepFlag;
+	}
+	else
+	{
+		m_flags &= ~e_autoSleepFlag;
+		SetAwake(true);
+	}
+}
+
+void b2Body::ApplyForce(const b2Vec2& force, const b2Vec2& point)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		float32 values[4] = { force.x, force.y, point.x, point.y };
+		scope.GetRecorder()->RecordBody(e_recordApplyForce, this, values, 4);
+	}
+
+	if (m_type != b2_dynamicBody)
+	{
+		return;
+	}
+
+	if (IsAwake() == false)
+	{
+		SetAwake(true);
+	}
+
+	m_force += force;
+	m_torque += b2Cross(point - m_sweep.c, force);
+}
+
+void b2Body::ApplyForceToCenter(const b2Vec2& force)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		float32 values[2] = { force.x, force.y };
+		scope.GetRecorder()->RecordBody(e_recordApplyForceToCenter, this, values, 2);
+	}
+
+	if (m_type != b2_dynamicBody)
+	{
+		return;
+	}
+
+	if (IsAwake() == false)
+	{
+		SetAwake(true);
+	}
+
+	m_force += force;
+}
+
+void b2Body::ApplyTorque(float32 torque)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordApplyTorque, this, torque);
+	}
+
+	if (m_type != b2_dynamicBody)
+	{
+		return;
+	}
+
+	if (IsAwake() == false)
+	{
+		SetAwake(true);
+	}
+
+	m_torque += torque;
+}
+
+void b2Body::ApplyLinearImpulse(const b2Vec2& impulse, const b2Vec2& point)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		float32 values[4] = { impulse.x, impulse.y, point.x, point.y };
+		scope.GetRecorder()->RecordBody(e_recordApplyLinearImpulse, this, values, 4);
+	}
+
+	if (m_type != b2_dynamicBody)
+	{
+		return;
+	}
+
+	if (IsAwake() == false)
+	{
+		SetAwake(true);
+	}
+	m_linearVelocity += m_invMass * impulse;
+	m_angularVelocity += m_invI * b2Cross(point - m_sweep.c, impulse);
+	SetChanged();
+}
+
+void b2Body::ApplyAngularImpulse(float32 impulse)
+{
+	b2RecordScope scope(m_world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordApplyAngularImpulse, this, impulse);
+	}
+
+	if (m_type != b2_dynamicBody)
+	{
+		return;
+	}
+
+	if (IsAwake() == false)
+	{
+		SetAwake(true);
+	}
+	m_angularVelocity += m_invI * impulse;
+	SetChanged();
+}
+
 void b2Body::Dump()
 {
 	int32 bodyIndex = m_islandIndex;
@@ -24,6 +24,7 @@
 #include <memory>
 
 class b2Fixture;
+class b2SharedShape;
 class b2Joint;
 class b2Contact;
 class b2Controller;
@@ -144,6 +145,12 @@ public:
 	/// @warning This function is locked during callbacks.
 	b2Fixture* CreateFixture(const b2Shape* shape, float32 density);
 
+	/// Creates a fixture that references a shared shape instead of cloning it.
+	/// @param shape the shared shape, retained by the fixture.
+	/// @param density the shape density (set to zero for static bodies).
+	/// @warning This function is locked during callbacks.
+	b2Fixture* CreateFixture(b2SharedShape* shape, float32 density);
+
 	/// Destroy a fixture. This removes the fixture from the broad-phase and
 	/// destroys all contacts associated with this fixture. This will
 	/// automatically adjust the mass of the body if the body is dynamic and the
@@ -375,6 +382,17 @@ public:
 	b2World* GetWorld();
 	const b2World* GetWorld() const;
 
+	/// Get the identifier of this body. Bodies are numbered in creation order,
+	/// so worlds built the same way agree on their ids.
+	uint32 GetId() const;
+
+	/// Set the identifier used to match this body against snapshot records.
+	void SetId(uint32 id);
+
+	/// Get the world epoch in which the state of this body last changed.
+	/// @see b2World::GetEpoch
+	uint32 GetChangeEpoch() const;
+
 	/// Dump this body to a log file
 	void Dump();
 
@@ -384,7 +402,9 @@ private:
 	friend class b2Island;
 	friend class b2ContactManager;
 	friend class b2ContactSolver;
+	friend class b2JointTreeSolver;
 	friend class b2Contact;
+	friend class b2Snapshot;
 
 	friend class b2DistanceJoint;
 	friend class b2GearJoint;
@@ -412,9 +432,14 @@ private:
 	b2Body(const b2BodyDef* bd, b2World* world);
 	~b2Body();
 
-	void SynchronizeFixtures();
+	// A positive speculative time makes the proxies also cover the motion
+	// the body could make within it.
+	void SynchronizeFixtures(float32 speculativeTime);
 	void SynchronizeTransform();
 
+	// Stamp this body with the current world epoch.
+	void SetChanged();
+
 	// This is used to prevent connected bodies from colliding.
 	// It may lie, depending on the collideConnected flag.
 	bool ShouldCollide(const b2Body* other) const;
@@ -457,6 +482,9 @@ private:
 
 	float32 m_sleepTime;
 
+	uint32 m_id;
+	uint32 m_changeEpoch;
+
 	void* m_userData;
 };
 
@@ -490,41 +518,11 @@ inline const b2Vec2& b2Body::GetLocalCenter() const
 	return m_sweep.localCenter;
 }
 
-inline void b2Body::SetLinearVelocity(const b2Vec2& v)
-{
-	if (m_type == b2_staticBody)
-	{
-		return;
-	}
-
-	if (b2Dot(v,v) > 0.0f)
-	{
-		SetAwake(true);
-	}
-
-	m_linearVelocity = v;
-}
-
 inline b2Vec2 b2Body::GetLinearVelocity() const
 {
 	return m_linearVelocity;
 }
 
-inline void b2Body::SetAngularVelocity(float32 w)
-{
-	if (m_type == b2_staticBody)
-	{
-		return;
-	}
-
-	if (w * w > 0.0f)
-	{
-		SetAwake(true);
-	}
-
-	m_angularVelocity = w;
-}
-
 inline float32 b2Body::GetAngularVelocity() const
 {
 	return m_angularVelocity;
@@ -582,69 +580,21 @@ inline float32 b2Body::GetLinearDamping() const
 	return m_linearDamping;
 }
 
-inline void b2Body::SetLinearDamping(float32 linearDamping)
-{
-	m_linearDamping = linearDamping;
-}
-
 inline float32 b2Body::GetAngularDamping() const
 {
 	return m_angularDamping;
 }
 
-inline void b2Body::SetAngularDamping(float32 angularDamping)
-{
-	m_angularDamping = angularDamping;
-}
-
 inline float32 b2Body::GetGravityScale() const
 {
 	return m_gravityScale;
 }
 
-inline void b2Body::SetGravityScale(float32 scale)
-{
-	m_gravityScale = scale;
-}
-
-inline void b2Body::SetBullet(bool flag)
-{
-	if (flag)
-	{
-		m_flags |= e_bulletFlag;
-	}
-	else
-	{
-		m_flags &= ~e_bulletFlag;
-	}
-}
-
 inline bool b2Body::IsBullet() const
 {
 	return (m_flags & e_bulletFlag) == e_bulletFlag;
 }
 
-inline void b2Body::SetAwake(bool flag)
-{
-	if (flag)
-	{
-		if ((m_flags & e_awakeFlag) == 0)
-		{
-			m_flags |= e_awakeFlag;
-			m_sleepTime = 0.0f;
-		}
-	}
-	else
-	{
-		m_flags &= ~e_awakeFlag;
-		m_sleepTime = 0.0f;
-		m_linearVelocity.SetZero();
-		m_angularVelocity = 0.0f;
-		m_force.SetZero();
-		m_torque = 0.0f;
-	}
-}
-
 inline bool b2Body::IsAwake() const
 {
 	return (m_flags & e_awakeFlag) == e_awakeFlag;
@@ -655,38 +605,11 @@ inline bool b2Body::IsActive() const
 	return (m_flags & e_activeFlag) == e_activeFlag;
 }
 
-inline void b2Body::SetFixedRotation(bool flag)
-{
-	if (flag)
-	{
-		m_flags |= e_fixedRotationFlag;
-	}
-	else
-	{
-		m_flags &= ~e_fixedRotationFlag;
-	}
-
-	ResetMassData();
-}
-
 inline bool b2Body::IsFixedRotation() const
 {
 	return (m_flags & e_fixedRotationFlag) == e_fixedRotationFlag;
 }
 
-inline void b2Body::SetSleepingAllowed(bool flag)
-{
-	if (flag)
-	{
-		m_flags |= e_autoSleepFlag;
-	}
-	else
-	{
-		m_flags &= ~e_autoSleepFlag;
-		SetAwake(true);
-	}
-}
-
 inline bool b2Body::IsSleepingAllowed() const
 {
 	return (m_flags & e_autoSleepFlag) == e_autoSleepFlag;
@@ -742,81 +665,6 @@ inline void* b2Body::GetUserData() const
 	return m_userData;
 }
 
-inline void b2Body::ApplyForce(const b2Vec2& force, const b2Vec2& point)
-{
-	if (m_type != b2_dynamicBody)
-	{
-		return;
-	}
-
-	if (IsAwake() == false)
-	{
-		SetAwake(true);
-	}
-
-	m_force += force;
-	m_torque += b2Cross(point - m_sweep.c, force);
-}
-
-inline void b2Body::ApplyForceToCenter(const b2Vec2& force)
-{
-	if (m_type != b2_dynamicBody)
-	{
-		return;
-	}
-
-	if (IsAwake() == false)
-	{
-		SetAwake(true);
-	}
-
-	m_force += force;
-}
-
-inline void b2Body::ApplyTorque(float32 torque)
-{
-	if (m_type != b2_dynamicBody)
-	{
-		return;
-	}
-
-	if (IsAwake() == false)
-	{
-		SetAwake(true);
-	}
-
-	m_torque += torque;
-}
-
-inline void b2Body::ApplyLinearImpulse(const b2Vec2& impulse, const b2Vec2& point)
-{
-	if (m_type != b2_dynamicBody)
-	{
-		return;
-	}
-
-	if (IsAwake() == false)
-	{
-		SetAwake(true);
-	}
-	m_linearVelocity += m_invMass * impulse;
-	m_angularVelocity += m_invI * b2Cross(point - m_sweep.c, impulse);
-}
-
-inline void b2Body::ApplyAngularImpulse(float32 impulse)
-{
-	if (m_type != b2_dynamicBody)
-	{
-		return;
-	}
-
-	if (IsAwake() == false)
-	{
-		SetAwake(true);
-	}
-	m_angularVelocity += m_invI * impulse;
-}
-
 inline void b2Body::SynchronizeTransform()
 {
 	m_xf.q.Set(m_sweep.a);
@@ -833,6 +681,21 @@ inline void b2Body::Advance(float32 alpha)
 	m_xf.p = m_sweep.c - b2Mul(m_xf.q, m_sweep.localCenter);
 }
 
+inline uint32 b2Body::GetId() const
+{
+	return m_id;
+}
+
+inline void b2Body::SetId(uint32 id)
+{
+	m_id = id;
+}
+
+inline uint32 b2Body::GetChangeEpoch() const
+{
+	return m_changeEpoch;
+}
+
 inline b2World* b2Body::GetWorld()
 {
 	return m_world;
@@ -19,19 +19,34 @@
 #include <Box2D/Dynamics/b2ContactManager.h>
 #include <Box2D/Dynamics/b2Body.h>
 #include <Box2D/Dynamics/b2Fixture.h>
+#include <Box2D/Dynamics/b2TimeStep.h>
+#include <Box2D/Dynamics/b2World.h>
 #include <Box2D/Dynamics/b2WorldCallbacks.h>
 #include <Box2D/Dynamics/Contacts/b2Contact.h>
+#include <Box2D/Dynamics/Contacts/b2CircleContact.h>
+#include <Box2D/Dynamics/Contacts/b2PolygonAndCircleContact.h>
+#include <Box2D/Dynamics/Contacts/b2PolygonContact.h>
+#include <Box2D/Dynamics/Contacts/b2EdgeAndCircleContact.h>
+#include <Box2D/Dynamics/Contacts/b2EdgeAndPolygonContact.h>
+#include <Box2D/Dynamics/Contacts/b2ChainAndCircleContact.h>
+#include <Box2D/Dynamics/Contacts/b2ChainAndPolygonContact.h>
+#include <Box2D/Common/b2Trace.h>
 
 b2ContactFilter b2_defaultFilter;
 b2ContactListener b2_defaultListener;
 
-b2ContactManager::b2ContactManager()
+b2ContactManager::b2ContactManager(b2Allocator* allocator) : m_broadPhase(allocator)
 {
 	m_contactList = NULL;
 	m_contactCount = 0;
+	for (int32 i = 0; i < b2_contactPairTypeCount; ++i)
+	{
+		m_pairTypeLists[i] = NULL;
+	}
 	m_contactFilter = &b2_defaultFilter;
 	m_contactListener = &b2_defaultListener;
 	m_allocator = NULL;
+	m_metrics = NULL;
 }
 
 void b2ContactManager::Destroy(b2Contact* c)
@@ -46,7 +61,16 @@ void b2ContactManager::Destroy(b2Contact* c)
 		m_contactListener->EndContact(c);
 	}
 
+	++m_metrics->contactsDestroyed;
+
 	// Remove from the world.
+	int32 pairType = c->GetPairType();
+	if (c == m_pairTypeLists[pairType])
+	{
+		b2Contact* next = c->m_next;
+		m_pairTypeLists[pairType] = next && next->GetPairType() == pairType ? next : NULL;
+	}
+
 	if (c->m_prev)
 	{
 		c->m_prev->m_next = c->m_next;
@@ -99,14 +123,12 @@ void b2ContactManager::Destroy(b2Contact* c)
 	--m_contactCount;
 }
 
-// This is the top level collision call for the time step. Here
-// all the narrow phase collision is processed for the world
-// contact list.
-void b2ContactManager::Collide()
+template <typename T>
+b2Contact* b2ContactManager::CollideRun(b2Contact* c, float32 speculativeTime, bool reuseManifolds)
 {
 	// Update awake contacts.
-	b2Contact* c = m_contactList;
-	while (c)
+	int32 pairType = c->GetPairType();
+	while (c && c->GetPairType() == pairType)
 	{
 		b2Fixture* fixtureA = c->GetFixtureA();
 		b2Fixture* fixtureB = c->GetFixtureB();
@@ -146,6 +168,10 @@ void b2ContactManager::Collide()
 		// At least one body must be awake and it must be dynamic or kinematic.
 		if (activeA == false && activeB == false)
 		{
+			if (c->IsTouching())
+			{
+				++m_metrics->contactsTouching;
+			}
 			c = c->GetNext();
 			continue;
 		}
@@ -155,8 +181,15 @@ void b2ContactManager::Collide()
 		bool overlap = m_broadPhase.TestOverlap(proxyIdA, proxyIdB);
 
 		// Here we destroy contacts that cease to overlap in the broad-phase.
+		// Their points are cached in case the fixtures come back together.
 		if (overlap == false)
 		{
+			b2ContactCacheKey key = c->GetCacheKey();
+			for (int32 i = 0; i < c->m_manifold.pointCount; ++i)
+			{
+				m_contactCache.Store(key, c->m_manifold.points + i);
+			}
+
 			b2Contact* cNuke = c;
 			c = cNuke->GetNext();
 			Destroy(cNuke);
@@ -164,13 +197,84 @@ void b2ContactManager::Collide()
 		}
 
 		// The contact persists.
-		c->Update(m_contactListener);
+		c->UpdateAs<T>(m_contactListener, &m_contactCache, speculativeTime, reuseManifolds);
+		if (c->m_flags & b2Contact::e_reusedFlag)
+		{
+			++m_metrics->manifoldsReused;
+		}
+		if (c->IsTouching())
+		{
+			++m_metrics->contactsTouching;
+		}
 		c = c->GetNext();
 	}
+
+	return c;
+}
+
+// This is the top level collision call for the time step. Here
+// all the narrow phase collision is processed for the world
+// contact list.
+void b2ContactManager::Collide(float32 speculativeTime, bool reuseManifolds)
+{
+	// The contacts of one pair type are together in the list, so each run is
+	// updated with the Evaluate of its contact class bound statically.
+	b2Contact* c = m_contactList;
+	while (c)
+	{
+		// Fixture A has the primary type of the registers, so fixture B is a
+		// circle or a polygon.
+		bool circleB = c->GetFixtureB()->GetType() == b2Shape::e_circle;
+		switch (c->GetFixtureA()->GetType())
+		{
+		case b2Shape::e_circle:
+			c = CollideRun<b2CircleContact>(c, speculativeTime, reuseManifolds);
+			break;
+
+		case b2Shape::e_edge:
+			if (circleB)
+			{
+				c = CollideRun<b2EdgeAndCircleContact>(c, speculativeTime, reuseManifolds);
+			}
+			else
+			{
+				c = CollideRun<b2EdgeAndPolygonContact>(c, speculativeTime, reuseManifolds);
+			}
+			break;
+
+		case b2Shape::e_polygon:
+			if (circleB)
+			{
+				c = CollideRun<b2PolygonAndCircleContact>(c, speculativeTime, reuseManifolds);
+			}
+			else
+			{
+				c = CollideRun<b2PolygonContact>(c, speculativeTime, reuseManifolds);
+			}
+			break;
+
+		case b2Shape::e_chain:
+			if (circleB)
+			{
+				c = CollideRun<b2ChainAndCircleContact>(c, speculativeTime, reuseManifolds);
+			}
+			else
+			{
+				c = CollideRun<b2ChainAndPolygonContact>(c, speculativeTime, reuseManifolds);
+			}
+			break;
+
+		default:
+			b2Assert(false);
+			c = c->GetNext();
+			break;
+		}
+	}
 }
 
 void b2ContactManager::FindNewContacts()
 {
+	b2TraceScope("UpdatePairs");
 	m_broadPhase.UpdatePairs(this);
 }
 
@@ -182,6 +286,8 @@ void b2ContactManager::AddPair(void* proxyUserDataA, void* proxyUserDataB)
 	b2Fixture* fixtureA = proxyA->fixture;
 	b2Fixture* fixtureB = proxyB->fixture;
 
+	++m_metrics->pairsFound;
+
 	int32 indexA = proxyA->childIndex;
 	int32 indexB = proxyB->childIndex;
 
@@ -242,6 +348,8 @@ void b2ContactManager::AddPair(void* proxyUserDataA, void* proxyUserDataB)
 		return;
 	}
 
+	++m_metrics->contactsCreated;
+
 	// Contact creation may swap fixtures.
 	fixtureA = c->GetFixtureA();
 	fixtureB = c->GetFixtureB();
@@ -250,14 +358,29 @@ void b2ContactManager::AddPair(void* proxyUserDataA, void* proxyUserDataB)
 	bodyA = fixtureA->GetBody();
 	bodyB = fixtureB->GetBody();
 
-	// Insert into the world.
-	c->m_prev = NULL;
-	c->m_next = m_contactList;
-	if (m_contactList != NULL)
+	// Insert into the world, in front of the contacts of the same pair type.
+	int32 pairType = c->GetPairType();
+	b2Contact* next = m_pairTypeLists[pairType];
+	if (next == NULL)
+	{
+		next = m_contactList;
+	}
+
+	c->m_prev = next ? next->m_prev : NULL;
+	c->m_next = next;
+	if (c->m_prev)
 	{
-		m_contactList->m_prev = c;
+		c->m_prev->m_next = c;
 	}
-	m_contactList = c;
+	if (next)
+	{
+		next->m_prev = c;
+	}
+	if (next == m_contactList)
+	{
+		m_contactList = c;
+	}
+	m_pairTypeLists[pairType] = c;
 
 	// Connect to island graph.
 
@@ -286,6 +409,14 @@ void b2ContactManager::AddPair(void* proxyUserDataA, void* proxyUserDataB)
 	bodyB->m_contactList = &c->m_nodeB;
 
 	// Wake up the bodies
+	if (bodyA->m_type != b2_staticBody && bodyA->IsAwake() == false)
+	{
+		++m_metrics->bodiesAwake;
+	}
+	if (bodyB->m_type != b2_staticBody && bodyB->IsAwake() == false)
+	{
+		++m_metrics->bodiesAwake;
+	}
 	bodyA->SetAwake(true);
 	bodyB->SetAwake(true);
 
@@ -20,17 +20,19 @@
 #define B2_CONTACT_MANAGER_H
 
 #include <Box2D/Collision/b2BroadPhase.h>
+#include <Box2D/Dynamics/Contacts/b2Contact.h>
+#include <Box2D/Dynamics/Contacts/b2ContactCache.h>
 
-class b2Contact;
 class b2ContactFilter;
 class b2ContactListener;
 class b2BlockAllocator;
+struct b2Metrics;
 
 // Delegate of b2World.
 class b2ContactManager
 {
 public:
-	b2ContactManager();
+	b2ContactManager(b2Allocator* allocator);
 
 	// Broad-phase callback.
 	void AddPair(void* proxyUserDataA, void* proxyUserDataB);
@@ -39,14 +41,28 @@ public:
 
 	void Destroy(b2Contact* c);
 
-	void Collide();
+	// A positive speculative time turns on speculative points for shapes that
+	// could meet within it. Manifold reuse keeps the manifolds of contacts
+	// whose bodies barely moved against each other.
+	void Collide(float32 speculativeTime, bool reuseManifolds);
+
+	// Collide the run of contacts of one pair type that starts at c, with the
+	// contact class T of the type. Returns the contact after the run.
+	template <typename T>
+	b2Contact* CollideRun(b2Contact* c, float32 speculativeTime, bool reuseManifolds);
 
 	b2BroadPhase m_broadPhase;
+	b2ContactCache m_contactCache;
 	b2Contact* m_contactList;
 	int32 m_contactCount;
+
+	// The first contact of each pair type in the contact list. The contacts
+	// of one type follow it, so they can be updated in one run.
+	b2Contact* m_pairTypeLists[b2_contactPairTypeCount];
 	b2ContactFilter* m_contactFilter;
 	b2ContactListener* m_contactListener;
 	b2BlockAllocator* m_allocator;
+	b2Metrics* m_metrics;
 };
 
 #endif
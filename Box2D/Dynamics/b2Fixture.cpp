@@ -19,6 +19,7 @@
 #include <Box2D/Dynamics/b2Fixture.h>
 #include <Box2D/Dynamics/Contacts/b2Contact.h>
 #include <Box2D/Dynamics/b2World.h>
+#include <Box2D/Dynamics/b2Recorder.h>
 #include <Box2D/Collision/Shapes/b2CircleShape.h>
 #include <Box2D/Collision/Shapes/b2EdgeShape.h>
 #include <Box2D/Collision/Shapes/b2PolygonShape.h>
@@ -35,6 +36,7 @@ b2Fixture::b2Fixture()
 	m_proxies = NULL;
 	m_proxyCount = 0;
 	m_shape = NULL;
+	m_sharedShape = NULL;
 	m_density = 0.0f;
 }
 
@@ -51,11 +53,21 @@ void b2Fixture::Create(b2BlockAllocator* allocator, b2Body* body, const b2Fixtur
 
 	m_isSensor = def->isSensor;
 
-	m_shape = def->shape->Clone(allocator);
+	if (def->sharedShape)
+	{
+		m_sharedShape = def->sharedShape;
+		m_sharedShape->Retain();
+		m_shape = m_sharedShape->m_shape;
+	}
+	else
+	{
+		m_sharedShape = NULL;
+		m_shape = def->shape->Clone(allocator);
+	}
 
 	// Reserve proxy space
 	int32 childCount = m_shape->GetChildCount();
-	m_proxies = (b2FixtureProxy*)allocator->Allocate(childCount * sizeof(b2FixtureProxy));
+	m_proxies = (b2FixtureProxy*)allocator->Allocate(childCount * sizeof(b2FixtureProxy), e_allocTagProxy);
 	for (int32 i = 0; i < childCount; ++i)
 	{
 		m_proxies[i].fixture = NULL;
@@ -73,9 +85,17 @@ void b2Fixture::Destroy(b2BlockAllocator* allocator)
 
 	// Free the proxy array.
 	int32 childCount = m_shape->GetChildCount();
-	allocator->Free(m_proxies, childCount * sizeof(b2FixtureProxy));
+	allocator->Free(m_proxies, childCount * sizeof(b2FixtureProxy), e_allocTagProxy);
 	m_proxies = NULL;
 
+	if (m_sharedShape)
+	{
+		m_sharedShape->Release();
+		m_sharedShape = NULL;
+		m_shape = NULL;
+		return;
+	}
+
 	// Free the child shape.
 	switch (m_shape->m_type)
 	{
@@ -83,7 +103,7 @@ void b2Fixture::Destroy(b2BlockAllocator* allocator)
 		{
 			b2CircleShape* s = (b2CircleShape*)m_shape;
 			s->~b2CircleShape();
-			allocator->Free(s, sizeof(b2CircleShape));
+			allocator->Free(s, sizeof(b2CircleShape), e_allocTagShape);
 		}
 		break;
 
@@ -91,7 +111,7 @@ void b2Fixture::Destroy(b2BlockAllocator* allocator)
 		{
 			b2EdgeShape* s = (b2EdgeShape*)m_shape;
 			s->~b2EdgeShape();
-			allocator->Free(s, sizeof(b2EdgeShape));
+			allocator->Free(s, sizeof(b2EdgeShape), e_allocTagShape);
 		}
 		break;
 
@@ -99,7 +119,7 @@ void b2Fixture::Destroy(b2BlockAllocator* allocator)
 		{
 			b2PolygonShape* s = (b2PolygonShape*)m_shape;
 			s->~b2PolygonShape();
-			allocator->Free(s, sizeof(b2PolygonShape));
+			allocator->Free(s, sizeof(b2PolygonShape), e_allocTagShape);
 		}
 		break;
 
@@ -107,7 +127,7 @@ void b2Fixture::Destroy(b2BlockAllocator* allocator)
 		{
 			b2ChainShape* s = (b2ChainShape*)m_shape;
 			s->~b2ChainShape();
-			allocator->Free(s, sizeof(b2ChainShape));
+			allocator->Free(s, sizeof(b2ChainShape), e_allocTagShape);
 		}
 		break;
 
@@ -149,7 +169,7 @@ void b2Fixture::DestroyProxies(b2BroadPhase* broadPhase)
 	m_proxyCount = 0;
 }
 
-void b2Fixture::Synchronize(b2BroadPhase* broadPhase, const b2Transform& transform1, const b2Transform& transform2)
+void b2Fixture::Synchronize(b2BroadPhase* broadPhase, const b2Transform& transform1, const b2Transform& transform2, const b2Vec2& reach)
 {
 	if (m_proxyCount == 0)
 	{
@@ -167,6 +187,14 @@ void b2Fixture::Synchronize(b2BroadPhase* broadPhase, const b2Transform& transfo
 
 		proxy->aabb.Combine(aabb1, aabb2);
 
+		if (reach.x != 0.0f || reach.y != 0.0f)
+		{
+			b2AABB aabb3;
+			aabb3.lowerBound = aabb2.lowerBound + reach;
+			aabb3.upperBound = aabb2.upperBound + reach;
+			proxy->aabb.Combine(aabb3);
+		}
+
 		b2Vec2 displacement = transform2.p - transform1.p;
 
 		broadPhase->MoveProxy(proxy->proxyId, proxy->aabb, displacement);
@@ -175,6 +203,13 @@ void b2Fixture::Synchronize(b2BroadPhase* broadPhase, const b2Transform& transfo
 
 void b2Fixture::SetFilterData(const b2Filter& filter)
 {
+	b2RecordScope scope(m_body->GetWorld());
+	if (scope.GetRecorder())
+	{
+		float32 values[3] = { (float32)filter.categoryBits, (float32)filter.maskBits, (float32)filter.groupIndex };
+		scope.GetRecorder()->RecordFixture(e_recordSetFilterData, this, values, 3);
+	}
+
 	m_filter = filter;
 
 	Refilter();
@@ -219,6 +254,13 @@ void b2Fixture::Refilter()
 
 void b2Fixture::SetSensor(bool sensor)
 {
+	b2RecordScope scope(m_body->GetWorld());
+	if (scope.GetRecorder())
+	{
+		float32 value = sensor ? 1.0f : 0.0f;
+		scope.GetRecorder()->RecordFixture(e_recordSetSensor, this, &value, 1);
+	}
+
 	if (sensor != m_isSensor)
 	{
 		m_body->SetAwake(true);
@@ -226,6 +268,40 @@ void b2Fixture::SetSensor(bool sensor)
 	}
 }
 
+void b2Fixture::SetDensity(float32 density)
+{
+	b2RecordScope scope(m_body->GetWorld());
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordFixture(e_recordSetDensity, this, &density, 1);
+	}
+
+	b2Assert(b2IsValid(density) && density >= 0.0f);
+	m_density = density;
+}
+
+void b2Fixture::SetFriction(float32 friction)
+{
+	b2RecordScope scope(m_body->GetWorld());
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordFixture(e_recordSetFriction, this, &friction, 1);
+	}
+
+	m_friction = friction;
+}
+
+void b2Fixture::SetRestitution(float32 restitution)
+{
+	b2RecordScope scope(m_body->GetWorld());
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordFixture(e_recordSetRestitution, this, &restitution, 1);
+	}
+
+	m_restitution = restitution;
+}
+
 void b2Fixture::Dump(int32 bodyIndex)
 {
 	b2Log("    b2FixtureDef fd;\n");
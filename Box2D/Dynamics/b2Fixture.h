@@ -22,6 +22,7 @@
 #include <Box2D/Dynamics/b2Body.h>
 #include <Box2D/Collision/b2Collision.h>
 #include <Box2D/Collision/Shapes/b2Shape.h>
+#include <Box2D/Collision/Shapes/b2SharedShape.h>
 
 class b2BlockAllocator;
 class b2Body;
@@ -59,6 +60,7 @@ struct b2FixtureDef
 	b2FixtureDef()
 	{
 		shape = NULL;
+		sharedShape = NULL;
 		userData = NULL;
 		friction = 0.2f;
 		restitution = 0.0f;
@@ -66,10 +68,14 @@ struct b2FixtureDef
 		isSensor = false;
 	}
 
-	/// The shape, this must be set. The shape will be cloned, so you
-	/// can create the shape on the stack.
+	/// The shape, this or sharedShape must be set. The shape will be cloned,
+	/// so you can create the shape on the stack.
 	const b2Shape* shape;
 
+	/// A shape to reference instead of cloning shape. The fixture holds a
+	/// reference until it is destroyed.
+	b2SharedShape* sharedShape;
+
 	/// Use this to store application specific fixture data.
 	void* userData;
 
@@ -113,10 +119,15 @@ public:
 
 	/// Get the child shape. You can modify the child shape, however you should not change the
 	/// number of vertices because this will crash some collision caching mechanisms.
-	/// Manipulating the shape may lead to non-physical behavior.
+	/// Manipulating the shape may lead to non-physical behavior. Do not modify
+	/// the shape of a fixture that was created from a shared shape.
 	b2Shape* GetShape();
 	const b2Shape* GetShape() const;
 
+	/// Get the shared shape this fixture references, or NULL if the fixture
+	/// owns a copy of its shape.
+	b2SharedShape* GetSharedShape() const;
+
 	/// Set if this fixture is a sensor.
 	void SetSensor(bool sensor);
 
@@ -201,6 +212,7 @@ protected:
 	friend class b2World;
 	friend class b2Contact;
 	friend class b2ContactManager;
+	friend class b2Snapshot;
 
 	b2Fixture();
 
@@ -213,7 +225,9 @@ protected:
 	void CreateProxies(b2BroadPhase* broadPhase, const b2Transform& xf);
 	void DestroyProxies(b2BroadPhase* broadPhase);
 
-	void Synchronize(b2BroadPhase* broadPhase, const b2Transform& xf1, const b2Transform& xf2);
+	// The proxies cover the sweep from xf1 to xf2, and the shape at xf2 moved
+	// by the reach.
+	void Synchronize(b2BroadPhase* broadPhase, const b2Transform& xf1, const b2Transform& xf2, const b2Vec2& reach);
 
 	float32 m_density;
 
@@ -221,6 +235,7 @@ protected:
 	b2Body* m_body;
 
 	b2Shape* m_shape;
+	b2SharedShape* m_sharedShape;
 
 	float32 m_friction;
 	float32 m_restitution;
@@ -250,6 +265,11 @@ inline const b2Shape* b2Fixture::GetShape() const
 	return m_shape;
 }
 
+inline b2SharedShape* b2Fixture::GetSharedShape() const
+{
+	return m_sharedShape;
+}
+
 inline bool b2Fixture::IsSensor() const
 {
 	return m_isSensor;
@@ -290,12 +310,6 @@ inline const b2Fixture* b2Fixture::GetNext() const
 	return m_next;
 }
 
-inline void b2Fixture::SetDensity(float32 density)
-{
-	b2Assert(b2IsValid(density) && density >= 0.0f);
-	m_density = density;
-}
-
 inline float32 b2Fixture::GetDensity() const
 {
 	return m_density;
@@ -306,21 +320,11 @@ inline float32 b2Fixture::GetFriction() const
 	return m_friction;
 }
 
-inline void b2Fixture::SetFriction(float32 friction)
-{
-	m_friction = friction;
-}
-
 inline float32 b2Fixture::GetRestitution() const
 {
 	return m_restitution;
 }
 
-inline void b2Fixture::SetRestitution(float32 restitution)
-{
-	m_restitution = restitution;
-}
-
 inline bool b2Fixture::TestPoint(const b2Vec2& p) const
 {
 	return m_shape->TestPoint(m_body->GetTransform(), p);
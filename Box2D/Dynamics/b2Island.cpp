@@ -24,8 +24,11 @@
 #include <Box2D/Dynamics/Contacts/b2Contact.h>
 #include <Box2D/Dynamics/Contacts/b2ContactSolver.h>
 #include <Box2D/Dynamics/Joints/b2Joint.h>
+#include <Box2D/Dynamics/Joints/b2JointTreeSolver.h>
 #include <Box2D/Common/b2StackAllocator.h>
 #include <Box2D/Common/b2Timer.h>
+#include <Box2D/Common/b2Trace.h>
+#include <cstring>
 
 /*
 Position Correction Notes
@@ -168,11 +171,13 @@ b2Island::b2Island(
 
 	m_velocities = (b2Velocity*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Velocity));
 	m_positions = (b2Position*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Position));
+	m_levels = (int32*)m_allocator->Allocate(m_bodyCapacity * sizeof(int32));
 }
 
 b2Island::~b2Island()
 {
 	// Warning: the order should reverse the constructor order.
+	m_allocator->Free(m_levels);
 	m_allocator->Free(m_positions);
 	m_allocator->Free(m_velocities);
 	m_allocator->Free(m_joints);
@@ -180,8 +185,186 @@ b2Island::~b2Island()
 	m_allocator->Free(m_bodies);
 }
 
-void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep)
+void b2Island::SortJoints()
 {
+	// Counting sort by type. It is stable, so joints of one type keep the
+	// order in which the island found them.
+	if (m_jointCount < 2)
+	{
+		return;
+	}
+
+	int32 starts[b2_jointTypeCount];
+	for (int32 i = 0; i < b2_jointTypeCount; ++i)
+	{
+		starts[i] = 0;
+	}
+
+	for (int32 i = 0; i < m_jointCount; ++i)
+	{
+		++starts[m_joints[i]->m_type];
+	}
+
+	if (starts[m_joints[0]->m_type] == m_jointCount)
+	{
+		return;
+	}
+
+	int32 sum = 0;
+	for (int32 i = 0; i < b2_jointTypeCount; ++i)
+	{
+		int32 n = starts[i];
+		starts[i] = sum;
+		sum += n;
+	}
+
+	b2Joint** sorted = (b2Joint**)m_allocator->Allocate(m_jointCount * sizeof(b2Joint*));
+	for (int32 i = 0; i < m_jointCount; ++i)
+	{
+		b2Joint* joint = m_joints[i];
+		sorted[starts[joint->m_type]++] = joint;
+	}
+
+	memcpy(m_joints, sorted, m_jointCount * sizeof(b2Joint*));
+	m_allocator->Free(sorted);
+}
+
+void b2Island::LevelContacts()
+{
+	if (m_contactCount == 0)
+	{
+		return;
+	}
+
+	// The contact graph in compressed rows. After filling, the neighbors of
+	// body i are in [ends[i - 1], ends[i]).
+	int32* ends = (int32*)m_allocator->Allocate(m_bodyCount * sizeof(int32));
+	int32* neighbors = (int32*)m_allocator->Allocate(2 * m_contactCount * sizeof(int32));
+	int32* queue = (int32*)m_allocator->Allocate(m_bodyCount * sizeof(int32));
+
+	for (int32 i = 0; i < m_bodyCount; ++i)
+	{
+		ends[i] = 0;
+	}
+
+	for (int32 i = 0; i < m_contactCount; ++i)
+	{
+		b2Contact* contact = m_contacts[i];
+		++ends[contact->GetFixtureA()->GetBody()->m_islandIndex];
+		++ends[contact->GetFixtureB()->GetBody()->m_islandIndex];
+	}
+
+	int32 sum = 0;
+	for (int32 i = 0; i < m_bodyCount; ++i)
+	{
+		int32 n = ends[i];
+		ends[i] = sum;
+		sum += n;
+	}
+
+	for (int32 i = 0; i < m_contactCount; ++i)
+	{
+		b2Contact* contact = m_contacts[i];
+		int32 indexA = contact->GetFixtureA()->GetBody()->m_islandIndex;
+		int32 indexB = contact->GetFixtureB()->GetBody()->m_islandIndex;
+		neighbors[ends[indexA]++] = indexB;
+		neighbors[ends[indexB]++] = indexA;
+	}
+
+	// Breadth first from the bodies that do not move under contact.
+	int32 head = 0;
+	int32 tail = 0;
+	for (int32 i = 0; i < m_bodyCount; ++i)
+	{
+		if (m_bodies[i]->m_type == b2_dynamicBody)
+		{
+			m_levels[i] = -1;
+		}
+		else
+		{
+			m_levels[i] = 0;
+			queue[tail++] = i;
+		}
+	}
+
+	while (head < tail)
+	{
+		int32 index = queue[head++];
+		int32 begin = index > 0 ? ends[index - 1] : 0;
+		for (int32 i = begin; i < ends[index]; ++i)
+		{
+			int32 other = neighbors[i];
+			if (m_levels[other] == -1)
+			{
+				m_levels[other] = m_levels[index] + 1;
+				queue[tail++] = other;
+			}
+		}
+	}
+
+	// Bodies that rest on nothing share a level above all others, so none
+	// of them is frozen against another.
+	for (int32 i = 0; i < m_bodyCount; ++i)
+	{
+		if (m_levels[i] == -1)
+		{
+			m_levels[i] = m_bodyCount;
+		}
+	}
+
+	m_allocator->Free(queue);
+	m_allocator->Free(neighbors);
+	m_allocator->Free(ends);
+
+	// Counting sort by the lower level. It is stable, so the contacts of one
+	// level keep the order in which the island found them.
+	int32 levelCount = m_bodyCount + 1;
+	int32* starts = (int32*)m_allocator->Allocate(levelCount * sizeof(int32));
+	for (int32 i = 0; i < levelCount; ++i)
+	{
+		starts[i] = 0;
+	}
+
+	for (int32 i = 0; i < m_contactCount; ++i)
+	{
+		b2Contact* contact = m_contacts[i];
+		int32 levelA = m_levels[contact->GetFixtureA()->GetBody()->m_islandIndex];
+		int32 levelB = m_levels[contact->GetFixtureB()->GetBody()->m_islandIndex];
+		++starts[b2Min(levelA, levelB)];
+	}
+
+	sum = 0;
+	for (int32 i = 0; i < levelCount; ++i)
+	{
+		int32 n = starts[i];
+		starts[i] = sum;
+		sum += n;
+	}
+
+	b2Contact** sorted = (b2Contact**)m_allocator->Allocate(m_contactCount * sizeof(b2Contact*));
+	for (int32 i = 0; i < m_contactCount; ++i)
+	{
+		b2Contact* contact = m_contacts[i];
+		int32 levelA = m_levels[contact->GetFixtureA()->GetBody()->m_islandIndex];
+		int32 levelB = m_levels[contact->GetFixtureB()->GetBody()->m_islandIndex];
+		sorted[starts[b2Min(levelA, levelB)]++] = contact;
+	}
+
+	memcpy(m_contacts, sorted, m_contactCount * sizeof(b2Contact*));
+	m_allocator->Free(sorted);
+	m_allocator->Free(starts);
+}
+
+void b2Island::Solve(b2StepTimes* times, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep)
+{
+	SortJoints();
+
+	if (step.solverType == b2_softStepSolver)
+	{
+		SolveSoftStep(times, step, gravity, allowSleep);
+		return;
+	}
+
 	b2Timer timer;
 
 	float32 h = step.dt;
@@ -225,6 +408,11 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 
 	timer.Reset();
 
+	if (step.shockPropagation)
+	{
+		LevelContacts();
+	}
+
 	// Solver data
 	b2SolverData solverData;
 	solverData.step = step;
@@ -243,33 +431,58 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	b2ContactSolver contactSolver(&contactSolverDef);
 	contactSolver.InitializeVelocityConstraints();
 
+	// The tree solver takes the joints it can solve directly from the end of
+	// the joint array.
+	b2JointTreeSolverDef treeSolverDef;
+	treeSolverDef.step = step;
+	treeSolverDef.joints = m_joints;
+	treeSolverDef.count = step.jointTrees ? m_jointCount : 0;
+	treeSolverDef.bodyCount = step.jointTrees ? m_bodyCount : 0;
+	treeSolverDef.positions = m_positions;
+	treeSolverDef.velocities = m_velocities;
+	treeSolverDef.allocator = m_allocator;
+
+	b2JointTreeSolver treeSolver(&treeSolverDef);
+	int32 jointCount = m_jointCount - treeSolver.m_rowCount;
+
 	if (step.warmStarting)
 	{
 		contactSolver.WarmStart();
 	}
 
-	for (int32 i = 0; i < m_jointCount; ++i)
-	{
-		m_joints[i]->InitVelocityConstraints(solverData);
-	}
+	b2Joint::SolveBatch(e_initVelocityPass, m_joints, m_jointCount, solverData);
+	treeSolver.InitializeVelocityConstraints();
 
-	profile->solveInit = timer.GetMilliseconds();
+	times->solveInit += timer.GetNanoseconds();
 
 	// Solve velocity constraints
 	timer.Reset();
 	for (int32 i = 0; i < step.velocityIterations; ++i)
 	{
-		for (int32 j = 0; j < m_jointCount; ++j)
-		{
-			m_joints[j]->SolveVelocityConstraints(solverData);
-		}
+		b2TraceScopeValue("VelocityIteration", i);
+		b2Joint::SolveBatch(e_solveVelocityPass, m_joints, jointCount, solverData);
+		treeSolver.SolveVelocityConstraints();
 
 		contactSolver.SolveVelocityConstraints();
 	}
 
+	if (step.speculativeContacts)
+	{
+		contactSolver.ApplyRestitution();
+	}
+
 	// Store impulses for warm starting
 	contactSolver.StoreImpulses();
-	profile->solveVelocity = timer.GetMilliseconds();
+
+	if (step.shockPropagation)
+	{
+		// One more pass in which each body rests on the bodies below it. The
+		// impulses of this pass are not stored: warm starting them would push
+		// down on the lower bodies.
+		contactSolver.FreezeLowerBodies(m_levels);
+		contactSolver.SolveVelocityConstraints();
+	}
+	times->solveVelocity += timer.GetNanoseconds();
 
 	// Integrate positions
 	for (int32 i = 0; i < m_bodyCount; ++i)
@@ -309,14 +522,12 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	bool positionSolved = false;
 	for (int32 i = 0; i < step.positionIterations; ++i)
 	{
+		b2TraceScopeValue("PositionIteration", i);
 		bool contactsOkay = contactSolver.SolvePositionConstraints();
 
-		bool jointsOkay = true;
-		for (int32 i = 0; i < m_jointCount; ++i)
-		{
-			bool jointOkay = m_joints[i]->SolvePositionConstraints(solverData);
-			jointsOkay = jointsOkay && jointOkay;
-		}
+		// Tree joints use the per-joint position pass too. A linearized
+		// solve of the whole tree overshoots when the chain whips.
+		bool jointsOkay = b2Joint::SolveBatch(e_solvePositionPass, m_joints, m_jointCount, solverData);
 
 		if (contactsOkay && jointsOkay)
 		{
@@ -337,46 +548,243 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 		body->SynchronizeTransform();
 	}
 
-	profile->solvePosition = timer.GetMilliseconds();
+	times->solvePosition += timer.GetNanoseconds();
 
 	Report(contactSolver.m_velocityConstraints);
 
 	if (allowSleep)
 	{
-		float32 minSleepTime = b2_maxFloat;
+		UpdateSleep(h, positionSolved);
+	}
+}
+
+// Soft step: the step is split into sub-steps. Each sub-step integrates the
+// velocities, warm starts, solves the joints and the soft contacts, integrates
+// the positions and then relaxes the contacts without position bias, so the
+// soft push-out does not leave energy behind. Contact separation is tracked
+// from the body motion since the start of the step, so the manifolds are not
+// recomputed. Joint position errors are removed by NGS after the sub-steps.
+void b2Island::SolveSoftStep(b2StepTimes* times, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep)
+{
+	b2Timer timer;
+
+	int32 subStepCount = b2Max(step.velocityIterations, 1);
+	float32 h = step.dt / subStepCount;
+	float32 inv_h = subStepCount * step.inv_dt;
+
+	// Initialize the body state.
+	for (int32 i = 0; i < m_bodyCount; ++i)
+	{
+		b2Body* b = m_bodies[i];
 
-		const float32 linTolSqr = b2_linearSleepTolerance * b2_linearSleepTolerance;
-		const float32 angTolSqr = b2_angularSleepTolerance * b2_angularSleepTolerance;
+		// Store positions for continuous collision.
+		b->m_sweep.c0 = b->m_sweep.c;
+		b->m_sweep.a0 = b->m_sweep.a;
+
+		m_positions[i].c = b->m_sweep.c;
+		m_positions[i].a = b->m_sweep.a;
+		m_velocities[i].v = b->m_linearVelocity;
+		m_velocities[i].w = b->m_angularVelocity;
+	}
 
+	b2TimeStep subStep = step;
+	subStep.dt = h;
+	subStep.inv_dt = inv_h;
+
+	b2SolverData solverData;
+	solverData.step = subStep;
+	solverData.positions = m_positions;
+	solverData.velocities = m_velocities;
+
+	// The contact impulses are per sub-step, so they are warm started by the
+	// same ratio as a full step when the sub-step count does not change.
+	b2ContactSolverDef contactSolverDef;
+	contactSolverDef.step = subStep;
+	contactSolverDef.contacts = m_contacts;
+	contactSolverDef.count = m_contactCount;
+	contactSolverDef.positions = m_positions;
+	contactSolverDef.velocities = m_velocities;
+	contactSolverDef.allocator = m_allocator;
+
+	b2ContactSolver contactSolver(&contactSolverDef);
+	contactSolver.InitializeVelocityConstraints();
+
+	// Soft contacts can not be stiffer than a quarter of the sub-step rate.
+	contactSolver.PrepareSoftConstraints(b2Min(b2_contactHertz, 0.25f * inv_h), b2_contactDampingRatio);
+
+	b2JointTreeSolverDef treeSolverDef;
+	treeSolverDef.step = subStep;
+	treeSolverDef.joints = m_joints;
+	treeSolverDef.count = step.jointTrees ? m_jointCount : 0;
+	treeSolverDef.bodyCount = step.jointTrees ? m_bodyCount : 0;
+	treeSolverDef.positions = m_positions;
+	treeSolverDef.velocities = m_velocities;
+	treeSolverDef.allocator = m_allocator;
+
+	b2JointTreeSolver treeSolver(&treeSolverDef);
+	int32 jointCount = m_jointCount - treeSolver.m_rowCount;
+
+	// The contacts measure the body motion from these.
+	b2Position* origins = (b2Position*)m_allocator->Allocate(m_bodyCount * sizeof(b2Position));
+	b2Rot* rotations = (b2Rot*)m_allocator->Allocate(m_bodyCount * sizeof(b2Rot));
+	for (int32 i = 0; i < m_bodyCount; ++i)
+	{
+		origins[i] = m_positions[i];
+		rotations[i].SetIdentity();
+	}
+
+	times->solveInit += timer.GetNanoseconds();
+
+	timer.Reset();
+	for (int32 k = 0; k < subStepCount; ++k)
+	{
+		b2TraceScopeValue("SubStep", k);
+
+		// Integrate velocities and apply damping.
 		for (int32 i = 0; i < m_bodyCount; ++i)
 		{
 			b2Body* b = m_bodies[i];
-			if (b->GetType() == b2_staticBody)
+			if (b->m_type != b2_dynamicBody)
 			{
 				continue;
 			}
 
-			if ((b->m_flags & b2Body::e_autoSleepFlag) == 0 ||
-				b->m_angularVelocity * b->m_angularVelocity > angTolSqr ||
-				b2Dot(b->m_linearVelocity, b->m_linearVelocity) > linTolSqr)
+			b2Vec2 v = m_velocities[i].v;
+			float32 w = m_velocities[i].w;
+
+			v += h * (b->m_gravityScale * gravity + b->m_invMass * b->m_force);
+			w += h * b->m_invI * b->m_torque;
+
+			v *= b2Clamp(1.0f - h * b->m_linearDamping, 0.0f, 1.0f);
+			w *= b2Clamp(1.0f - h * b->m_angularDamping, 0.0f, 1.0f);
+
+			m_velocities[i].v = v;
+			m_velocities[i].w = w;
+		}
+
+		// The joints warm start from the impulses of the previous sub-step.
+		solverData.step.dtRatio = k == 0 ? step.dtRatio : 1.0f;
+		b2Joint::SolveBatch(e_initVelocityPass, m_joints, m_jointCount, solverData);
+		treeSolver.InitializeVelocityConstraints();
+
+		contactSolver.WarmStart();
+
+		b2Joint::SolveBatch(e_solveVelocityPass, m_joints, jointCount, solverData);
+		treeSolver.SolveVelocityConstraints();
+
+		contactSolver.SolveSoftConstraints(origins, rotations, true);
+
+		// Integrate positions.
+		for (int32 i = 0; i < m_bodyCount; ++i)
+		{
+			b2Vec2 v = m_velocities[i].v;
+			float32 w = m_velocities[i].w;
+
+			// Check for large velocities. The limits apply to the motion over
+			// the full step, not over one sub-step.
+			b2Vec2 translation = step.dt * v;
+			if (b2Dot(translation, translation) > b2_maxTranslationSquared)
 			{
-				b->m_sleepTime = 0.0f;
-				minSleepTime = 0.0f;
+				float32 ratio = b2_maxTranslation / translation.Length();
+				v *= ratio;
 			}
-			else
+
+			float32 rotation = step.dt * w;
+			if (rotation * rotation > b2_maxRotationSquared)
 			{
-				b->m_sleepTime += h;
-				minSleepTime = b2Min(minSleepTime, b->m_sleepTime);
+				float32 ratio = b2_maxRotation / b2Abs(rotation);
+				w *= ratio;
 			}
+
+			m_positions[i].c += h * v;
+			m_positions[i].a += h * w;
+			m_velocities[i].v = v;
+			m_velocities[i].w = w;
+
+			rotations[i].Set(m_positions[i].a - origins[i].a);
 		}
 
-		if (minSleepTime >= b2_timeToSleep && positionSolved)
+		contactSolver.SolveSoftConstraints(origins, rotations, false);
+	}
+
+	m_allocator->Free(rotations);
+	m_allocator->Free(origins);
+
+	contactSolver.ApplyRestitution();
+	contactSolver.StoreImpulses();
+	times->solveVelocity += timer.GetNanoseconds();
+
+	// Remove the joint drift.
+	timer.Reset();
+	bool positionSolved = true;
+	for (int32 i = 0; i < step.positionIterations && m_jointCount > 0; ++i)
+	{
+		b2TraceScopeValue("PositionIteration", i);
+		bool jointsOkay = b2Joint::SolveBatch(e_solvePositionPass, m_joints, m_jointCount, solverData);
+
+		positionSolved = jointsOkay;
+		if (jointsOkay)
 		{
-			for (int32 i = 0; i < m_bodyCount; ++i)
-			{
-				b2Body* b = m_bodies[i];
-				b->SetAwake(false);
-			}
+			break;
+		}
+	}
+
+	// Copy state buffers back to the bodies
+	for (int32 i = 0; i < m_bodyCount; ++i)
+	{
+		b2Body* body = m_bodies[i];
+		body->m_sweep.c = m_positions[i].c;
+		body->m_sweep.a = m_positions[i].a;
+		body->m_linearVelocity = m_velocities[i].v;
+		body->m_angularVelocity = m_velocities[i].w;
+		body->SynchronizeTransform();
+	}
+
+	times->solvePosition += timer.GetNanoseconds();
+
+	Report(contactSolver.m_velocityConstraints);
+
+	if (allowSleep)
+	{
+		UpdateSleep(step.dt, positionSolved);
+	}
+}
+
+void b2Island::UpdateSleep(float32 h, bool positionSolved)
+{
+	float32 minSleepTime = b2_maxFloat;
+
+	const float32 linTolSqr = b2_linearSleepTolerance * b2_linearSleepTolerance;
+	const float32 angTolSqr = b2_angularSleepTolerance * b2_angularSleepTolerance;
+
+	for (int32 i = 0; i < m_bodyCount; ++i)
+	{
+		b2Body* b = m_bodies[i];
+		if (b->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		if ((b->m_flags & b2Body::e_autoSleepFlag) == 0 ||
+			b->m_angularVelocity * b->m_angularVelocity > angTolSqr ||
+			b2Dot(b->m_linearVelocity, b->m_linearVelocity) > linTolSqr)
+		{
+			b->m_sleepTime = 0.0f;
+			minSleepTime = 0.0f;
+		}
+		else
+		{
+			b->m_sleepTime += h;
+			minSleepTime = b2Min(minSleepTime, b->m_sleepTime);
+		}
+	}
+
+	if (minSleepTime >= b2_timeToSleep && positionSolved)
+	{
+		for (int32 i = 0; i < m_bodyCount; ++i)
+		{
+			b2Body* b = m_bodies[i];
+			b->SetAwake(false);
 		}
 	}
 }
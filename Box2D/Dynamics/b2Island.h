@@ -45,7 +45,7 @@ public:
 		m_jointCount = 0;
 	}
 
-	void Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep);
+	void Solve(b2StepTimes* times, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep);
 
 	void SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiIndexB);
 
@@ -71,6 +71,17 @@ public:
 
 	void Report(const b2ContactVelocityConstraint* constraints);
 
+	// Group the joints by type so b2Joint::SolveBatch can solve each type in one run.
+	void SortJoints();
+
+	// Shock propagation. Level the contact graph upward from the static and
+	// kinematic bodies into m_levels, then order the contacts by their lower
+	// level so the ground contacts are solved first.
+	void LevelContacts();
+
+	void SolveSoftStep(b2StepTimes* times, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep);
+	void UpdateSleep(float32 h, bool positionSolved);
+
 	b2StackAllocator* m_allocator;
 	b2ContactListener* m_listener;
 
@@ -80,6 +91,7 @@ public:
 
 	b2Position* m_positions;
 	b2Velocity* m_velocities;
+	int32* m_levels;
 
 	int32 m_bodyCount;
 	int32 m_jointCount;
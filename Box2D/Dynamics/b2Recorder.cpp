@@ -0,0 +1,385 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <Box2D/Dynamics/b2Recorder.h>
+#include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Dynamics/b2Fixture.h>
+#include <Box2D/Dynamics/Joints/b2DistanceJoint.h>
+#include <Box2D/Dynamics/Joints/b2FrictionJoint.h>
+#include <Box2D/Dynamics/Joints/b2GearJoint.h>
+#include <Box2D/Dynamics/Joints/b2MouseJoint.h>
+#include <Box2D/Dynamics/Joints/b2PrismaticJoint.h>
+#include <Box2D/Dynamics/Joints/b2PulleyJoint.h>
+#include <Box2D/Dynamics/Joints/b2RevoluteJoint.h>
+#include <Box2D/Dynamics/Joints/b2RopeJoint.h>
+#include <Box2D/Dynamics/Joints/b2WeldJoint.h>
+#include <Box2D/Dynamics/Joints/b2WheelJoint.h>
+#include <Box2D/Collision/Shapes/b2CircleShape.h>
+#include <Box2D/Collision/Shapes/b2EdgeShape.h>
+#include <Box2D/Collision/Shapes/b2ChainShape.h>
+#include <Box2D/Collision/Shapes/b2PolygonShape.h>
+#include <cstring>
+
+int32 b2GetJointDefSize(b2JointType type)
+{
+	switch (type)
+	{
+	case e_distanceJoint:
+		return sizeof(b2DistanceJointDef);
+
+	case e_mouseJoint:
+		return sizeof(b2MouseJointDef);
+
+	case e_prismaticJoint:
+		return sizeof(b2PrismaticJointDef);
+
+	case e_revoluteJoint:
+		return sizeof(b2RevoluteJointDef);
+
+	case e_pulleyJoint:
+		return sizeof(b2PulleyJointDef);
+
+	case e_gearJoint:
+		return sizeof(b2GearJointDef);
+
+	case e_wheelJoint:
+		return sizeof(b2WheelJointDef);
+
+	case e_weldJoint:
+		return sizeof(b2WeldJointDef);
+
+	case e_frictionJoint:
+		return sizeof(b2FrictionJointDef);
+
+	case e_ropeJoint:
+		return sizeof(b2RopeJointDef);
+
+	default:
+		return 0;
+	}
+}
+
+// Fixtures are identified by their position in the fixture list of their body.
+static uint32 b2GetFixtureIndex(const b2Fixture* fixture)
+{
+	uint32 index = 0;
+	for (const b2Fixture* f = fixture->GetBody()->GetFixtureList(); f != fixture; f = f->GetNext())
+	{
+		++index;
+	}
+	return index;
+}
+
+b2Recorder::b2Recorder()
+{
+	m_data = NULL;
+	m_size = 0;
+	m_capacity = 0;
+	m_depth = 0;
+	Clear();
+}
+
+b2Recorder::~b2Recorder()
+{
+	b2Free(m_data);
+}
+
+void b2Recorder::Clear()
+{
+	m_size = 0;
+	Write(b2_recordMagic);
+	Write(b2_recordVersion);
+}
+
+void b2Recorder::Reserve(int32 size)
+{
+	if (size <= m_capacity)
+	{
+		return;
+	}
+
+	int32 capacity = m_capacity > 0 ? m_capacity : 1024;
+	while (capacity < size)
+	{
+		capacity *= 2;
+	}
+
+	uint8* data = (uint8*)b2Alloc(capacity);
+	if (m_data)
+	{
+		memcpy(data, m_data, m_size);
+		b2Free(m_data);
+	}
+	m_data = data;
+	m_capacity = capacity;
+}
+
+void b2Recorder::WriteBytes(const void* data, int32 size)
+{
+	if (size == 0)
+	{
+		return;
+	}
+
+	Reserve(m_size + size);
+	memcpy(m_data + m_size, data, size);
+	m_size += size;
+}
+
+void b2Recorder::WriteShape(const b2Shape* shape)
+{
+	Write((uint8)shape->m_type);
+	Write(shape->m_radius);
+
+	switch (shape->m_type)
+	{
+	case b2Shape::e_circle:
+		{
+			const b2CircleShape* circle = (const b2CircleShape*)shape;
+			Write(circle->m_p);
+		}
+		break;
+
+	case b2Shape::e_edge:
+		{
+			const b2EdgeShape* edge = (const b2EdgeShape*)shape;
+			Write(edge->m_vertex0);
+			Write(edge->m_vertex1);
+			Write(edge->m_vertex2);
+			Write(edge->m_vertex3);
+			Write((uint8)edge->m_hasVertex0);
+			Write((uint8)edge->m_hasVertex3);
+		}
+		break;
+
+	case b2Shape::e_polygon:
+		{
+			// Copy the computed data verbatim so the replay matches bit for bit.
+			const b2PolygonShape* polygon = (const b2PolygonShape*)shape;
+			Write(polygon->m_vertexCount);
+			Write(polygon->m_centroid);
+			WriteBytes(polygon->m_vertices, polygon->m_vertexCount * sizeof(b2Vec2));
+			WriteBytes(polygon->m_normals, polygon->m_vertexCount * sizeof(b2Vec2));
+		}
+		break;
+
+	case b2Shape::e_chain:
+		{
+			const b2ChainShape* chain = (const b2ChainShape*)shape;
+			Write(chain->m_count);
+			WriteBytes(chain->m_vertices, chain->m_count * sizeof(b2Vec2));
+			Write(chain->m_prevVertex);
+			Write(chain->m_nextVertex);
+			Write((uint8)chain->m_hasPrevVertex);
+			Write((uint8)chain->m_hasNextVertex);
+		}
+		break;
+
+	default:
+		b2Assert(false);
+		break;
+	}
+}
+
+void b2Recorder::WriteFixtureDef(const b2FixtureDef* def)
+{
+	Write(def->friction);
+	Write(def->restitution);
+	Write(def->density);
+	Write((uint8)def->isSensor);
+	Write(def->filter);
+	WriteShape(def->sharedShape ? def->sharedShape->GetShape() : def->shape);
+}
+
+void b2Recorder::RecordWorld(const b2World* world)
+{
+	Write((uint8)e_recordWorld);
+	Write(world->GetGravity());
+	Write((uint8)world->GetAllowSleeping());
+	Write((uint8)world->GetWarmStarting());
+	Write((uint8)world->GetContinuousPhysics());
+	Write((uint8)world->GetSubStepping());
+	Write((uint8)world->GetAutoClearForces());
+
+	if (world->GetSolverType() != b2_sequentialImpulseSolver)
+	{
+		RecordWorld(e_recordSetSolverType, (float32)world->GetSolverType());
+	}
+
+	if (world->GetJointTreeSolving())
+	{
+		RecordWorld(e_recordSetJointTreeSolving, 1.0f);
+	}
+
+	if (world->GetShockPropagation())
+	{
+		RecordWorld(e_recordSetShockPropagation, 1.0f);
+	}
+
+	if (world->GetSpeculativeContacts())
+	{
+		RecordWorld(e_recordSetSpeculativeContacts, 1.0f);
+	}
+
+	if (world->GetManifoldReuse())
+	{
+		RecordWorld(e_recordSetManifoldReuse, 1.0f);
+	}
+}
+
+void b2Recorder::RecordStep(float32 timeStep, int32 velocityIterations, int32 positionIterations)
+{
+	Write((uint8)e_recordStep);
+	Write(timeStep);
+	Write(velocityIterations);
+	Write(positionIterations);
+}
+
+void b2Recorder::RecordWorld(b2RecordOp op, const float32* values, int32 count)
+{
+	Write((uint8)op);
+	WriteBytes(values, count * sizeof(float32));
+}
+
+void b2Recorder::RecordWorld(b2RecordOp op, float32 value)
+{
+	RecordWorld(op, &value, 1);
+}
+
+void b2Recorder::RecordCreateBody(uint32 id, const b2BodyDef* def)
+{
+	b2BodyDef bd = *def;
+	bd.userData = NULL;
+
+	Write((uint8)e_recordCreateBody);
+	Write(id);
+	Write(bd);
+}
+
+void b2Recorder::RecordCreateFixture(const b2Body* body, const b2FixtureDef* def)
+{
+	Write((uint8)e_recordCreateFixture);
+	Write(body->GetId());
+	WriteFixtureDef(def);
+}
+
+void b2Recorder::RecordCreateBodies(uint32 firstId, int32 bodyCount, const b2BodyDef* bodyDefs,
+									const int32* fixtureCounts, const b2FixtureDef* fixtureDefs)
+{
+	Write((uint8)e_recordCreateBodies);
+	Write(firstId);
+	Write(bodyCount);
+
+	int32 fixtureIndex = 0;
+	for (int32 i = 0; i < bodyCount; ++i)
+	{
+		b2BodyDef bd = bodyDefs[i];
+		bd.userData = NULL;
+		Write(bd);
+
+		int32 fixtureCount = fixtureCounts ? fixtureCounts[i] : 0;
+		Write(fixtureCount);
+		for (int32 j = 0; j < fixtureCount; ++j)
+		{
+			WriteFixtureDef(fixtureDefs + fixtureIndex);
+			++fixtureIndex;
+		}
+	}
+}
+
+void b2Recorder::RecordDestroyBodies(int32 bodyCount, b2Body* const* bodies)
+{
+	Write((uint8)e_recordDestroyBodies);
+	Write(bodyCount);
+	for (int32 i = 0; i < bodyCount; ++i)
+	{
+		Write(bodies[i]->GetId());
+	}
+}
+
+void b2Recorder::RecordCreateJoint(uint32 id, const b2JointDef* def)
+{
+	int32 size = b2GetJointDefSize(def->type);
+	b2Assert(size > 0);
+
+	uint32 joint1 = 0, joint2 = 0;
+	if (def->type == e_gearJoint)
+	{
+		const b2GearJointDef* gd = (const b2GearJointDef*)def;
+		joint1 = gd->joint1->GetId();
+		joint2 = gd->joint2->GetId();
+	}
+
+	Write((uint8)e_recordCreateJoint);
+	Write(id);
+	Write((uint8)def->type);
+	Write(def->bodyA->GetId());
+	Write(def->bodyB->GetId());
+	Write(joint1);
+	Write(joint2);
+
+	// Pointers in the definition are patched on replay.
+	WriteBytes(def, size);
+}
+
+void b2Recorder::RecordBody(b2RecordOp op, const b2Body* body, const float32* values, int32 count)
+{
+	Write((uint8)op);
+	Write(body->GetId());
+	WriteBytes(values, count * sizeof(float32));
+}
+
+void b2Recorder::RecordBody(b2RecordOp op, const b2Body* body, float32 value)
+{
+	RecordBody(op, body, &value, 1);
+}
+
+void b2Recorder::RecordBody(b2RecordOp op, const b2Body* body)
+{
+	RecordBody(op, body, NULL, 0);
+}
+
+void b2Recorder::RecordFixture(b2RecordOp op, const b2Fixture* fixture, const float32* values, int32 count)
+{
+	Write((uint8)op);
+	Write(fixture->GetBody()->GetId());
+	Write(b2GetFixtureIndex(fixture));
+	WriteBytes(values, count * sizeof(float32));
+}
+
+void b2Recorder::RecordJoint(b2RecordJointOp op, const b2Joint* joint, float32 value1, float32 value2)
+{
+	Write((uint8)e_recordSetJoint);
+	Write(joint->GetId());
+	Write((uint8)op);
+	Write(value1);
+	Write(value2);
+}
+
+void b2Recorder::RecordDestroyJoint(const b2Joint* joint)
+{
+	Write((uint8)e_recordDestroyJoint);
+	Write(joint->GetId());
+}
+
+void b2Recorder::RecordSnapshot(const void* data, int32 size)
+{
+	Write((uint8)e_recordApplySnapshot);
+	Write(size);
+	WriteBytes(data, size);
+}
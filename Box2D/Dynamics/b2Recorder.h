@@ -0,0 +1,222 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_RECORDER_H
+#define B2_RECORDER_H
+
+#include <Box2D/Common/b2Settings.h>
+#include <Box2D/Dynamics/b2World.h>
+#include <Box2D/Dynamics/Joints/b2Joint.h>
+
+class b2Body;
+class b2Fixture;
+class b2Shape;
+struct b2BodyDef;
+struct b2FixtureDef;
+
+const uint32 b2_recordMagic = 0x63723262;	// "b2rc"
+const uint32 b2_recordVersion = 9;
+
+/// Event codes of a recorded stream.
+enum b2RecordOp
+{
+	e_recordWorld = 1,
+	e_recordStep,
+	e_recordSetGravity,
+	e_recordSetAllowSleeping,
+	e_recordSetWarmStarting,
+	e_recordSetContinuousPhysics,
+	e_recordSetSubStepping,
+	e_recordSetAutoClearForces,
+	e_recordClearForces,
+
+	e_recordCreateBody,
+	e_recordDestroyBody,
+	e_recordSetType,
+	e_recordSetTransform,
+	e_recordSetLinearVelocity,
+	e_recordSetAngularVelocity,
+	e_recordApplyForce,
+	e_recordApplyForceToCenter,
+	e_recordApplyTorque,
+	e_recordApplyLinearImpulse,
+	e_recordApplyAngularImpulse,
+	e_recordSetMassData,
+	e_recordResetMassData,
+	e_recordSetLinearDamping,
+	e_recordSetAngularDamping,
+	e_recordSetGravityScale,
+	e_recordSetBullet,
+	e_recordSetSleepingAllowed,
+	e_recordSetAwake,
+	e_recordSetActive,
+	e_recordSetFixedRotation,
+
+	e_recordCreateFixture,
+	e_recordDestroyFixture,
+	e_recordSetSensor,
+	e_recordSetFilterData,
+	e_recordSetDensity,
+	e_recordSetFriction,
+	e_recordSetRestitution,
+
+	e_recordCreateJoint,
+	e_recordDestroyJoint,
+	e_recordSetJoint,
+
+	e_recordCreateBodies,
+	e_recordDestroyBodies,
+	e_recordClear,
+	e_recordSetSolverType,
+	e_recordSetJointTreeSolving,
+	e_recordSetShockPropagation,
+	e_recordSetSpeculativeContacts,
+	e_recordSetManifoldReuse,
+	e_recordApplySnapshot
+};
+
+/// Joint setters carried by e_recordSetJoint.
+enum b2RecordJointOp
+{
+	e_recordJointSetTarget = 1,
+	e_recordJointSetMaxForce,
+	e_recordJointSetMaxTorque,
+	e_recordJointSetFrequency,
+	e_recordJointSetDampingRatio,
+	e_recordJointSetLength,
+	e_recordJointSetRatio,
+	e_recordJointEnableLimit,
+	e_recordJointSetLimits,
+	e_recordJointEnableMotor,
+	e_recordJointSetMotorSpeed,
+	e_recordJointSetMaxMotorForce,
+	e_recordJointSetMaxMotorTorque,
+	e_recordJointSetSpringFrequency,
+	e_recordJointSetSpringDampingRatio
+};
+
+/// Get the size of the definition struct of a joint type.
+int32 b2GetJointDefSize(b2JointType type);
+
+/// A recorder logs world creation, every Create/Destroy/Set mutation and every
+/// Step call to a compact binary stream that b2Replayer can run headless.
+/// Snapshots applied with b2Snapshot::Apply are stored whole and applied again
+/// on replay. Bodies and joints are referenced by id and fixtures by their
+/// index in the fixture list of their body. Definitions are stored in the native layout, so
+/// a stream can only be replayed by a build of the same engine. User data and
+/// listeners are not recorded, nor are mutations made inside callbacks.
+class b2Recorder
+{
+public:
+	b2Recorder();
+	~b2Recorder();
+
+	/// Get the recorded stream.
+	const void* GetData() const;
+
+	/// Get the size of the recorded stream in bytes.
+	int32 GetSize() const;
+
+	/// Discard the recorded stream.
+	void Clear();
+
+	/// These are called by the engine.
+	void RecordWorld(const b2World* world);
+	void RecordStep(float32 timeStep, int32 velocityIterations, int32 positionIterations);
+	void RecordWorld(b2RecordOp op, const float32* values, int32 count);
+	void RecordWorld(b2RecordOp op, float32 value);
+	void RecordCreateBody(uint32 id, const b2BodyDef* def);
+	void RecordCreateFixture(const b2Body* body, const b2FixtureDef* def);
+	void RecordCreateBodies(uint32 firstId, int32 bodyCount, const b2BodyDef* bodyDefs,
+							const int32* fixtureCounts, const b2FixtureDef* fixtureDefs);
+	void RecordDestroyBodies(int32 bodyCount, b2Body* const* bodies);
+	void RecordCreateJoint(uint32 id, const b2JointDef* def);
+	void RecordBody(b2RecordOp op, const b2Body* body, const float32* values, int32 count);
+	void RecordBody(b2RecordOp op, const b2Body* body, float32 value);
+	void RecordBody(b2RecordOp op, const b2Body* body);
+	void RecordFixture(b2RecordOp op, const b2Fixture* fixture, const float32* values, int32 count);
+	void RecordJoint(b2RecordJointOp op, const b2Joint* joint, float32 value1, float32 value2 = 0.0f);
+	void RecordDestroyJoint(const b2Joint* joint);
+	void RecordSnapshot(const void* data, int32 size);
+
+private:
+
+	friend class b2RecordScope;
+
+	void Reserve(int32 size);
+	void WriteBytes(const void* data, int32 size);
+	void WriteShape(const b2Shape* shape);
+	void WriteFixtureDef(const b2FixtureDef* def);
+
+	template <typename T>
+	void Write(const T& value)
+	{
+		WriteBytes(&value, sizeof(T));
+	}
+
+	uint8* m_data;
+	int32 m_size;
+	int32 m_capacity;
+
+	int32 m_depth;
+};
+
+/// Guards one public call so the engine calls it makes internally are not
+/// recorded a second time. Nothing is recorded while the world is locked.
+class b2RecordScope
+{
+public:
+	b2RecordScope(const b2World* world)
+	{
+		m_recorder = world->IsLocked() ? NULL : world->GetRecorder();
+		if (m_recorder)
+		{
+			++m_recorder->m_depth;
+		}
+	}
+
+	~b2RecordScope()
+	{
+		if (m_recorder)
+		{
+			--m_recorder->m_depth;
+		}
+	}
+
+	/// Get the recorder if this is the outermost call, otherwise NULL.
+	b2Recorder* GetRecorder() const
+	{
+		return m_recorder && m_recorder->m_depth == 1 ? m_recorder : NULL;
+	}
+
+private:
+
+	b2Recorder* m_recorder;
+};
+
+inline const void* b2Recorder::GetData() const
+{
+	return m_data;
+}
+
+inline int32 b2Recorder::GetSize() const
+{
+	return m_size;
+}
+
+#endif
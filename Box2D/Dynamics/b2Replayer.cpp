@@ -0,0 +1,932 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <Box2D/Dynamics/b2Replayer.h>
+#include <Box2D/Dynamics/b2Recorder.h>
+#include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Dynamics/b2Fixture.h>
+#include <Box2D/Dynamics/b2Snapshot.h>
+#include <Box2D/Dynamics/b2World.h>
+#include <Box2D/Dynamics/Joints/b2DistanceJoint.h>
+#include <Box2D/Dynamics/Joints/b2FrictionJoint.h>
+#include <Box2D/Dynamics/Joints/b2GearJoint.h>
+#include <Box2D/Dynamics/Joints/b2MouseJoint.h>
+#include <Box2D/Dynamics/Joints/b2PrismaticJoint.h>
+#include <Box2D/Dynamics/Joints/b2RevoluteJoint.h>
+#include <Box2D/Dynamics/Joints/b2WheelJoint.h>
+#include <Box2D/Collision/Shapes/b2CircleShape.h>
+#include <Box2D/Collision/Shapes/b2EdgeShape.h>
+#include <Box2D/Collision/Shapes/b2ChainShape.h>
+#include <Box2D/Collision/Shapes/b2PolygonShape.h>
+#include <cstring>
+#include <new>
+
+b2Replayer::b2Replayer(const void* data, int32 size)
+{
+	m_data = (const uint8*)data;
+	m_size = size;
+	m_offset = 0;
+	m_error = false;
+
+	m_world = NULL;
+	m_stepCount = 0;
+
+	m_bodies = NULL;
+	m_bodyCapacity = 0;
+	m_joints = NULL;
+	m_jointCapacity = 0;
+
+	uint32 magic = Read<uint32>();
+	uint32 version = Read<uint32>();
+	if (magic != b2_recordMagic || version < 1 || version > b2_recordVersion)
+	{
+		m_error = true;
+	}
+}
+
+b2Replayer::~b2Replayer()
+{
+	delete m_world;
+	b2Free(m_bodies);
+	b2Free(m_joints);
+}
+
+void b2Replayer::ReadBytes(void* data, int32 size)
+{
+	if (m_error || m_offset + size > m_size)
+	{
+		m_error = true;
+		memset(data, 0, size);
+		return;
+	}
+
+	memcpy(data, m_data + m_offset, size);
+	m_offset += size;
+}
+
+void b2Replayer::ReadValues(float32* values, int32 count)
+{
+	ReadBytes(values, count * sizeof(float32));
+}
+
+b2Body* b2Replayer::GetBody(uint32 id)
+{
+	if (id >= (uint32)m_bodyCapacity || m_bodies[id] == NULL)
+	{
+		m_error = true;
+		return NULL;
+	}
+	return m_bodies[id];
+}
+
+b2Joint* b2Replayer::GetJoint(uint32 id)
+{
+	if (id >= (uint32)m_jointCapacity || m_joints[id] == NULL)
+	{
+		m_error = true;
+		return NULL;
+	}
+	return m_joints[id];
+}
+
+// Ids are assigned in creation order, so these arrays stay dense.
+void b2Replayer::SetBody(uint32 id, b2Body* body)
+{
+	if (id >= (uint32)m_bodyCapacity)
+	{
+		int32 capacity = b2Max(2 * m_bodyCapacity, (int32)id + 1);
+		b2Body** bodies = (b2Body**)b2Alloc(capacity * sizeof(b2Body*));
+		memset(bodies, 0, capacity * sizeof(b2Body*));
+		if (m_bodies)
+		{
+			memcpy(bodies, m_bodies, m_bodyCapacity * sizeof(b2Body*));
+			b2Free(m_bodies);
+		}
+		m_bodies = bodies;
+		m_bodyCapacity = capacity;
+	}
+	m_bodies[id] = body;
+}
+
+void b2Replayer::SetJoint(uint32 id, b2Joint* joint)
+{
+	if (id >= (uint32)m_jointCapacity)
+	{
+		int32 capacity = b2Max(2 * m_jointCapacity, (int32)id + 1);
+		b2Joint** joints = (b2Joint**)b2Alloc(capacity * sizeof(b2Joint*));
+		memset(joints, 0, capacity * sizeof(b2Joint*));
+		if (m_joints)
+		{
+			memcpy(joints, m_joints, m_jointCapacity * sizeof(b2Joint*));
+			b2Free(m_joints);
+		}
+		m_joints = joints;
+		m_jointCapacity = capacity;
+	}
+	m_joints[id] = joint;
+}
+
+b2Shape* b2Replayer::ReadShape()
+{
+	b2Shape::Type type = (b2Shape::Type)Read<uint8>();
+	float32 radius = Read<float32>();
+
+	b2Shape* shape = NULL;
+	switch (type)
+	{
+	case b2Shape::e_circle:
+		{
+			b2CircleShape* circle = new b2CircleShape;
+			circle->m_p = Read<b2Vec2>();
+			shape = circle;
+		}
+		break;
+
+	case b2Shape::e_edge:
+		{
+			b2EdgeShape* edge = new b2EdgeShape;
+			edge->m_vertex0 = Read<b2Vec2>();
+			edge->m_vertex1 = Read<b2Vec2>();
+			edge->m_vertex2 = Read<b2Vec2>();
+			edge->m_vertex3 = Read<b2Vec2>();
+			edge->m_hasVertex0 = Read<uint8>() != 0;
+			edge->m_hasVertex3 = Read<uint8>() != 0;
+			shape = edge;
+		}
+		break;
+
+	case b2Shape::e_polygon:
+		{
+			b2PolygonShape* polygon = new b2PolygonShape;
+			polygon->m_vertexCount = Read<int32>();
+			polygon->m_centroid = Read<b2Vec2>();
+			if (polygon->m_vertexCount < 0 || polygon->m_vertexCount > b2_maxPolygonVertices)
+			{
+				m_error = true;
+				polygon->m_vertexCount = 0;
+			}
+			ReadBytes(polygon->m_vertices, polygon->m_vertexCount * sizeof(b2Vec2));
+			ReadBytes(polygon->m_normals, polygon->m_vertexCount * sizeof(b2Vec2));
+			shape = polygon;
+		}
+		break;
+
+	case b2Shape::e_chain:
+		{
+			b2ChainShape* chain = new b2ChainShape;
+			int32 count = Read<int32>();
+			if (count < 0 || count * (int32)sizeof(b2Vec2) > m_size - m_offset)
+			{
+				m_error = true;
+				count = 0;
+			}
+			chain->m_count = count;
+			chain->m_vertices = (b2Vec2*)b2Alloc(b2Max(count, 1) * sizeof(b2Vec2));
+			ReadBytes(chain->m_vertices, count * sizeof(b2Vec2));
+			chain->m_prevVertex = Read<b2Vec2>();
+			chain->m_nextVertex = Read<b2Vec2>();
+			chain->m_hasPrevVertex = Read<uint8>() != 0;
+			chain->m_hasNextVertex = Read<uint8>() != 0;
+			shape = chain;
+		}
+		break;
+
+	default:
+		m_error = true;
+		return NULL;
+	}
+
+	shape->m_radius = radius;
+	return shape;
+}
+
+// Returns the shape of the definition, which the caller deletes.
+b2Shape* b2Replayer::ReadFixtureDef(b2FixtureDef* def)
+{
+	def->friction = Read<float32>();
+	def->restitution = Read<float32>();
+	def->density = Read<float32>();
+	def->isSensor = Read<uint8>() != 0;
+	def->filter = Read<b2Filter>();
+	def->shape = ReadShape();
+	return (b2Shape*)def->shape;
+}
+
+bool b2Replayer::Step()
+{
+	while (m_error == false && m_offset < m_size)
+	{
+		uint8 op = Read<uint8>();
+		if (Process(op))
+		{
+			return m_error == false;
+		}
+	}
+
+	return false;
+}
+
+// Returns true after a time step was taken.
+bool b2Replayer::Process(uint8 op)
+{
+	if (op != e_recordWorld && m_world == NULL)
+	{
+		m_error = true;
+		return false;
+	}
+
+	switch (op)
+	{
+	case e_recordWorld:
+		{
+			b2Vec2 gravity = Read<b2Vec2>();
+			delete m_world;
+			m_world = new b2World(gravity);
+			m_world->SetAllowSleeping(Read<uint8>() != 0);
+			m_world->SetWarmStarting(Read<uint8>() != 0);
+			m_world->SetContinuousPhysics(Read<uint8>() != 0);
+			m_world->SetSubStepping(Read<uint8>() != 0);
+			m_world->SetAutoClearForces(Read<uint8>() != 0);
+		}
+		return false;
+
+	case e_recordStep:
+		{
+			float32 timeStep = Read<float32>();
+			int32 velocityIterations = Read<int32>();
+			int32 positionIterations = Read<int32>();
+			if (m_error)
+			{
+				return false;
+			}
+			m_world->Step(timeStep, velocityIterations, positionIterations);
+			++m_stepCount;
+		}
+		return true;
+
+	case e_recordSetGravity:
+		m_world->SetGravity(Read<b2Vec2>());
+		return false;
+
+	case e_recordSetAllowSleeping:
+		m_world->SetAllowSleeping(Read<float32>() != 0.0f);
+		return false;
+
+	case e_recordSetWarmStarting:
+		m_world->SetWarmStarting(Read<float32>() != 0.0f);
+		return false;
+
+	case e_recordSetContinuousPhysics:
+		m_world->SetContinuousPhysics(Read<float32>() != 0.0f);
+		return false;
+
+	case e_recordSetSubStepping:
+		m_world->SetSubStepping(Read<float32>() != 0.0f);
+		return false;
+
+	case e_recordSetAutoClearForces:
+		m_world->SetAutoClearForces(Read<float32>() != 0.0f);
+		return false;
+
+	case e_recordSetSolverType:
+		m_world->SetSolverType((b2SolverType)(int32)Read<float32>());
+		return false;
+
+	case e_recordSetJointTreeSolving:
+		m_world->SetJointTreeSolving(Read<float32>() != 0.0f);
+		return false;
+
+	case e_recordSetShockPropagation:
+		m_world->SetShockPropagation(Read<float32>() != 0.0f);
+		return false;
+
+	case e_recordSetSpeculativeContacts:
+		m_world->SetSpeculativeContacts(Read<float32>() != 0.0f);
+		return false;
+
+	case e_recordSetManifoldReuse:
+		m_world->SetManifoldReuse(Read<float32>() != 0.0f);
+		return false;
+
+	case e_recordApplySnapshot:
+		{
+			int32 size = Read<int32>();
+			if (m_error || size < 0 || m_offset + size > m_size)
+			{
+				m_error = true;
+				return false;
+			}
+
+			b2Snapshot snapshot;
+			if (snapshot.SetData(m_data + m_offset, size) == false)
+			{
+				m_error = true;
+				return false;
+			}
+			m_offset += size;
+			snapshot.Apply(m_world);
+		}
+		return false;
+
+	case e_recordClearForces:
+		m_world->ClearForces();
+		return false;
+
+	case e_recordCreateBody:
+		{
+			uint32 id = Read<uint32>();
+			b2BodyDef bd = Read<b2BodyDef>();
+			if (m_error == false)
+			{
+				SetBody(id, m_world->CreateBody(&bd));
+			}
+		}
+		return false;
+
+	case e_recordCreateFixture:
+	case e_recordDestroyFixture:
+	case e_recordSetSensor:
+	case e_recordSetFilterData:
+	case e_recordSetDensity:
+	case e_recordSetFriction:
+	case e_recordSetRestitution:
+		ProcessFixture(op);
+		return false;
+
+	case e_recordCreateBodies:
+		ProcessCreateBodies();
+		return false;
+
+	case e_recordDestroyBodies:
+		ProcessDestroyBodies();
+		return false;
+
+	case e_recordClear:
+		m_world->Clear();
+		for (int32 i = 0; i < m_bodyCapacity; ++i)
+		{
+			m_bodies[i] = NULL;
+		}
+		for (int32 i = 0; i < m_jointCapacity; ++i)
+		{
+			m_joints[i] = NULL;
+		}
+		return false;
+
+	case e_recordCreateJoint:
+		{
+			uint32 id = Read<uint32>();
+			b2JointType type = (b2JointType)Read<uint8>();
+			uint32 bodyA = Read<uint32>();
+			uint32 bodyB = Read<uint32>();
+			uint32 joint1 = Read<uint32>();
+			uint32 joint2 = Read<uint32>();
+
+			int32 size = b2GetJointDefSize(type);
+			if (size == 0)
+			{
+				m_error = true;
+				return false;
+			}
+
+			b2JointDef* def = (b2JointDef*)b2Alloc(size);
+			ReadBytes(def, size);
+			def->userData = NULL;
+			def->bodyA = GetBody(bodyA);
+			def->bodyB = GetBody(bodyB);
+			if (type == e_gearJoint)
+			{
+				b2GearJointDef* gd = (b2GearJointDef*)def;
+				gd->joint1 = GetJoint(joint1);
+				gd->joint2 = GetJoint(joint2);
+			}
+
+			if (m_error == false)
+			{
+				SetJoint(id, m_world->CreateJoint(def));
+			}
+			b2Free(def);
+		}
+		return false;
+
+	case e_recordDestroyJoint:
+		{
+			uint32 id = Read<uint32>();
+			b2Joint* joint = GetJoint(id);
+			if (joint)
+			{
+				m_world->DestroyJoint(joint);
+				m_joints[id] = NULL;
+			}
+		}
+		return false;
+
+	case e_recordSetJoint:
+		{
+			b2Joint* joint = GetJoint(Read<uint32>());
+			uint8 jointOp = Read<uint8>();
+			float32 value1 = Read<float32>();
+			float32 value2 = Read<float32>();
+			if (joint)
+			{
+				ProcessJoint(joint, jointOp, value1, value2);
+			}
+		}
+		return false;
+
+	default:
+		if (op >= e_recordDestroyBody && op <= e_recordSetFixedRotation)
+		{
+			b2Body* body = GetBody(Read<uint32>());
+			if (body)
+			{
+				ProcessBody(op, body);
+			}
+			return false;
+		}
+
+		m_error = true;
+		return false;
+	}
+}
+
+void b2Replayer::ProcessBody(uint8 op, b2Body* body)
+{
+	float32 values[4];
+
+	switch (op)
+	{
+	case e_recordDestroyBody:
+		{
+			// Joints go down with the body.
+			for (b2JointEdge* je = body->GetJointList(); je; je = je->next)
+			{
+				uint32 id = je->joint->GetId();
+				if (id < (uint32)m_jointCapacity)
+				{
+					m_joints[id] = NULL;
+				}
+			}
+			m_bodies[body->GetId()] = NULL;
+			m_world->DestroyBody(body);
+		}
+		break;
+
+	case e_recordSetType:
+		body->SetType((b2BodyType)(int32)Read<float32>());
+		break;
+
+	case e_recordSetTransform:
+		ReadValues(values, 3);
+		body->SetTransform(b2Vec2(values[0], values[1]), values[2]);
+		break;
+
+	case e_recordSetLinearVelocity:
+		ReadValues(values, 2);
+		body->SetLinearVelocity(b2Vec2(values[0], values[1]));
+		break;
+
+	case e_recordSetAngularVelocity:
+		body->SetAngularVelocity(Read<float32>());
+		break;
+
+	case e_recordApplyForce:
+		ReadValues(values, 4);
+		body->ApplyForce(b2Vec2(values[0], values[1]), b2Vec2(values[2], values[3]));
+		break;
+
+	case e_recordApplyForceToCenter:
+		ReadValues(values, 2);
+		body->ApplyForceToCenter(b2Vec2(values[0], values[1]));
+		break;
+
+	case e_recordApplyTorque:
+		body->ApplyTorque(Read<float32>());
+		break;
+
+	case e_recordApplyLinearImpulse:
+		ReadValues(values, 4);
+		body->ApplyLinearImpulse(b2Vec2(values[0], values[1]), b2Vec2(values[2], values[3]));
+		break;
+
+	case e_recordApplyAngularImpulse:
+		body->ApplyAngularImpulse(Read<float32>());
+		break;
+
+	case e_recordSetMassData:
+		{
+			ReadValues(values, 4);
+			b2MassData massData;
+			massData.mass = values[0];
+			massData.center.Set(values[1], values[2]);
+			massData.I = values[3];
+			body->SetMassData(&massData);
+		}
+		break;
+
+	case e_recordResetMassData:
+		body->ResetMassData();
+		break;
+
+	case e_recordSetLinearDamping:
+		body->SetLinearDamping(Read<float32>());
+		break;
+
+	case e_recordSetAngularDamping:
+		body->SetAngularDamping(Read<float32>());
+		break;
+
+	case e_recordSetGravityScale:
+		body->SetGravityScale(Read<float32>());
+		break;
+
+	case e_recordSetBullet:
+		body->SetBullet(Read<float32>() != 0.0f);
+		break;
+
+	case e_recordSetSleepingAllowed:
+		body->SetSleepingAllowed(Read<float32>() != 0.0f);
+		break;
+
+	case e_recordSetAwake:
+		body->SetAwake(Read<float32>() != 0.0f);
+		break;
+
+	case e_recordSetActive:
+		body->SetActive(Read<float32>() != 0.0f);
+		break;
+
+	case e_recordSetFixedRotation:
+		body->SetFixedRotation(Read<float32>() != 0.0f);
+		break;
+
+	default:
+		m_error = true;
+		break;
+	}
+}
+
+void b2Replayer::ProcessCreateBodies()
+{
+	uint32 firstId = Read<uint32>();
+	int32 bodyCount = Read<int32>();
+	if (bodyCount < 0 || bodyCount * (int32)sizeof(b2BodyDef) > m_size - m_offset)
+	{
+		m_error = true;
+		return;
+	}
+
+	b2BodyDef* bodyDefs = (b2BodyDef*)b2Alloc(b2Max(bodyCount, 1) * sizeof(b2BodyDef));
+	int32* fixtureCounts = (int32*)b2Alloc(b2Max(bodyCount, 1) * sizeof(int32));
+	int32 fixtureCapacity = b2Max(bodyCount, 1);
+	b2FixtureDef* fixtureDefs = (b2FixtureDef*)b2Alloc(fixtureCapacity * sizeof(b2FixtureDef));
+	int32 fixtureCount = 0;
+
+	for (int32 i = 0; i < bodyCount && m_error == false; ++i)
+	{
+		bodyDefs[i] = Read<b2BodyDef>();
+		fixtureCounts[i] = Read<int32>();
+		if (fixtureCounts[i] < 0 || fixtureCounts[i] > m_size - m_offset)
+		{
+			m_error = true;
+			fixtureCounts[i] = 0;
+		}
+
+		for (int32 j = 0; j < fixtureCounts[i] && m_error == false; ++j)
+		{
+			if (fixtureCount == fixtureCapacity)
+			{
+				b2FixtureDef* oldDefs = fixtureDefs;
+				fixtureCapacity *= 2;
+				fixtureDefs = (b2FixtureDef*)b2Alloc(fixtureCapacity * sizeof(b2FixtureDef));
+				memcpy(fixtureDefs, oldDefs, fixtureCount * sizeof(b2FixtureDef));
+				b2Free(oldDefs);
+			}
+
+			b2FixtureDef* def = new (fixtureDefs + fixtureCount) b2FixtureDef;
+			++fixtureCount;
+			if (ReadFixtureDef(def) == NULL)
+			{
+				m_error = true;
+			}
+		}
+	}
+
+	if (m_error == false)
+	{
+		b2Body** bodies = (b2Body**)b2Alloc(b2Max(bodyCount, 1) * sizeof(b2Body*));
+		m_world->CreateBodies(bodyCount, bodyDefs, fixtureCounts, fixtureDefs, bodies, NULL);
+		for (int32 i = 0; i < bodyCount; ++i)
+		{
+			SetBody(firstId + i, bodies[i]);
+		}
+		b2Free(bodies);
+	}
+
+	for (int32 i = 0; i < fixtureCount; ++i)
+	{
+		delete fixtureDefs[i].shape;
+	}
+
+	b2Free(fixtureDefs);
+	b2Free(fixtureCounts);
+	b2Free(bodyDefs);
+}
+
+void b2Replayer::ProcessDestroyBodies()
+{
+	int32 bodyCount = Read<int32>();
+	if (bodyCount < 0 || bodyCount * (int32)sizeof(uint32) > m_size - m_offset)
+	{
+		m_error = true;
+		return;
+	}
+
+	b2Body** bodies = (b2Body**)b2Alloc(b2Max(bodyCount, 1) * sizeof(b2Body*));
+	for (int32 i = 0; i < bodyCount; ++i)
+	{
+		bodies[i] = GetBody(Read<uint32>());
+	}
+
+	if (m_error == false)
+	{
+		for (int32 i = 0; i < bodyCount; ++i)
+		{
+			// Joints go down with the body.
+			for (b2JointEdge* je = bodies[i]->GetJointList(); je; je = je->next)
+			{
+				uint32 id = je->joint->GetId();
+				if (id < (uint32)m_jointCapacity)
+				{
+					m_joints[id] = NULL;
+				}
+			}
+			m_bodies[bodies[i]->GetId()] = NULL;
+		}
+
+		m_world->DestroyBodies(bodyCount, bodies);
+	}
+
+	b2Free(bodies);
+}
+
+void b2Replayer::ProcessFixture(uint8 op)
+{
+	b2Body* body = GetBody(Read<uint32>());
+
+	if (op == e_recordCreateFixture)
+	{
+		b2FixtureDef fd;
+		b2Shape* shape = ReadFixtureDef(&fd);
+		if (m_error == false)
+		{
+			body->CreateFixture(&fd);
+		}
+		delete shape;
+		return;
+	}
+
+	uint32 index = Read<uint32>();
+	b2Fixture* fixture = body ? body->GetFixtureList() : NULL;
+	for (uint32 i = 0; i < index && fixture; ++i)
+	{
+		fixture = fixture->GetNext();
+	}
+
+	if (fixture == NULL)
+	{
+		m_error = true;
+		return;
+	}
+
+	float32 values[3];
+
+	switch (op)
+	{
+	case e_recordDestroyFixture:
+		body->DestroyFixture(fixture);
+		break;
+
+	case e_recordSetSensor:
+		fixture->SetSensor(Read<float32>() != 0.0f);
+		break;
+
+	case e_recordSetFilterData:
+		{
+			ReadValues(values, 3);
+			b2Filter filter;
+			filter.categoryBits = (uint16)values[0];
+			filter.maskBits = (uint16)values[1];
+			filter.groupIndex = (int16)values[2];
+			fixture->SetFilterData(filter);
+		}
+		break;
+
+	case e_recordSetDensity:
+		fixture->SetDensity(Read<float32>());
+		break;
+
+	case e_recordSetFriction:
+		fixture->SetFriction(Read<float32>());
+		break;
+
+	case e_recordSetRestitution:
+		fixture->SetRestitution(Read<float32>());
+		break;
+	}
+}
+
+void b2Replayer::ProcessJoint(b2Joint* joint, uint8 op, float32 value1, float32 value2)
+{
+	b2JointType type = joint->GetType();
+
+	switch (op)
+	{
+	case e_recordJointSetTarget:
+		if (type == e_mouseJoint)
+		{
+			((b2MouseJoint*)joint)->SetTarget(b2Vec2(value1, value2));
+			return;
+		}
+		break;
+
+	case e_recordJointSetMaxForce:
+		if (type == e_mouseJoint)
+		{
+			((b2MouseJoint*)joint)->SetMaxForce(value1);
+			return;
+		}
+		if (type == e_frictionJoint)
+		{
+			((b2FrictionJoint*)joint)->SetMaxForce(value1);
+			return;
+		}
+		break;
+
+	case e_recordJointSetMaxTorque:
+		if (type == e_frictionJoint)
+		{
+			((b2FrictionJoint*)joint)->SetMaxTorque(value1);
+			return;
+		}
+		break;
+
+	case e_recordJointSetFrequency:
+		if (type == e_mouseJoint)
+		{
+			((b2MouseJoint*)joint)->SetFrequency(value1);
+			return;
+		}
+		if (type == e_distanceJoint)
+		{
+			((b2DistanceJoint*)joint)->SetFrequency(value1);
+			return;
+		}
+		break;
+
+	case e_recordJointSetDampingRatio:
+		if (type == e_mouseJoint)
+		{
+			((b2MouseJoint*)joint)->SetDampingRatio(value1);
+			return;
+		}
+		if (type == e_distanceJoint)
+		{
+			((b2DistanceJoint*)joint)->SetDampingRatio(value1);
+			return;
+		}
+		break;
+
+	case e_recordJointSetLength:
+		if (type == e_distanceJoint)
+		{
+			((b2DistanceJoint*)joint)->SetLength(value1);
+			return;
+		}
+		break;
+
+	case e_recordJointSetRatio:
+		if (type == e_gearJoint)
+		{
+			((b2GearJoint*)joint)->SetRatio(value1);
+			return;
+		}
+		break;
+
+	case e_recordJointEnableLimit:
+		if (type == e_revoluteJoint)
+		{
+			((b2RevoluteJoint*)joint)->EnableLimit(value1 != 0.0f);
+			return;
+		}
+		if (type == e_prismaticJoint)
+		{
+			((b2PrismaticJoint*)joint)->EnableLimit(value1 != 0.0f);
+			return;
+		}
+		break;
+
+	case e_recordJointSetLimits:
+		if (type == e_revoluteJoint)
+		{
+			((b2RevoluteJoint*)joint)->SetLimits(value1, value2);
+			return;
+		}
+		if (type == e_prismaticJoint)
+		{
+			((b2PrismaticJoint*)joint)->SetLimits(value1, value2);
+			return;
+		}
+		break;
+
+	case e_recordJointEnableMotor:
+		if (type == e_revoluteJoint)
+		{
+			((b2RevoluteJoint*)joint)->EnableMotor(value1 != 0.0f);
+			return;
+		}
+		if (type == e_prismaticJoint)
+		{
+			((b2PrismaticJoint*)joint)->EnableMotor(value1 != 0.0f);
+			return;
+		}
+		if (type == e_wheelJoint)
+		{
+			((b2WheelJoint*)joint)->EnableMotor(value1 != 0.0f);
+			return;
+		}
+		break;
+
+	case e_recordJointSetMotorSpeed:
+		if (type == e_revoluteJoint)
+		{
+			((b2RevoluteJoint*)joint)->SetMotorSpeed(value1);
+			return;
+		}
+		if (type == e_prismaticJoint)
+		{
+			((b2PrismaticJoint*)joint)->SetMotorSpeed(value1);
+			return;
+		}
+		if (type == e_wheelJoint)
+		{
+			((b2WheelJoint*)joint)->SetMotorSpeed(value1);
+			return;
+		}
+		break;
+
+	case e_recordJointSetMaxMotorForce:
+		if (type == e_prismaticJoint)
+		{
+			((b2PrismaticJoint*)joint)->SetMaxMotorForce(value1);
+			return;
+		}
+		break;
+
+	case e_recordJointSetMaxMotorTorque:
+		if (type == e_revoluteJoint)
+		{
+			((b2RevoluteJoint*)joint)->SetMaxMotorTorque(value1);
+			return;
+		}
+		if (type == e_wheelJoint)
+		{
+			((b2WheelJoint*)joint)->SetMaxMotorTorque(value1);
+			return;
+		}
+		break;
+
+	case e_recordJointSetSpringFrequency:
+		if (type == e_wheelJoint)
+		{
+			((b2WheelJoint*)joint)->SetSpringFrequencyHz(value1);
+			return;
+		}
+		break;
+
+	case e_recordJointSetSpringDampingRatio:
+		if (type == e_wheelJoint)
+		{
+			((b2WheelJoint*)joint)->SetSpringDampingRatio(value1);
+			return;
+		}
+		break;
+	}
+
+	m_error = true;
+}
@@ -0,0 +1,110 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_REPLAYER_H
+#define B2_REPLAYER_H
+
+#include <Box2D/Common/b2Settings.h>
+
+class b2Body;
+class b2Joint;
+class b2Shape;
+class b2World;
+struct b2FixtureDef;
+
+/// Runs a stream written by b2Recorder against a fresh world. Each call to Step
+/// applies the recorded mutations up to and including the next recorded time
+/// step, so the profile of that step can be read from the world afterwards.
+class b2Replayer
+{
+public:
+	/// The stream is not copied and must remain in scope.
+	b2Replayer(const void* data, int32 size);
+	~b2Replayer();
+
+	/// Replay up to and including the next time step.
+	/// @return false when the stream is exhausted or malformed.
+	bool Step();
+
+	/// Get the replayed world. This is NULL until the world record is read.
+	b2World* GetWorld();
+
+	/// Get the number of time steps replayed so far.
+	int32 GetStepCount() const;
+
+	/// Did the stream contain an unknown event or end in the middle of one?
+	bool HasError() const;
+
+private:
+
+	void ReadBytes(void* data, int32 size);
+	b2Shape* ReadShape();
+	b2Shape* ReadFixtureDef(b2FixtureDef* def);
+
+	template <typename T>
+	T Read()
+	{
+		T value;
+		ReadBytes(&value, sizeof(T));
+		return value;
+	}
+
+	void ReadValues(float32* values, int32 count);
+
+	b2Body* GetBody(uint32 id);
+	b2Joint* GetJoint(uint32 id);
+	void SetBody(uint32 id, b2Body* body);
+	void SetJoint(uint32 id, b2Joint* joint);
+
+	bool Process(uint8 op);
+	void ProcessBody(uint8 op, b2Body* body);
+	void ProcessFixture(uint8 op);
+	void ProcessCreateBodies();
+	void ProcessDestroyBodies();
+	void ProcessJoint(b2Joint* joint, uint8 op, float32 value1, float32 value2);
+
+	const uint8* m_data;
+	int32 m_size;
+	int32 m_offset;
+	bool m_error;
+
+	b2World* m_world;
+	int32 m_stepCount;
+
+	b2Body** m_bodies;
+	int32 m_bodyCapacity;
+	b2Joint** m_joints;
+	int32 m_jointCapacity;
+};
+
+inline b2World* b2Replayer::GetWorld()
+{
+	return m_world;
+}
+
+inline int32 b2Replayer::GetStepCount() const
+{
+	return m_stepCount;
+}
+
+inline bool b2Replayer::HasError() const
+{
+	return m_error;
+}
+
+#endif
@@ -0,0 +1,326 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <Box2D/Dynamics/b2Snapshot.h>
+#include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Dynamics/b2Fixture.h>
+#include <Box2D/Dynamics/b2Recorder.h>
+#include <Box2D/Dynamics/b2World.h>
+#include <algorithm>
+#include <cstring>
+
+struct b2SnapshotHeader
+{
+	uint32 epoch;
+	uint32 baseEpoch;
+	int32 bodyCount;
+	float32 positionStep;
+	float32 velocityStep;
+};
+
+// Body records are packed without padding.
+const int32 b2_snapshotRecordSize = 4 + 2 * 4 + 4 * 2 + 1;
+
+enum
+{
+	e_snapshotAwake = 0x01
+};
+
+struct b2SnapshotBody
+{
+	uint32 id;
+	b2Body* body;
+};
+
+struct b2SnapshotBodyLessThan
+{
+	bool operator()(const b2SnapshotBody& a, const b2SnapshotBody& b) const
+	{
+		return a.id < b.id;
+	}
+};
+
+static int32 b2QuantizePosition(float32 x, float32 inv_step)
+{
+	float32 q = floorf(x * inv_step + 0.5f);
+	q = b2Clamp(q, -2147483520.0f, 2147483520.0f);
+	return (int32)q;
+}
+
+static int16 b2QuantizeVelocity(float32 v, float32 inv_step)
+{
+	float32 q = floorf(v * inv_step + 0.5f);
+	q = b2Clamp(q, -32767.0f, 32767.0f);
+	return (int16)q;
+}
+
+static int16 b2QuantizeAngle(float32 angle)
+{
+	// Wrap into [-pi, pi). The winding count is not preserved.
+	float32 a = angle - 2.0f * b2_pi * floorf((angle + b2_pi) / (2.0f * b2_pi));
+	float32 q = floorf(a * (32767.0f / b2_pi) + 0.5f);
+	q = b2Clamp(q, -32768.0f, 32767.0f);
+	return (int16)q;
+}
+
+b2Snapshot::b2Snapshot()
+{
+	m_data = NULL;
+	m_size = 0;
+	m_capacity = 0;
+	m_positionStep = 1.0f / 1024.0f;
+	m_velocityStep = 1.0f / 64.0f;
+}
+
+b2Snapshot::~b2Snapshot()
+{
+	b2Free(m_data);
+}
+
+void b2Snapshot::SetResolution(float32 positionStep, float32 velocityStep)
+{
+	b2Assert(positionStep > 0.0f && velocityStep > 0.0f);
+	m_positionStep = positionStep;
+	m_velocityStep = velocityStep;
+}
+
+void b2Snapshot::Reserve(int32 size)
+{
+	if (size <= m_capacity)
+	{
+		return;
+	}
+
+	int32 capacity = m_capacity > 0 ? m_capacity : 256;
+	while (capacity < size)
+	{
+		capacity *= 2;
+	}
+
+	uint8* data = (uint8*)b2Alloc(capacity);
+	if (m_data)
+	{
+		memcpy(data, m_data, m_size);
+		b2Free(m_data);
+	}
+	m_data = data;
+	m_capacity = capacity;
+}
+
+void b2Snapshot::Write(const b2World* world, uint32 sinceEpoch)
+{
+	b2Assert(world->IsLocked() == false);
+
+	Reserve(sizeof(b2SnapshotHeader) + world->m_bodyCount * b2_snapshotRecordSize);
+
+	float32 inv_positionStep = 1.0f / m_positionStep;
+	float32 inv_velocityStep = 1.0f / m_velocityStep;
+
+	uint8* p = m_data + sizeof(b2SnapshotHeader);
+	int32 count = 0;
+	for (const b2Body* b = world->m_bodyList; b; b = b->m_next)
+	{
+		if (b->m_changeEpoch <= sinceEpoch)
+		{
+			continue;
+		}
+
+		int32 x = b2QuantizePosition(b->m_xf.p.x, inv_positionStep);
+		int32 y = b2QuantizePosition(b->m_xf.p.y, inv_positionStep);
+		int16 q[4];
+		q[0] = b2QuantizeAngle(b->m_sweep.a);
+		q[1] = b2QuantizeVelocity(b->m_linearVelocity.x, inv_velocityStep);
+		q[2] = b2QuantizeVelocity(b->m_linearVelocity.y, inv_velocityStep);
+		q[3] = b2QuantizeVelocity(b->m_angularVelocity, inv_velocityStep);
+		uint8 flags = b->IsAwake() ? e_snapshotAwake : 0;
+
+		memcpy(p, &b->m_id, 4);
+		memcpy(p + 4, &x, 4);
+		memcpy(p + 8, &y, 4);
+		memcpy(p + 12, q, 8);
+		p[20] = flags;
+		p += b2_snapshotRecordSize;
+		++count;
+	}
+
+	b2SnapshotHeader header;
+	// Bodies may still change in the current epoch, so only the previous one
+	// is complete.
+	header.epoch = world->m_epoch - 1;
+	header.baseEpoch = sinceEpoch;
+	header.bodyCount = count;
+	header.positionStep = m_positionStep;
+	header.velocityStep = m_velocityStep;
+	memcpy(m_data, &header, sizeof(b2SnapshotHeader));
+	m_size = (int32)(p - m_data);
+}
+
+bool b2Snapshot::SetData(const void* data, int32 size)
+{
+	if (size < (int32)sizeof(b2SnapshotHeader))
+	{
+		return false;
+	}
+
+	b2SnapshotHeader header;
+	memcpy(&header, data, sizeof(b2SnapshotHeader));
+	if (header.bodyCount < 0 || size != (int32)sizeof(b2SnapshotHeader) + header.bodyCount * b2_snapshotRecordSize)
+	{
+		return false;
+	}
+
+	Reserve(size);
+	memcpy(m_data, data, size);
+	m_size = size;
+	return true;
+}
+
+uint32 b2Snapshot::GetEpoch() const
+{
+	if (m_size == 0)
+	{
+		return 0;
+	}
+
+	b2SnapshotHeader header;
+	memcpy(&header, m_data, sizeof(b2SnapshotHeader));
+	return header.epoch;
+}
+
+uint32 b2Snapshot::GetBaseEpoch() const
+{
+	if (m_size == 0)
+	{
+		return 0;
+	}
+
+	b2SnapshotHeader header;
+	memcpy(&header, m_data, sizeof(b2SnapshotHeader));
+	return header.baseEpoch;
+}
+
+int32 b2Snapshot::GetBodyCount() const
+{
+	if (m_size == 0)
+	{
+		return 0;
+	}
+
+	b2SnapshotHeader header;
+	memcpy(&header, m_data, sizeof(b2SnapshotHeader));
+	return header.bodyCount;
+}
+
+int32 b2Snapshot::Apply(b2World* world) const
+{
+	b2Assert(world->IsLocked() == false);
+	if (m_size == 0 || world->IsLocked())
+	{
+		return 0;
+	}
+
+	// The awake changes below are part of the snapshot and are not recorded
+	// on their own.
+	b2RecordScope scope(world);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordSnapshot(m_data, m_size);
+	}
+
+	b2SnapshotHeader header;
+	memcpy(&header, m_data, sizeof(b2SnapshotHeader));
+	if (header.bodyCount == 0 || world->m_bodyCount == 0)
+	{
+		return 0;
+	}
+
+	// Sort the bodies by id for lookup.
+	int32 bodyCount = world->m_bodyCount;
+	b2SnapshotBody* bodies = (b2SnapshotBody*)b2Alloc(bodyCount * sizeof(b2SnapshotBody));
+	int32 i = 0;
+	for (b2Body* b = world->m_bodyList; b; b = b->m_next, ++i)
+	{
+		bodies[i].id = b->m_id;
+		bodies[i].body = b;
+	}
+	std::sort(bodies, bodies + bodyCount, b2SnapshotBodyLessThan());
+
+	float32 angleStep = b2_pi / 32767.0f;
+	b2BroadPhase* broadPhase = &world->m_contactManager.m_broadPhase;
+
+	int32 applied = 0;
+	const uint8* p = m_data + sizeof(b2SnapshotHeader);
+	for (int32 n = 0; n < header.bodyCount; ++n, p += b2_snapshotRecordSize)
+	{
+		b2SnapshotBody key;
+		memcpy(&key.id, p, 4);
+		key.body = NULL;
+
+		b2SnapshotBody* it = std::lower_bound(bodies, bodies + bodyCount, key, b2SnapshotBodyLessThan());
+		if (it == bodies + bodyCount || it->id != key.id)
+		{
+			continue;
+		}
+
+		b2Body* b = it->body;
+
+		int32 x, y;
+		int16 q[4];
+		memcpy(&x, p + 4, 4);
+		memcpy(&y, p + 8, 4);
+		memcpy(q, p + 12, 8);
+		uint8 flags = p[20];
+
+		float32 angle = angleStep * q[0];
+		b->m_xf.p.Set(header.positionStep * x, header.positionStep * y);
+		b->m_xf.q.Set(angle);
+		b->m_sweep.c = b2Mul(b->m_xf, b->m_sweep.localCenter);
+		b->m_sweep.a = angle;
+		b->m_sweep.c0 = b->m_sweep.c;
+		b->m_sweep.a0 = angle;
+
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			f->Synchronize(broadPhase, b->m_xf, b->m_xf, b2Vec2_zero);
+		}
+
+		if (flags & e_snapshotAwake)
+		{
+			b->SetAwake(true);
+			if (b->m_type != b2_staticBody)
+			{
+				b->m_linearVelocity.Set(header.velocityStep * q[1], header.velocityStep * q[2]);
+				b->m_angularVelocity = header.velocityStep * q[3];
+			}
+		}
+		else
+		{
+			b->SetAwake(false);
+		}
+
+		b->SetChanged();
+		++applied;
+	}
+
+	b2Free(bodies);
+
+	// Defer contact creation until every body is in place.
+	world->m_contactManager.FindNewContacts();
+
+	return applied;
+}
@@ -0,0 +1,98 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_SNAPSHOT_H
+#define B2_SNAPSHOT_H
+
+#include <Box2D/Common/b2Settings.h>
+
+class b2World;
+
+/// A snapshot holds the quantized transforms and velocities of the bodies of a
+/// world that changed since a given epoch. Writing with an epoch of zero captures
+/// every body. A receiver applies the snapshot to a world containing bodies with
+/// matching ids. Bodies are matched by b2Body::GetId. The data uses the native
+/// byte order.
+class b2Snapshot
+{
+public:
+	b2Snapshot();
+	~b2Snapshot();
+
+	/// Set the quantization steps. Positions are stored as 32 bit multiples of
+	/// the position step. Linear and angular velocities are stored as 16 bit
+	/// multiples of the velocity step and are clamped to that range.
+	void SetResolution(float32 positionStep, float32 velocityStep);
+
+	/// Capture the bodies that changed after the given epoch. The world is not
+	/// modified. Pass GetEpoch() to the next call to get the next delta.
+	/// @warning this should be called outside of a time step.
+	void Write(const b2World* world, uint32 sinceEpoch);
+
+	/// Load snapshot data received from elsewhere.
+	/// @return false if the data is malformed.
+	bool SetData(const void* data, int32 size);
+
+	/// Apply the snapshot to a world. Records without a matching body are ignored.
+	/// @return the number of bodies updated.
+	/// @warning this should be called outside of a time step.
+	int32 Apply(b2World* world) const;
+
+	/// Get the raw snapshot data.
+	const void* GetData() const;
+
+	/// Get the size of the snapshot data in bytes.
+	int32 GetSize() const;
+
+	/// Get the last world epoch this snapshot covers completely. Bodies can
+	/// still change in the epoch the world is in, so the next delta written
+	/// against this one sends them again.
+	/// @return zero if nothing was written or loaded yet.
+	uint32 GetEpoch() const;
+
+	/// Get the epoch this snapshot is a delta against.
+	/// @return zero if nothing was written or loaded yet.
+	uint32 GetBaseEpoch() const;
+
+	/// Get the number of body records.
+	/// @return zero if nothing was written or loaded yet.
+	int32 GetBodyCount() const;
+
+private:
+
+	void Reserve(int32 size);
+
+	uint8* m_data;
+	int32 m_size;
+	int32 m_capacity;
+
+	float32 m_positionStep;
+	float32 m_velocityStep;
+};
+
+inline const void* b2Snapshot::GetData() const
+{
+	return m_data;
+}
+
+inline int32 b2Snapshot::GetSize() const
+{
+	return m_size;
+}
+
+#endif
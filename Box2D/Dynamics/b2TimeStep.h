@@ -34,6 +34,91 @@ struct b2Profile
 	float32 solveTOI;
 };
 
+/// Accumulated times of one profile phase. Times are in nanoseconds.
+struct b2ProfileStat
+{
+	int64 min;
+	int64 max;
+	int64 total;	///< divide by b2ProfileStats::stepCount for the average
+};
+
+/// Profile statistics of the steps since the last reset. The phases
+/// match the fields of b2Profile.
+struct b2ProfileStats
+{
+	int32 stepCount;
+	b2ProfileStat step;
+	b2ProfileStat collide;
+	b2ProfileStat solve;
+	b2ProfileStat solveInit;
+	b2ProfileStat solveVelocity;
+	b2ProfileStat solvePosition;
+	b2ProfileStat broadphase;
+	b2ProfileStat solveTOI;
+};
+
+/// Number of buckets in b2Metrics::islandSizes. Bucket i counts islands with
+/// [2^i, 2^(i+1)) bodies and the last bucket also counts all larger islands.
+const int32 b2_islandHistogramSize = 8;
+
+/// Counts of the work done by the last time step. The GJK and TOI counts are
+/// taken from process wide counters, so they mix when worlds step concurrently.
+struct b2Metrics
+{
+	int32 contactsCreated;
+	int32 contactsDestroyed;
+	int32 contactsTouching;		///< at the end of the step
+	int32 pairsFound;			///< broad-phase pairs, including existing contacts
+	int32 pairsBuffered;		///< largest pair buffer fill, duplicates included
+	int32 proxiesMoved;
+	int32 proxiesReinserted;	///< moves that left the fat AABB
+	int32 contactPointsCached;	///< lost points stored in the contact cache
+	int32 contactPointsRestored;	///< new points warm started from the contact cache
+	int32 manifoldsReused;		///< contacts that kept their manifold
+	int32 islands;
+	int32 islandSizes[b2_islandHistogramSize];
+	int32 bodiesAwake;			///< active non-static bodies awake at the end of the step
+	int32 toiEvents;
+	int32 gjkCalls;
+	int32 gjkIters;
+	int32 gjkMaxIters;
+	int32 toiCalls;
+	int32 toiIters;
+	int32 toiMaxIters;
+	int32 blockAllocatorBytes;	///< bytes held in block allocator chunks
+	int32 stackAllocatorPeak;	///< largest stack allocation so far
+	int32 stackAllocatorCapacity;
+	int32 stackAllocatorGrowths;	///< buffer growths during the step
+	int32 blockAllocatorGrowths;	///< chunks added during the step
+	int32 broadPhaseGrowths;		///< tree and buffer growths during the step
+};
+
+/// This is an internal structure. The phase times of one step in
+/// nanoseconds, one for each field of b2Profile.
+struct b2StepTimes
+{
+	int64 step;
+	int64 collide;
+	int64 solve;
+	int64 solveInit;
+	int64 solveVelocity;
+	int64 solvePosition;
+	int64 broadphase;
+	int64 solveTOI;
+};
+
+/// The island solvers of b2World::Step.
+enum b2SolverType
+{
+	/// Sequential impulses followed by a separate position solver.
+	b2_sequentialImpulseSolver,
+
+	/// Sub-steps with soft contacts and relaxation. The velocity iterations
+	/// passed to b2World::Step are the sub-step count and the position
+	/// iterations only correct joints.
+	b2_softStepSolver
+};
+
 /// This is an internal structure.
 struct b2TimeStep
 {
@@ -43,6 +128,10 @@ struct b2TimeStep
 	int32 velocityIterations;
 	int32 positionIterations;
 	bool warmStarting;
+	b2SolverType solverType;
+	bool jointTrees;
+	bool shockPropagation;
+	bool speculativeContacts;
 };
 
 /// This is an internal structure.
@@ -20,8 +20,25 @@
 #include <Box2D/Dynamics/b2Body.h>
 #include <Box2D/Dynamics/b2Fixture.h>
 #include <Box2D/Dynamics/b2Island.h>
+#include <Box2D/Dynamics/b2Recorder.h>
+#include <Box2D/Dynamics/Joints/b2DistanceJoint.h>
+#include <Box2D/Dynamics/Joints/b2FrictionJoint.h>
+#include <Box2D/Dynamics/Joints/b2GearJoint.h>
+#include <Box2D/Dynamics/Joints/b2MouseJoint.h>
+#include <Box2D/Dynamics/Joints/b2PrismaticJoint.h>
 #include <Box2D/Dynamics/Joints/b2PulleyJoint.h>
+#include <Box2D/Dynamics/Joints/b2RevoluteJoint.h>
+#include <Box2D/Dynamics/Joints/b2RopeJoint.h>
+#include <Box2D/Dynamics/Joints/b2WeldJoint.h>
+#include <Box2D/Dynamics/Joints/b2WheelJoint.h>
 #include <Box2D/Dynamics/Contacts/b2Contact.h>
+#include <Box2D/Dynamics/Contacts/b2ChainAndCircleContact.h>
+#include <Box2D/Dynamics/Contacts/b2ChainAndPolygonContact.h>
+#include <Box2D/Dynamics/Contacts/b2CircleContact.h>
+#include <Box2D/Dynamics/Contacts/b2EdgeAndCircleContact.h>
+#include <Box2D/Dynamics/Contacts/b2EdgeAndPolygonContact.h>
+#include <Box2D/Dynamics/Contacts/b2PolygonAndCircleContact.h>
+#include <Box2D/Dynamics/Contacts/b2PolygonContact.h>
 #include <Box2D/Dynamics/Contacts/b2ContactSolver.h>
 #include <Box2D/Collision/b2Collision.h>
 #include <Box2D/Collision/b2BroadPhase.h>
@@ -32,12 +49,22 @@
 #include <Box2D/Collision/b2TimeOfImpact.h>
 #include <Box2D/Common/b2Draw.h>
 #include <Box2D/Common/b2Timer.h>
+#include <Box2D/Common/b2Trace.h>
 #include <new>
 
-b2World::b2World(const b2Vec2& gravity)
+// Process wide iteration counters maintained by b2Distance and b2TimeOfImpact.
+extern int32 b2_gjkCalls, b2_gjkIters, b2_gjkMaxIters;
+extern int32 b2_toiCalls, b2_toiIters, b2_toiMaxIters;
+
+b2World::b2World(const b2Vec2& gravity, b2Allocator* allocator)
+	: m_allocator(allocator ? allocator : &b2_defaultAllocator),
+	m_blockAllocator(&m_allocator),
+	m_stackAllocator(&m_allocator),
+	m_contactManager(&m_allocator)
 {
 	m_destructionListener = NULL;
 	m_debugDraw = NULL;
+	m_recorder = NULL;
 
 	m_bodyList = NULL;
 	m_jointList = NULL;
@@ -45,9 +72,18 @@ b2World::b2World(const b2Vec2& gravity)
 	m_bodyCount = 0;
 	m_jointCount = 0;
 
+	m_epoch = 1;
+	m_bodyIdCount = 0;
+	m_jointIdCount = 0;
+
 	m_warmStarting = true;
 	m_continuousPhysics = true;
 	m_subStepping = false;
+	m_solverType = b2_sequentialImpulseSolver;
+	m_jointTreeSolving = false;
+	m_shockPropagation = false;
+	m_speculativeContacts = false;
+	m_manifoldReuse = false;
 
 	m_stepComplete = true;
 
@@ -59,8 +95,14 @@ b2World::b2World(const b2Vec2& gravity)
 	m_inv_dt0 = 0.0f;
 
 	m_contactManager.m_allocator = &m_blockAllocator;
+	m_contactManager.m_metrics = &m_metrics;
 
 	memset(&m_profile, 0, sizeof(b2Profile));
+	memset(&m_stepTimes, 0, sizeof(b2StepTimes));
+	memset(&m_profileStats, 0, sizeof(b2ProfileStats));
+	memset(&m_metrics, 0, sizeof(b2Metrics));
+
+	m_growthBase = 0;
 }
 
 b2World::~b2World()
@@ -84,6 +126,322 @@ b2World::~b2World()
 	}
 }
 
+// Block counts by size class for b2World::Reserve. An object that may take
+// one of several sizes needs the largest count in each class it can land in,
+// while different objects in one class add up.
+struct b2BlockCounts
+{
+	b2BlockCounts()
+	{
+		memset(counts, 0, sizeof(counts));
+		memset(pending, 0, sizeof(pending));
+	}
+
+	// Count objects that may take the given size.
+	void Add(int32 size, int32 count)
+	{
+		int32 index = b2BlockAllocator::GetSizeClass(size);
+		if (index != -1)
+		{
+			pending[index] = b2Max(pending[index], count);
+		}
+	}
+
+	// Close one kind of object.
+	void Commit()
+	{
+		for (int32 i = 0; i < b2_blockSizes; ++i)
+		{
+			counts[i] += pending[i];
+			pending[i] = 0;
+		}
+	}
+
+	int32 counts[b2_blockSizes];
+	int32 pending[b2_blockSizes];
+};
+
+void b2World::Reserve(const b2WorldCapacity& capacity)
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return;
+	}
+
+	int32 shapeSizes[b2Shape::e_typeCount];
+	shapeSizes[b2Shape::e_circle] = sizeof(b2CircleShape);
+	shapeSizes[b2Shape::e_edge] = sizeof(b2EdgeShape);
+	shapeSizes[b2Shape::e_polygon] = sizeof(b2PolygonShape);
+	shapeSizes[b2Shape::e_chain] = sizeof(b2ChainShape);
+
+	int32 jointSizes[b2_jointTypeCount];
+	jointSizes[e_unknownJoint] = 0;
+	jointSizes[e_revoluteJoint] = sizeof(b2RevoluteJoint);
+	jointSizes[e_prismaticJoint] = sizeof(b2PrismaticJoint);
+	jointSizes[e_distanceJoint] = sizeof(b2DistanceJoint);
+	jointSizes[e_pulleyJoint] = sizeof(b2PulleyJoint);
+	jointSizes[e_mouseJoint] = sizeof(b2MouseJoint);
+	jointSizes[e_gearJoint] = sizeof(b2GearJoint);
+	jointSizes[e_wheelJoint] = sizeof(b2WheelJoint);
+	jointSizes[e_weldJoint] = sizeof(b2WeldJoint);
+	jointSizes[e_frictionJoint] = sizeof(b2FrictionJoint);
+	jointSizes[e_ropeJoint] = sizeof(b2RopeJoint);
+
+	const int32 contactSizes[] =
+	{
+		sizeof(b2CircleContact),
+		sizeof(b2PolygonAndCircleContact),
+		sizeof(b2PolygonContact),
+		sizeof(b2EdgeAndCircleContact),
+		sizeof(b2EdgeAndPolygonContact),
+		sizeof(b2ChainAndCircleContact),
+		sizeof(b2ChainAndPolygonContact)
+	};
+
+	b2BlockCounts blocks;
+	blocks.Add(sizeof(b2Body), capacity.bodyCount);
+	blocks.Commit();
+
+	int32 typedShapeCount = 0;
+	for (int32 i = 0; i < b2Shape::e_typeCount; ++i)
+	{
+		typedShapeCount += capacity.shapeCounts[i];
+	}
+
+	int32 fixtureCount = b2Max(capacity.fixtureCount, typedShapeCount);
+	blocks.Add(sizeof(b2Fixture), fixtureCount);
+	blocks.Commit();
+
+	// Chains keep their proxies in an array as long as the chain.
+	int32 proxyArrayCount = fixtureCount;
+	if (typedShapeCount > 0)
+	{
+		for (int32 i = 0; i < b2Shape::e_typeCount; ++i)
+		{
+			blocks.Add(shapeSizes[i], capacity.shapeCounts[i]);
+			blocks.Commit();
+		}
+		proxyArrayCount -= capacity.shapeCounts[b2Shape::e_chain];
+	}
+	else
+	{
+		for (int32 i = 0; i < b2Shape::e_typeCount; ++i)
+		{
+			blocks.Add(shapeSizes[i], fixtureCount);
+		}
+		blocks.Commit();
+	}
+
+	blocks.Add(sizeof(b2FixtureProxy), proxyArrayCount);
+	blocks.Commit();
+
+	for (int32 i = 0; i < int32(sizeof(contactSizes) / sizeof(contactSizes[0])); ++i)
+	{
+		blocks.Add(contactSizes[i], capacity.contactCount);
+	}
+	blocks.Commit();
+
+	int32 typedJointCount = 0;
+	for (int32 i = 0; i < b2_jointTypeCount; ++i)
+	{
+		typedJointCount += capacity.jointCounts[i];
+	}
+
+	int32 newJointCount = b2Max(capacity.jointCount, typedJointCount);
+	if (typedJointCount > 0)
+	{
+		for (int32 i = 0; i < b2_jointTypeCount; ++i)
+		{
+			blocks.Add(jointSizes[i], capacity.jointCounts[i]);
+			blocks.Commit();
+		}
+	}
+	else
+	{
+		for (int32 i = 0; i < b2_jointTypeCount; ++i)
+		{
+			blocks.Add(jointSizes[i], newJointCount);
+		}
+		blocks.Commit();
+	}
+
+	m_blockAllocator.Reserve(blocks.counts);
+
+	// A pair is found from both of its proxies when both have moved.
+	int32 proxyCount = capacity.proxyCount > 0 ? capacity.proxyCount : fixtureCount;
+	int32 pairCount = capacity.pairCount;
+	if (pairCount == 0)
+	{
+		pairCount = 2 * (m_contactManager.m_contactCount + capacity.contactCount);
+	}
+	m_contactManager.m_broadPhase.Reserve(proxyCount, pairCount);
+
+	// The island solver takes everything from the stack at once when
+	// the whole world forms a single island.
+	int32 bodyCount = m_bodyCount + capacity.bodyCount;
+	int32 contactCount = m_contactManager.m_contactCount + capacity.contactCount;
+	int32 jointCount = m_jointCount + newJointCount;
+	int32 stackSize = bodyCount * (2 * sizeof(b2Body*) + sizeof(b2Velocity) + sizeof(b2Position) + sizeof(int32));
+	stackSize += contactCount * sizeof(b2Contact*) + b2ContactSolver::GetStackSize(contactCount);
+	stackSize += jointCount * sizeof(b2Joint*);
+	m_stackAllocator.Reserve(stackSize);
+
+	m_growthBase += GetGrowthCount();
+}
+
+int32 b2World::Trim()
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return 0;
+	}
+
+	return m_blockAllocator.Trim();
+}
+
+int32 b2World::GetGrowthCount() const
+{
+	int32 count = m_blockAllocator.GetGrowthCount();
+	count += m_stackAllocator.GetGrowthCount();
+	count += m_contactManager.m_broadPhase.GetGrowthCount();
+	return count - m_growthBase;
+}
+
+b2World* b2World::Clone() const
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return NULL;
+	}
+
+	b2World* world = new b2World(m_gravity, m_allocator.GetAllocator());
+	world->m_blockAllocator.CopyFrom(m_blockAllocator);
+	b2BlockRelocator relocator(&m_blockAllocator, &world->m_blockAllocator);
+
+	world->m_flags = m_flags;
+	world->m_bodyList = relocator.Relocate(m_bodyList);
+	world->m_jointList = relocator.Relocate(m_jointList);
+	world->m_bodyCount = m_bodyCount;
+	world->m_jointCount = m_jointCount;
+	world->m_epoch = m_epoch;
+	world->m_bodyIdCount = m_bodyIdCount;
+	world->m_jointIdCount = m_jointIdCount;
+	world->m_allowSleep = m_allowSleep;
+	world->m_inv_dt0 = m_inv_dt0;
+	world->m_warmStarting = m_warmStarting;
+	world->m_continuousPhysics = m_continuousPhysics;
+	world->m_subStepping = m_subStepping;
+	world->m_solverType = m_solverType;
+	world->m_jointTreeSolving = m_jointTreeSolving;
+	world->m_shockPropagation = m_shockPropagation;
+	world->m_speculativeContacts = m_speculativeContacts;
+	world->m_manifoldReuse = m_manifoldReuse;
+	world->m_stepComplete = m_stepComplete;
+	world->m_profile = m_profile;
+	world->m_profileStats = m_profileStats;
+	world->m_metrics = m_metrics;
+
+	b2ContactManager* contactManager = &world->m_contactManager;
+	contactManager->m_broadPhase.CopyFrom(m_contactManager.m_broadPhase);
+	contactManager->m_contactCache = m_contactManager.m_contactCache;
+	contactManager->m_contactList = relocator.Relocate(m_contactManager.m_contactList);
+	for (int32 i = 0; i < b2_contactPairTypeCount; ++i)
+	{
+		contactManager->m_pairTypeLists[i] = relocator.Relocate(m_contactManager.m_pairTypeLists[i]);
+	}
+	contactManager->m_contactCount = m_contactManager.m_contactCount;
+	contactManager->m_contactFilter = m_contactManager.m_contactFilter;
+
+	for (b2Body* b = world->m_bodyList; b; b = b->m_next)
+	{
+		b->m_world = world;
+		b->m_prev = relocator.Relocate(b->m_prev);
+		b->m_next = relocator.Relocate(b->m_next);
+		b->m_fixtureList = relocator.Relocate(b->m_fixtureList);
+		b->m_jointList = relocator.Relocate(b->m_jointList);
+		b->m_contactList = relocator.Relocate(b->m_contactList);
+
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			f->m_body = b;
+			f->m_next = relocator.Relocate(f->m_next);
+			f->m_shape = relocator.Relocate(f->m_shape);
+
+			// Chain vertices and proxy arrays that are too large for the
+			// chunks bypass the block allocator, so they are copied here.
+			// Shared shapes live outside the world and are referenced again.
+			if (f->m_sharedShape)
+			{
+				f->m_sharedShape->Retain();
+			}
+			else if (f->m_shape->m_type == b2Shape::e_chain)
+			{
+				b2ChainShape* chain = (b2ChainShape*)f->m_shape;
+				int32 vertexSize = chain->m_count * sizeof(b2Vec2);
+				if (vertexSize > b2_maxBlockSize)
+				{
+					b2Vec2* vertices = (b2Vec2*)world->m_blockAllocator.Allocate(vertexSize, e_allocTagShape);
+					memcpy(vertices, chain->m_vertices, vertexSize);
+					chain->m_vertices = vertices;
+				}
+				else
+				{
+					chain->m_vertices = relocator.Relocate(chain->m_vertices);
+				}
+				chain->m_allocator = &world->m_blockAllocator;
+			}
+
+			int32 childCount = f->m_shape->GetChildCount();
+			int32 proxySize = childCount * sizeof(b2FixtureProxy);
+			if (proxySize > b2_maxBlockSize)
+			{
+				b2FixtureProxy* proxies = (b2FixtureProxy*)world->m_blockAllocator.Allocate(proxySize, e_allocTagProxy);
+				memcpy(proxies, f->m_proxies, proxySize);
+				f->m_proxies = proxies;
+			}
+			else
+			{
+				f->m_proxies = relocator.Relocate(f->m_proxies);
+			}
+
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				b2FixtureProxy* proxy = f->m_proxies + i;
+				proxy->fixture = f;
+				contactManager->m_broadPhase.SetUserData(proxy->proxyId, proxy);
+			}
+		}
+	}
+
+	for (b2Contact* c = contactManager->m_contactList; c; c = c->m_next)
+	{
+		c->m_prev = relocator.Relocate(c->m_prev);
+		c->m_next = relocator.Relocate(c->m_next);
+		c->m_fixtureA = relocator.Relocate(c->m_fixtureA);
+		c->m_fixtureB = relocator.Relocate(c->m_fixtureB);
+
+		c->m_nodeA.contact = c;
+		c->m_nodeA.other = relocator.Relocate(c->m_nodeA.other);
+		c->m_nodeA.prev = relocator.Relocate(c->m_nodeA.prev);
+		c->m_nodeA.next = relocator.Relocate(c->m_nodeA.next);
+
+		c->m_nodeB.contact = c;
+		c->m_nodeB.other = relocator.Relocate(c->m_nodeB.other);
+		c->m_nodeB.prev = relocator.Relocate(c->m_nodeB.prev);
+		c->m_nodeB.next = relocator.Relocate(c->m_nodeB.next);
+	}
+
+	for (b2Joint* j = world->m_jointList; j; j = j->m_next)
+	{
+		j->Relocate(relocator);
+	}
+
+	return world;
+}
+
 void b2World::SetDestructionListener(b2DestructionListener* listener)
 {
 	m_destructionListener = listener;
@@ -104,6 +462,20 @@ void b2World::SetDebugDraw(b2Draw* debugDraw)
 	m_debugDraw = debugDraw;
 }
 
+void b2World::SetRecorder(b2Recorder* recorder)
+{
+	b2Assert(IsLocked() == false);
+
+	// Replays rely on ids being assigned from zero.
+	b2Assert(recorder == NULL || (m_bodyIdCount == 0 && m_jointIdCount == 0));
+
+	m_recorder = recorder;
+	if (m_recorder)
+	{
+		m_recorder->RecordWorld(this);
+	}
+}
+
 b2Body* b2World::CreateBody(const b2BodyDef* def)
 {
 	b2Assert(IsLocked() == false);
@@ -112,8 +484,15 @@ b2Body* b2World::CreateBody(const b2BodyDef* def)
 		return NULL;
 	}
 
-	void* mem = m_blockAllocator.Allocate(sizeof(b2Body));
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordCreateBody(m_bodyIdCount, def);
+	}
+
+	void* mem = m_blockAllocator.Allocate(sizeof(b2Body), e_allocTagBody);
 	b2Body* b = new (mem) b2Body(def, this);
+	b->m_id = m_bodyIdCount++;
 
 	// Add to world doubly linked list.
 	b->m_prev = NULL;
@@ -137,6 +516,270 @@ void b2World::DestroyBody(b2Body* b)
 		return;
 	}
 
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordBody(e_recordDestroyBody, b);
+	}
+
+	DestroyConnections(b);
+
+	// Destroy the broad-phase proxies of the fixtures.
+	for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+	{
+		if (m_destructionListener)
+		{
+			m_destructionListener->SayGoodbye(f);
+		}
+
+		f->DestroyProxies(&m_contactManager.m_broadPhase);
+	}
+
+	FreeBody(b);
+}
+
+void b2World::CreateBodies(int32 bodyCount, const b2BodyDef* bodyDefs, const int32* fixtureCounts,
+						   const b2FixtureDef* fixtureDefs, b2Body** bodies, b2Fixture** fixtures)
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return;
+	}
+
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordCreateBodies(m_bodyIdCount, bodyCount, bodyDefs, fixtureCounts, fixtureDefs);
+	}
+
+	// Count the proxies of the active bodies, so they can be inserted in one batch.
+	int32 proxyCount = 0;
+	int32 fixtureCount = 0;
+	for (int32 i = 0; i < bodyCount; ++i)
+	{
+		int32 count = fixtureCounts ? fixtureCounts[i] : 0;
+		if (bodyDefs[i].active)
+		{
+			for (int32 j = 0; j < count; ++j)
+			{
+				const b2FixtureDef* def = fixtureDefs + fixtureCount + j;
+				const b2Shape* shape = def->sharedShape ? def->sharedShape->GetShape() : def->shape;
+				proxyCount += shape->GetChildCount();
+			}
+		}
+		fixtureCount += count;
+	}
+
+	b2AABB* aabbs = (b2AABB*)m_stackAllocator.Allocate(proxyCount * sizeof(b2AABB));
+	void** userData = (void**)m_stackAllocator.Allocate(proxyCount * sizeof(void*));
+	int32* proxyIds = (int32*)m_stackAllocator.Allocate(proxyCount * sizeof(int32));
+
+	proxyCount = 0;
+	fixtureCount = 0;
+	for (int32 i = 0; i < bodyCount; ++i)
+	{
+		void* mem = m_blockAllocator.Allocate(sizeof(b2Body), e_allocTagBody);
+		b2Body* b = new (mem) b2Body(bodyDefs + i, this);
+		b->m_id = m_bodyIdCount++;
+
+		// Add to world doubly linked list.
+		b->m_prev = NULL;
+		b->m_next = m_bodyList;
+		if (m_bodyList)
+		{
+			m_bodyList->m_prev = b;
+		}
+		m_bodyList = b;
+		++m_bodyCount;
+
+		bool hasMass = false;
+		int32 count = fixtureCounts ? fixtureCounts[i] : 0;
+		for (int32 j = 0; j < count; ++j)
+		{
+			void* memory = m_blockAllocator.Allocate(sizeof(b2Fixture), e_allocTagFixture);
+			b2Fixture* f = new (memory) b2Fixture;
+			f->Create(&m_blockAllocator, b, fixtureDefs + fixtureCount);
+
+			// Same as b2Fixture::CreateProxies, except that the tree is updated below.
+			if (b->m_flags & b2Body::e_activeFlag)
+			{
+				f->m_proxyCount = f->m_shape->GetChildCount();
+				for (int32 k = 0; k < f->m_proxyCount; ++k)
+				{
+					b2FixtureProxy* proxy = f->m_proxies + k;
+					f->m_shape->ComputeAABB(&proxy->aabb, b->m_xf, k);
+					proxy->fixture = f;
+					proxy->childIndex = k;
+
+					aabbs[proxyCount] = proxy->aabb;
+					userData[proxyCount] = proxy;
+					++proxyCount;
+				}
+			}
+
+			f->m_next = b->m_fixtureList;
+			b->m_fixtureList = f;
+			++b->m_fixtureCount;
+
+			f->m_body = b;
+			hasMass = hasMass || f->m_density > 0.0f;
+
+			if (fixtures)
+			{
+				fixtures[fixtureCount] = f;
+			}
+			++fixtureCount;
+		}
+
+		// Mass is computed once for all of the fixtures.
+		if (hasMass)
+		{
+			b->ResetMassData();
+		}
+
+		if (bodies)
+		{
+			bodies[i] = b;
+		}
+	}
+
+	m_contactManager.m_broadPhase.CreateProxies(proxyCount, aabbs, userData, proxyIds);
+	for (int32 i = 0; i < proxyCount; ++i)
+	{
+		((b2FixtureProxy*)userData[i])->proxyId = proxyIds[i];
+	}
+
+	m_stackAllocator.Free(proxyIds);
+	m_stackAllocator.Free(userData);
+	m_stackAllocator.Free(aabbs);
+
+	if (fixtureCount > 0)
+	{
+		// New contacts are created at the beginning of the next time step.
+		m_flags |= e_newFixture;
+	}
+}
+
+void b2World::DestroyBodies(int32 bodyCount, b2Body* const* bodies)
+{
+	b2Assert(m_bodyCount >= bodyCount);
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return;
+	}
+
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordDestroyBodies(bodyCount, bodies);
+	}
+
+	int32 proxyCount = 0;
+	for (int32 i = 0; i < bodyCount; ++i)
+	{
+		for (b2Fixture* f = bodies[i]->m_fixtureList; f; f = f->m_next)
+		{
+			proxyCount += f->m_proxyCount;
+		}
+	}
+
+	// The bodies are torn down in the same order as DestroyBody would, but the
+	// proxies are gathered and removed from the broad-phase together at the end.
+	int32* proxyIds = (int32*)m_stackAllocator.Allocate(proxyCount * sizeof(int32));
+	proxyCount = 0;
+	for (int32 i = 0; i < bodyCount; ++i)
+	{
+		DestroyConnections(bodies[i]);
+
+		for (b2Fixture* f = bodies[i]->m_fixtureList; f; f = f->m_next)
+		{
+			if (m_destructionListener)
+			{
+				m_destructionListener->SayGoodbye(f);
+			}
+
+			for (int32 k = 0; k < f->m_proxyCount; ++k)
+			{
+				proxyIds[proxyCount] = f->m_proxies[k].proxyId;
+				f->m_proxies[k].proxyId = b2BroadPhase::e_nullProxy;
+				++proxyCount;
+			}
+			f->m_proxyCount = 0;
+		}
+
+		FreeBody(bodies[i]);
+	}
+
+	m_contactManager.m_broadPhase.DestroyProxies(proxyCount, proxyIds);
+	m_stackAllocator.Free(proxyIds);
+}
+
+void b2World::Clear()
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return;
+	}
+
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordWorld(e_recordClear, NULL, 0);
+	}
+
+	// Touching contacts end here. The world is locked so the listener cannot
+	// change it while the contacts are reported.
+	b2ContactListener* listener = m_contactManager.m_contactListener;
+	if (listener)
+	{
+		m_flags |= e_locked;
+		for (b2Contact* c = m_contactManager.m_contactList; c; c = c->GetNext())
+		{
+			if (c->IsTouching())
+			{
+				listener->EndContact(c);
+			}
+		}
+		m_flags &= ~e_locked;
+	}
+
+	// Shared shapes and chains may hold memory outside the block allocator.
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			if (f->m_sharedShape || f->m_shape->m_type == b2Shape::e_chain)
+			{
+				f->m_proxyCount = 0;
+				f->Destroy(&m_blockAllocator);
+			}
+		}
+	}
+
+	m_blockAllocator.Reset();
+	m_contactManager.m_broadPhase.Clear();
+	m_contactManager.m_contactCache.Clear();
+	m_contactManager.m_contactList = NULL;
+	m_contactManager.m_contactCount = 0;
+	for (int32 i = 0; i < b2_contactPairTypeCount; ++i)
+	{
+		m_contactManager.m_pairTypeLists[i] = NULL;
+	}
+
+	m_bodyList = NULL;
+	m_jointList = NULL;
+	m_bodyCount = 0;
+	m_jointCount = 0;
+
+	m_flags &= ~e_newFixture;
+}
+
+// Destroy the joints and contacts attached to a body.
+void b2World::DestroyConnections(b2Body* b)
+{
 	// Delete the attached joints.
 	b2JointEdge* je = b->m_jointList;
 	while (je)
@@ -164,23 +807,21 @@ void b2World::DestroyBody(b2Body* b)
 		m_contactManager.Destroy(ce0->contact);
 	}
 	b->m_contactList = NULL;
+}
 
-	// Delete the attached fixtures. This destroys broad-phase proxies.
+// Free the fixtures of a body and the body itself. The proxies must be gone.
+void b2World::FreeBody(b2Body* b)
+{
 	b2Fixture* f = b->m_fixtureList;
 	while (f)
 	{
 		b2Fixture* f0 = f;
 		f = f->m_next;
 
-		if (m_destructionListener)
-		{
-			m_destructionListener->SayGoodbye(f0);
-		}
-
-		f0->DestroyProxies(&m_contactManager.m_broadPhase);
+		b2Assert(f0->m_proxyCount == 0);
 		f0->Destroy(&m_blockAllocator);
 		f0->~b2Fixture();
-		m_blockAllocator.Free(f0, sizeof(b2Fixture));
+		m_blockAllocator.Free(f0, sizeof(b2Fixture), e_allocTagFixture);
 
 		b->m_fixtureList = f;
 		b->m_fixtureCount -= 1;
@@ -206,7 +847,7 @@ void b2World::DestroyBody(b2Body* b)
 
 	--m_bodyCount;
 	b->~b2Body();
-	m_blockAllocator.Free(b, sizeof(b2Body));
+	m_blockAllocator.Free(b, sizeof(b2Body), e_allocTagBody);
 }
 
 b2Joint* b2World::CreateJoint(const b2JointDef* def)
@@ -217,7 +858,14 @@ b2Joint* b2World::CreateJoint(const b2JointDef* def)
 		return NULL;
 	}
 
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordCreateJoint(m_jointIdCount, def);
+	}
+
 	b2Joint* j = b2Joint::Create(def, &m_blockAllocator);
+	j->m_id = m_jointIdCount++;
 
 	// Connect to the world list.
 	j->m_prev = NULL;
@@ -277,6 +925,12 @@ void b2World::DestroyJoint(b2Joint* j)
 		return;
 	}
 
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordDestroyJoint(j);
+	}
+
 	bool collideConnected = j->m_collideConnected;
 
 	// Remove from the doubly linked list.
@@ -367,6 +1021,12 @@ void b2World::DestroyJoint(b2Joint* j)
 //
 void b2World::SetAllowSleeping(bool flag)
 {
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordWorld(e_recordSetAllowSleeping, flag ? 1.0f : 0.0f);
+	}
+
 	if (flag == m_allowSleep)
 	{
 		return;
@@ -382,13 +1042,127 @@ void b2World::SetAllowSleeping(bool flag)
 	}
 }
 
+void b2World::SetWarmStarting(bool flag)
+{
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordWorld(e_recordSetWarmStarting, flag ? 1.0f : 0.0f);
+	}
+
+	m_warmStarting = flag;
+}
+
+void b2World::SetContinuousPhysics(bool flag)
+{
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordWorld(e_recordSetContinuousPhysics, flag ? 1.0f : 0.0f);
+	}
+
+	m_continuousPhysics = flag;
+}
+
+void b2World::SetSubStepping(bool flag)
+{
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordWorld(e_recordSetSubStepping, flag ? 1.0f : 0.0f);
+	}
+
+	m_subStepping = flag;
+}
+
+void b2World::SetSolverType(b2SolverType type)
+{
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordWorld(e_recordSetSolverType, (float32)type);
+	}
+
+	m_solverType = type;
+}
+
+void b2World::SetJointTreeSolving(bool flag)
+{
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordWorld(e_recordSetJointTreeSolving, flag ? 1.0f : 0.0f);
+	}
+
+	m_jointTreeSolving = flag;
+}
+
+void b2World::SetShockPropagation(bool flag)
+{
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordWorld(e_recordSetShockPropagation, flag ? 1.0f : 0.0f);
+	}
+
+	m_shockPropagation = flag;
+}
+
+void b2World::SetSpeculativeContacts(bool flag)
+{
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordWorld(e_recordSetSpeculativeContacts, flag ? 1.0f : 0.0f);
+	}
+
+	m_speculativeContacts = flag;
+}
+
+void b2World::SetManifoldReuse(bool flag)
+{
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordWorld(e_recordSetManifoldReuse, flag ? 1.0f : 0.0f);
+	}
+
+	m_manifoldReuse = flag;
+}
+
+void b2World::SetGravity(const b2Vec2& gravity)
+{
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		float32 values[2] = { gravity.x, gravity.y };
+		scope.GetRecorder()->RecordWorld(e_recordSetGravity, values, 2);
+	}
+
+	m_gravity = gravity;
+}
+
+void b2World::SetAutoClearForces(bool flag)
+{
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordWorld(e_recordSetAutoClearForces, flag ? 1.0f : 0.0f);
+	}
+
+	if (flag)
+	{
+		m_flags |= e_clearForces;
+	}
+	else
+	{
+		m_flags &= ~e_clearForces;
+	}
+}
+
 // Find islands, integrate and solve constraints, solve position constraints
 void b2World::Solve(const b2TimeStep& step)
 {
-	m_profile.solveInit = 0.0f;
-	m_profile.solveVelocity = 0.0f;
-	m_profile.solvePosition = 0.0f;
-
 	// Size the island for the worst case.
 	b2Island island(m_bodyCount,
 					m_contactManager.m_contactCount,
@@ -410,6 +1184,10 @@ void b2World::Solve(const b2TimeStep& step)
 		j->m_islandFlag = false;
 	}
 
+	// The awake bodies are counted with their islands. Bodies woken after this
+	// by new contacts or TOI events add themselves.
+	m_metrics.bodiesAwake = 0;
+
 	// Build and simulate all awake islands.
 	int32 stackSize = m_bodyCount;
 	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
@@ -466,9 +1244,10 @@ void b2World::Solve(const b2TimeStep& step)
 					continue;
 				}
 
-				// Is this contact solid and touching?
+				// Is this contact solid and touching, or about to touch?
+				uint32 solidFlags = b2Contact::e_touchingFlag | b2Contact::e_speculativeFlag;
 				if (contact->IsEnabled() == false ||
-					contact->IsTouching() == false)
+					(contact->m_flags & solidFlags) == 0)
 				{
 					continue;
 				}
@@ -527,11 +1306,17 @@ void b2World::Solve(const b2TimeStep& step)
 			}
 		}
 
-		b2Profile profile;
-		island.Solve(&profile, step, m_gravity, m_allowSleep);
-		m_profile.solveInit += profile.solveInit;
-		m_profile.solveVelocity += profile.solveVelocity;
-		m_profile.solvePosition += profile.solvePosition;
+		b2TraceScopeValue("Island", island.m_bodyCount);
+
+		int32 bucket = 0;
+		while (bucket < b2_islandHistogramSize - 1 && (2 << bucket) <= island.m_bodyCount)
+		{
+			++bucket;
+		}
+		++m_metrics.islandSizes[bucket];
+		++m_metrics.islands;
+
+		island.Solve(&m_stepTimes, step, m_gravity, m_allowSleep);
 
 		// Post solve cleanup.
 		for (int32 i = 0; i < island.m_bodyCount; ++i)
@@ -542,38 +1327,70 @@ void b2World::Solve(const b2TimeStep& step)
 			{
 				b->m_flags &= ~b2Body::e_islandFlag;
 			}
+			else if (b->IsAwake())
+			{
+				++m_metrics.bodiesAwake;
+			}
 		}
 	}
 
 	m_stackAllocator.Free(stack);
+	b2TraceCounter("islands", m_metrics.islands);
 
 	{
 		b2Timer timer;
-		// Synchronize fixtures, check for out of range bodies.
-		for (b2Body* b = m_bodyList; b; b = b->GetNext())
 		{
-			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
-			{
-				continue;
-			}
+			b2TraceScope("SynchronizeFixtures");
 
-			if (b->GetType() == b2_staticBody)
+			// Synchronize fixtures, check for out of range bodies.
+			for (b2Body* b = m_bodyList; b; b = b->GetNext())
 			{
-				continue;
-			}
+				// If a body was not in an island then it did not move.
+				if ((b->m_flags & b2Body::e_islandFlag) == 0)
+				{
+					continue;
+				}
 
-			// Update fixtures (for broad-phase).
-			b->SynchronizeFixtures();
+				if (b->GetType() == b2_staticBody)
+				{
+					continue;
+				}
+
+				// Update fixtures (for broad-phase).
+				b->SynchronizeFixtures(step.speculativeContacts ? step.dt : 0.0f);
+			}
 		}
 
 		// Look for new contacts.
 		m_contactManager.FindNewContacts();
-		m_profile.broadphase = timer.GetMilliseconds();
+		m_stepTimes.broadphase = timer.GetNanoseconds();
 	}
 }
 
 // Find TOI contacts and solve them.
+// Update a contact during TOI. This can change whether the contact is touching
+// and wake its bodies, so the step metrics are adjusted here.
+void b2World::UpdateTOIContact(b2Contact* contact)
+{
+	b2Body* bodyA = contact->GetFixtureA()->GetBody();
+	b2Body* bodyB = contact->GetFixtureB()->GetBody();
+	bool touching = contact->IsTouching();
+	bool awakeA = bodyA->IsAwake();
+	bool awakeB = bodyB->IsAwake();
+
+	contact->Update(m_contactManager.m_contactListener, &m_contactManager.m_contactCache, 0.0f, false);
+
+	m_metrics.contactsTouching += (int32)contact->IsTouching() - (int32)touching;
+	if (bodyA->m_type != b2_staticBody && awakeA == false && bodyA->IsAwake())
+	{
+		++m_metrics.bodiesAwake;
+	}
+	if (bodyB->m_type != b2_staticBody && awakeB == false && bodyB->IsAwake())
+	{
+		++m_metrics.bodiesAwake;
+	}
+}
+
 void b2World::SolveTOI(const b2TimeStep& step)
 {
 	b2Island island(2 * b2_maxTOIContacts, b2_maxTOIContacts, 0, &m_stackAllocator, m_contactManager.m_contactListener);
@@ -652,6 +1469,13 @@ void b2World::SolveTOI(const b2TimeStep& step)
 				bool collideA = bA->IsBullet() || typeA != b2_dynamicBody;
 				bool collideB = bB->IsBullet() || typeB != b2_dynamicBody;
 
+				// Speculative contacts stop the other bodies.
+				if (m_speculativeContacts)
+				{
+					collideA = bA->IsBullet();
+					collideB = bB->IsBullet();
+				}
+
 				// Are these two non-bullet dynamic bodies?
 				if (collideA == false && collideB == false)
 				{
@@ -719,6 +1543,9 @@ void b2World::SolveTOI(const b2TimeStep& step)
 			break;
 		}
 
+		b2TraceScopeValue("TOIEvent", minAlpha);
+		++m_metrics.toiEvents;
+
 		// Advance the bodies to the TOI.
 		b2Fixture* fA = minContact->GetFixtureA();
 		b2Fixture* fB = minContact->GetFixtureB();
@@ -732,7 +1559,7 @@ void b2World::SolveTOI(const b2TimeStep& step)
 		bB->Advance(minAlpha);
 
 		// The TOI contact likely has some new contact points.
-		minContact->Update(m_contactManager.m_contactListener);
+		UpdateTOIContact(minContact);
 		minContact->m_flags &= ~b2Contact::e_toiFlag;
 		++minContact->m_toiCount;
 
@@ -748,6 +1575,15 @@ void b2World::SolveTOI(const b2TimeStep& step)
 			continue;
 		}
 
+		if (bA->m_type != b2_staticBody && bA->IsAwake() == false)
+		{
+			++m_metrics.bodiesAwake;
+		}
+		if (bB->m_type != b2_staticBody && bB->IsAwake() == false)
+		{
+			++m_metrics.bodiesAwake;
+		}
+
 		bA->SetAwake(true);
 		bB->SetAwake(true);
 
@@ -812,7 +1648,7 @@ void b2World::SolveTOI(const b2TimeStep& step)
 					}
 
 					// Update the contact points
-					contact->Update(m_contactManager.m_contactListener);
+					UpdateTOIContact(contact);
 
 					// Was the contact disabled by the user?
 					if (contact->IsEnabled() == false)
@@ -845,6 +1681,10 @@ void b2World::SolveTOI(const b2TimeStep& step)
 
 					if (other->m_type != b2_staticBody)
 					{
+						if (other->IsAwake() == false)
+						{
+							++m_metrics.bodiesAwake;
+						}
 						other->SetAwake(true);
 					}
 
@@ -860,6 +1700,10 @@ void b2World::SolveTOI(const b2TimeStep& step)
 		subStep.positionIterations = 20;
 		subStep.velocityIterations = step.velocityIterations;
 		subStep.warmStarting = false;
+		subStep.solverType = b2_sequentialImpulseSolver;
+		subStep.jointTrees = false;
+		subStep.shockPropagation = false;
+		subStep.speculativeContacts = step.speculativeContacts;
 		island.SolveTOI(subStep, bA->m_islandIndex, bB->m_islandIndex);
 
 		// Reset island flags and synchronize broad-phase proxies.
@@ -873,7 +1717,7 @@ void b2World::SolveTOI(const b2TimeStep& step)
 				continue;
 			}
 
-			body->SynchronizeFixtures();
+			body->SynchronizeFixtures(step.speculativeContacts ? step.dt : 0.0f);
 
 			// Invalidate all contact TOIs on this displaced body.
 			for (b2ContactEdge* ce = body->m_contactList; ce; ce = ce->next)
@@ -892,12 +1736,35 @@ void b2World::SolveTOI(const b2TimeStep& step)
 			break;
 		}
 	}
+
+	b2TraceCounter("toiEvents", m_metrics.toiEvents);
 }
 
 void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIterations)
 {
+	b2TraceScope("Step");
 	b2Timer stepTimer;
 
+	if (m_recorder && IsLocked() == false)
+	{
+		m_recorder->RecordStep(dt, velocityIterations, positionIterations);
+	}
+
+	++m_epoch;
+
+	memset(&m_stepTimes, 0, sizeof(b2StepTimes));
+	memset(&m_metrics, 0, sizeof(b2Metrics));
+	m_contactManager.m_broadPhase.ResetCounters();
+	m_contactManager.m_contactCache.ResetCounters();
+	m_contactManager.m_contactCache.Advance();
+	int32 gjkCalls = b2_gjkCalls, gjkIters = b2_gjkIters, gjkMaxIters = b2_gjkMaxIters;
+	int32 toiCalls = b2_toiCalls, toiIters = b2_toiIters, toiMaxIters = b2_toiMaxIters;
+	b2_gjkMaxIters = 0;
+	b2_toiMaxIters = 0;
+	int32 stackGrowths = m_stackAllocator.GetGrowthCount();
+	int32 blockGrowths = m_blockAllocator.GetGrowthCount();
+	int32 broadPhaseGrowths = m_contactManager.m_broadPhase.GetGrowthCount();
+
 	// If new fixtures were added, we need to find the new contacts.
 	if (m_flags & e_newFixture)
 	{
@@ -923,28 +1790,36 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 	step.dtRatio = m_inv_dt0 * dt;
 
 	step.warmStarting = m_warmStarting;
+	step.solverType = m_solverType;
+	step.jointTrees = m_jointTreeSolving;
+	step.shockPropagation = m_shockPropagation;
+	step.speculativeContacts = m_speculativeContacts;
 
 	// Update contacts. This is where some contacts are destroyed.
 	{
+		b2TraceScope("Collide");
 		b2Timer timer;
-		m_contactManager.Collide();
-		m_profile.collide = timer.GetMilliseconds();
+		m_contactManager.Collide(step.speculativeContacts ? step.dt : 0.0f, m_manifoldReuse);
+		m_stepTimes.collide = timer.GetNanoseconds();
 	}
 
 	// Integrate velocities, solve velocity constraints, and integrate positions.
-	if (m_stepComplete && step.dt > 0.0f)
+	bool solved = m_stepComplete && step.dt > 0.0f;
+	if (solved)
 	{
+		b2TraceScope("Solve");
 		b2Timer timer;
 		Solve(step);
-		m_profile.solve = timer.GetMilliseconds();
+		m_stepTimes.solve = timer.GetNanoseconds();
 	}
 
 	// Handle TOI events.
 	if (m_continuousPhysics && step.dt > 0.0f)
 	{
+		b2TraceScope("SolveTOI");
 		b2Timer timer;
 		SolveTOI(step);
-		m_profile.solveTOI = timer.GetMilliseconds();
+		m_stepTimes.solveTOI = timer.GetNanoseconds();
 	}
 
 	if (step.dt > 0.0f)
@@ -959,11 +1834,93 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 
 	m_flags &= ~e_locked;
 
-	m_profile.step = stepTimer.GetMilliseconds();
+	// Gather the remaining metrics. Without islands the awake bodies are
+	// counted here.
+	if (solved == false)
+	{
+		m_metrics.bodiesAwake = 0;
+		for (b2Body* b = m_bodyList; b; b = b->m_next)
+		{
+			if (b->m_type != b2_staticBody && b->IsAwake() && b->IsActive())
+			{
+				++m_metrics.bodiesAwake;
+			}
+		}
+	}
+	m_metrics.proxiesMoved = m_contactManager.m_broadPhase.GetProxyMoveCount();
+	m_metrics.proxiesReinserted = m_contactManager.m_broadPhase.GetProxyReinsertCount();
+	m_metrics.pairsBuffered = m_contactManager.m_broadPhase.GetPairPeak();
+	m_metrics.contactPointsCached = m_contactManager.m_contactCache.GetStoreCount();
+	m_metrics.contactPointsRestored = m_contactManager.m_contactCache.GetRestoreCount();
+	m_metrics.gjkCalls = b2_gjkCalls - gjkCalls;
+	m_metrics.gjkIters = b2_gjkIters - gjkIters;
+	m_metrics.gjkMaxIters = b2_gjkMaxIters;
+	m_metrics.toiCalls = b2_toiCalls - toiCalls;
+	m_metrics.toiIters = b2_toiIters - toiIters;
+	m_metrics.toiMaxIters = b2_toiMaxIters;
+	b2_gjkMaxIters = b2Max(b2_gjkMaxIters, gjkMaxIters);
+	b2_toiMaxIters = b2Max(b2_toiMaxIters, toiMaxIters);
+	m_metrics.blockAllocatorBytes = m_blockAllocator.GetChunkBytes();
+	m_metrics.stackAllocatorPeak = m_stackAllocator.GetMaxAllocation();
+	m_metrics.stackAllocatorCapacity = m_stackAllocator.GetCapacity();
+	m_metrics.stackAllocatorGrowths = m_stackAllocator.GetGrowthCount() - stackGrowths;
+	m_metrics.blockAllocatorGrowths = m_blockAllocator.GetGrowthCount() - blockGrowths;
+	m_metrics.broadPhaseGrowths = m_contactManager.m_broadPhase.GetGrowthCount() - broadPhaseGrowths;
+
+	b2TraceCounter("bodies", m_bodyCount);
+	b2TraceCounter("contacts", m_contactManager.m_contactCount);
+
+	m_stepTimes.step = stepTimer.GetNanoseconds();
+	UpdateProfile();
+}
+
+// Convert the phase times of the step to the profile and fold them into
+// the statistics. The structures list the phases in the same order.
+// Store the time of one phase in the profile and add it to the statistics.
+static void b2UpdateProfilePhase(float32* profile, b2ProfileStat* stat, int64 time, bool first)
+{
+	*profile = float32(1.0e-6 * float64(time));
+
+	if (first)
+	{
+		stat->min = time;
+		stat->max = time;
+	}
+	else
+	{
+		stat->min = b2Min(stat->min, time);
+		stat->max = b2Max(stat->max, time);
+	}
+	stat->total += time;
+}
+
+void b2World::UpdateProfile()
+{
+	bool first = m_profileStats.stepCount == 0;
+	b2UpdateProfilePhase(&m_profile.step, &m_profileStats.step, m_stepTimes.step, first);
+	b2UpdateProfilePhase(&m_profile.collide, &m_profileStats.collide, m_stepTimes.collide, first);
+	b2UpdateProfilePhase(&m_profile.solve, &m_profileStats.solve, m_stepTimes.solve, first);
+	b2UpdateProfilePhase(&m_profile.solveInit, &m_profileStats.solveInit, m_stepTimes.solveInit, first);
+	b2UpdateProfilePhase(&m_profile.solveVelocity, &m_profileStats.solveVelocity, m_stepTimes.solveVelocity, first);
+	b2UpdateProfilePhase(&m_profile.solvePosition, &m_profileStats.solvePosition, m_stepTimes.solvePosition, first);
+	b2UpdateProfilePhase(&m_profile.broadphase, &m_profileStats.broadphase, m_stepTimes.broadphase, first);
+	b2UpdateProfilePhase(&m_profile.solveTOI, &m_profileStats.solveTOI, m_stepTimes.solveTOI, first);
+	++m_profileStats.stepCount;
+}
+
+void b2World::ResetProfileStats()
+{
+	memset(&m_profileStats, 0, sizeof(b2ProfileStats));
 }
 
 void b2World::ClearForces()
 {
+	b2RecordScope scope(this);
+	if (scope.GetRecorder())
+	{
+		scope.GetRecorder()->RecordWorld(e_recordClearForces, NULL, 0);
+	}
+
 	for (b2Body* body = m_bodyList; body; body = body->GetNext())
 	{
 		body->m_force.SetZero();
@@ -1256,6 +2213,26 @@ float32 b2World::GetTreeQuality() const
 	return m_contactManager.m_broadPhase.GetTreeQuality();
 }
 
+void b2World::GetMemoryReport(b2MemoryReport* report) const
+{
+	*report = m_allocator.GetReport();
+
+	// Move the tagged blocks out of the chunks that hold them.
+	for (int32 i = 0; i < e_allocTagCount; ++i)
+	{
+		if (i == e_allocTagBlock)
+		{
+			continue;
+		}
+
+		b2AllocTag tag = (b2AllocTag)i;
+		int32 bytes = m_blockAllocator.GetBlockBytes(tag);
+		report->bytes[tag] += bytes;
+		report->counts[tag] += m_blockAllocator.GetBlockCount(tag);
+		report->bytes[e_allocTagBlock] -= bytes;
+	}
+}
+
 void b2World::Dump()
 {
 	if ((m_flags & e_locked) == e_locked)
@@ -24,16 +24,66 @@
 #include <Box2D/Common/b2StackAllocator.h>
 #include <Box2D/Dynamics/b2ContactManager.h>
 #include <Box2D/Dynamics/b2WorldCallbacks.h>
+#include <Box2D/Dynamics/Joints/b2Joint.h>
 #include <Box2D/Dynamics/b2TimeStep.h>
 
 struct b2AABB;
 struct b2BodyDef;
 struct b2Color;
+struct b2FixtureDef;
 struct b2JointDef;
 class b2Body;
 class b2Draw;
 class b2Fixture;
 class b2Joint;
+class b2Recorder;
+
+/// Expected object counts for b2World::Reserve.
+struct b2WorldCapacity
+{
+	b2WorldCapacity()
+	{
+		bodyCount = 0;
+		fixtureCount = 0;
+		proxyCount = 0;
+		contactCount = 0;
+		jointCount = 0;
+		pairCount = 0;
+		for (int32 i = 0; i < b2Shape::e_typeCount; ++i)
+		{
+			shapeCounts[i] = 0;
+		}
+		for (int32 i = 0; i < b2_jointTypeCount; ++i)
+		{
+			jointCounts[i] = 0;
+		}
+	}
+
+	int32 bodyCount;
+	int32 fixtureCount;
+
+	/// Fixtures by shape type, indexed by b2Shape::Type. If these are all
+	/// zero, fixtureCount fixtures are reserved at the size of every shape.
+	int32 shapeCounts[b2Shape::e_typeCount];
+
+	/// Broad-phase proxies. A chain fixture has one per edge, other
+	/// fixtures have one. If this is zero the fixture count is used.
+	int32 proxyCount;
+
+	/// Contacts alive at once, including the contacts a step creates before
+	/// it destroys the ones that stopped overlapping.
+	int32 contactCount;
+
+	int32 jointCount;
+
+	/// Joints by type, indexed by b2JointType. If these are all zero,
+	/// jointCount joints are reserved at the size of every joint type.
+	int32 jointCounts[b2_jointTypeCount];
+
+	/// Broad-phase pairs buffered in one step, see b2Metrics::pairsBuffered.
+	/// If this is zero, twice the contact count is assumed.
+	int32 pairCount;
+};
 
 /// The world class manages all physics entities, dynamic simulation,
 /// and asynchronous queries. The world also contains efficient memory
@@ -43,11 +93,36 @@ class b2World
 public:
 	/// Construct a world object.
 	/// @param gravity the world gravity vector.
-	b2World(const b2Vec2& gravity);
+	/// @param allocator supplies all memory of the world, or NULL to use b2Alloc.
+	/// It is owned by you and must outlive the world.
+	b2World(const b2Vec2& gravity, b2Allocator* allocator = NULL);
 
 	/// Destruct the world. All physics entities are destroyed and all heap memory is released.
 	~b2World();
 
+	/// Create a deep copy of this world. The small object blocks are copied
+	/// wholesale and their pointers translated, which is much faster than
+	/// re-creating every body, fixture and joint. The copy shares user data
+	/// pointers and the contact filter with this world, but has no destruction
+	/// listener, contact listener or debug draw. You own the returned world.
+	/// @warning this should be called outside of a time step.
+	b2World* Clone() const;
+
+	/// Preallocate room for the given number of additional objects, so that
+	/// creating them and stepping the world does not grow the broad-phase,
+	/// the small object chunks or the stack allocator. Every block size the
+	/// objects can take is reserved, and objects that share a block size add
+	/// up. The vertex and proxy arrays of chain shapes vary in length and are
+	/// not reserved. This resets the growth count.
+	/// @warning this should be called outside of a time step.
+	void Reserve(const b2WorldCapacity& capacity);
+
+	/// Return the small object chunks that no longer hold any live object to
+	/// the allocator, so a long-lived world shrinks back after a spike in
+	/// object count. Returns the number of bytes released.
+	/// @warning this should be called outside of a time step.
+	int32 Trim();
+
 	/// Register a destruction listener. The listener is owned by you and must
 	/// remain in scope.
 	void SetDestructionListener(b2DestructionListener* listener);
@@ -66,6 +141,15 @@ public:
 	/// by you and must remain in scope.
 	void SetDebugDraw(b2Draw* debugDraw);
 
+	/// Register a recorder that logs every mutation and step of this world so
+	/// the session can be replayed with b2Replayer. The recorder is owned by you
+	/// and must remain in scope. Attach it before creating any bodies. Pass NULL
+	/// to stop recording.
+	void SetRecorder(b2Recorder* recorder);
+
+	/// Get the registered recorder.
+	b2Recorder* GetRecorder() const;
+
 	/// Create a rigid body given a definition. No reference to the definition
 	/// is retained.
 	/// @warning This function is locked during callbacks.
@@ -77,6 +161,39 @@ public:
 	/// @warning This function is locked during callbacks.
 	void DestroyBody(b2Body* body);
 
+	/// Create a batch of bodies together with their fixtures. Body i receives
+	/// the next fixtureCounts[i] definitions of fixtureDefs. Mass data is
+	/// computed once per body and the broad-phase proxies of the whole batch
+	/// are inserted together, which is much cheaper than calling CreateBody and
+	/// b2Body::CreateFixture in a loop. No reference to the definitions is retained.
+	/// @param fixtureCounts the fixture count of each body, may be NULL if no body has fixtures.
+	/// @param bodies receives the new bodies, may be NULL.
+	/// @param fixtures receives the new fixtures in definition order, may be NULL.
+	/// @warning This function is locked during callbacks.
+	void CreateBodies(int32 bodyCount, const b2BodyDef* bodyDefs, const int32* fixtureCounts,
+					  const b2FixtureDef* fixtureDefs, b2Body** bodies, b2Fixture** fixtures);
+
+	/// Destroy a batch of bodies. This is the same as calling DestroyBody for
+	/// each of them, except that the broad-phase proxies are removed in bulk.
+	/// @warning This automatically deletes all associated shapes and joints.
+	/// @warning This function is locked during callbacks.
+	void DestroyBodies(int32 bodyCount, b2Body* const* bodies);
+
+	/// Destroy all bodies, joints and contacts at once. Instead of tearing
+	/// every object down, the small object blocks are all freed together and
+	/// the broad-phase is emptied. The chunks, the broad-phase tree and the
+	/// buffers keep their capacity, so refilling the world does not grow it.
+	/// The contact listener gets EndContact for every touching contact first,
+	/// as it would from DestroyBody. The destruction listener is not called
+	/// and all pointers to bodies, fixtures and joints of this world become
+	/// invalid. Gravity, settings and listeners are kept.
+	/// This is still linear in the size of the world: it walks every contact
+	/// and every fixture, and resetting the block allocator walks every block
+	/// of every chunk to rebuild the free lists. It saves the per-object
+	/// unlinking and the broad-phase removals of DestroyBody.
+	/// @warning This function is locked during callbacks.
+	void Clear();
+
 	/// Create a joint to constrain bodies together. No reference to the definition
 	/// is retained. This may cause the connected bodies to cease colliding.
 	/// @warning This function is locked during callbacks.
@@ -89,7 +206,8 @@ public:
 	/// Take a time step. This performs collision detection, integration,
 	/// and constraint solution.
 	/// @param timeStep the amount of time to simulate, this should not vary.
-	/// @param velocityIterations for the velocity constraint solver.
+	/// @param velocityIterations for the velocity constraint solver, or the
+	/// sub-step count of the soft step solver.
 	/// @param positionIterations for the position constraint solver.
 	void Step(	float32 timeStep,
 				int32 velocityIterations,
@@ -146,17 +264,57 @@ public:
 	bool GetAllowSleeping() const { return m_allowSleep; }
 
 	/// Enable/disable warm starting. For testing.
-	void SetWarmStarting(bool flag) { m_warmStarting = flag; }
+	void SetWarmStarting(bool flag);
 	bool GetWarmStarting() const { return m_warmStarting; }
 
 	/// Enable/disable continuous physics. For testing.
-	void SetContinuousPhysics(bool flag) { m_continuousPhysics = flag; }
+	void SetContinuousPhysics(bool flag);
 	bool GetContinuousPhysics() const { return m_continuousPhysics; }
 
 	/// Enable/disable single stepped continuous physics. For testing.
-	void SetSubStepping(bool flag) { m_subStepping = flag; }
+	void SetSubStepping(bool flag);
 	bool GetSubStepping() const { return m_subStepping; }
 
+	/// Select the island solver. The soft step solver divides each step into
+	/// velocityIterations sub-steps, which keeps tall stacks and piles stable
+	/// with less total work. The contact impulses it stores and reports are
+	/// per sub-step. The default is b2_sequentialImpulseSolver.
+	void SetSolverType(b2SolverType type);
+	b2SolverType GetSolverType() const { return m_solverType; }
+
+	/// Enable/disable the direct joint solver. Rigid revolute, distance and weld
+	/// joints that form trees are then solved exactly in one pass per iteration,
+	/// so long chains hold together with few iterations. Joints that close a
+	/// loop and joints with limits, motors or springs stay iterative.
+	void SetJointTreeSolving(bool flag);
+	bool GetJointTreeSolving() const { return m_jointTreeSolving; }
+
+	/// Enable/disable shock propagation. The contact graph of each island is
+	/// leveled upward from static and kinematic bodies and the contacts are
+	/// solved from the ground up. An extra velocity pass then treats the lower
+	/// body of each contact as immovable, so the stacks rest on what is below
+	/// them. Only the sequential impulse solver uses this.
+	void SetShockPropagation(bool flag);
+	bool GetShockPropagation() const { return m_shockPropagation; }
+
+	/// Enable/disable speculative contacts. Shapes that are apart but close
+	/// fast enough to meet within the step get a contact point, and the solver
+	/// lets the gap close but not go negative. This keeps fast bodies from
+	/// tunneling without time of impact sub-steps, so continuous collision is
+	/// then only done for bullets. BeginContact still waits for the shapes to
+	/// touch, but PreSolve is called for the speculative points as well.
+	void SetSpeculativeContacts(bool flag);
+	bool GetSpeculativeContacts() const { return m_speculativeContacts; }
+
+	/// Enable/disable manifold reuse. A contact then keeps its manifold while
+	/// the two bodies have barely moved against each other since it was
+	/// computed, which saves most of the collision cost of resting piles. The
+	/// manifold points follow the bodies, but points that would start or stop
+	/// within the tolerances are not picked up until it is computed again.
+	/// @see b2_manifoldReuseLinearTolerance
+	void SetManifoldReuse(bool flag);
+	bool GetManifoldReuse() const { return m_manifoldReuse; }
+
 	/// Get the number of broad-phase proxies.
 	int32 GetProxyCount() const;
 
@@ -200,6 +358,30 @@ public:
 	/// Get the current profile.
 	const b2Profile& GetProfile() const;
 
+	/// Get the minimum, maximum and total time of each profile phase
+	/// over the steps since the world was created or the statistics
+	/// were reset.
+	const b2ProfileStats& GetProfileStats() const;
+
+	/// Start a new set of profile statistics.
+	void ResetProfileStats();
+
+	/// Get the metrics of the last time step.
+	const b2Metrics& GetMetrics() const;
+
+	/// Get the live memory of this world broken down by tag. Objects carved
+	/// from block allocator chunks are reported under their own tags.
+	void GetMemoryReport(b2MemoryReport* report) const;
+
+	/// Get the number of times the broad-phase, the small object chunks or the
+	/// stack allocator had to grow since the world was created or Reserve was
+	/// last called. This stays at zero while a reservation holds.
+	int32 GetGrowthCount() const;
+
+	/// Get the current epoch. Bodies are stamped with the epoch in which they
+	/// last changed. The epoch advances at the start of every step.
+	uint32 GetEpoch() const;
+
 	/// Dump the world into the log file.
 	/// @warning this should be called outside of a time step.
 	void Dump();
@@ -218,13 +400,20 @@ private:
 	friend class b2Fixture;
 	friend class b2ContactManager;
 	friend class b2Controller;
+	friend class b2Snapshot;
 
 	void Solve(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
+	void UpdateTOIContact(b2Contact* contact);
+	void UpdateProfile();
+
+	void DestroyConnections(b2Body* body);
+	void FreeBody(b2Body* body);
 
 	void DrawJoint(b2Joint* joint);
 	void DrawShape(b2Fixture* shape, const b2Transform& xf, const b2Color& color);
 
+	b2TrackingAllocator m_allocator;
 	b2BlockAllocator m_blockAllocator;
 	b2StackAllocator m_stackAllocator;
 
@@ -238,11 +427,16 @@ private:
 	int32 m_bodyCount;
 	int32 m_jointCount;
 
+	uint32 m_epoch;
+	uint32 m_bodyIdCount;
+	uint32 m_jointIdCount;
+
 	b2Vec2 m_gravity;
 	bool m_allowSleep;
 
 	b2DestructionListener* m_destructionListener;
 	b2Draw* m_debugDraw;
+	b2Recorder* m_recorder;
 
 	// This is used to compute the time step ratio to
 	// support a variable time step.
@@ -252,12 +446,27 @@ private:
 	bool m_warmStarting;
 	bool m_continuousPhysics;
 	bool m_subStepping;
+	b2SolverType m_solverType;
+	bool m_jointTreeSolving;
+	bool m_shockPropagation;
+	bool m_speculativeContacts;
+	bool m_manifoldReuse;
 
 	bool m_stepComplete;
 
 	b2Profile m_profile;
+	b2StepTimes m_stepTimes;
+	b2ProfileStats m_profileStats;
+	b2Metrics m_metrics;
+
+	int32 m_growthBase;
 };
 
+inline uint32 b2World::GetEpoch() const
+{
+	return m_epoch;
+}
+
 inline b2Body* b2World::GetBodyList()
 {
 	return m_bodyList;
@@ -303,31 +512,19 @@ inline int32 b2World::GetContactCount() const
 	return m_contactManager.m_contactCount;
 }
 
-inline void b2World::SetGravity(const b2Vec2& gravity)
-{
-	m_gravity = gravity;
-}
-
 inline b2Vec2 b2World::GetGravity() const
 {
 	return m_gravity;
 }
 
-inline bool b2World::IsLocked() const
+inline b2Recorder* b2World::GetRecorder() const
 {
-	return (m_flags & e_locked) == e_locked;
+	return m_recorder;
 }
 
-inline void b2World::SetAutoClearForces(bool flag)
+inline bool b2World::IsLocked() const
 {
-	if (flag)
-	{
-		m_flags |= e_clearForces;
-	}
-	else
-	{
-		m_flags &= ~e_clearForces;
-	}
+	return (m_flags & e_locked) == e_locked;
 }
 
 /// Get the flag that controls automatic clearing of forces after each time step.
@@ -346,4 +543,14 @@ inline const b2Profile& b2World::GetProfile() const
 	return m_profile;
 }
 
+inline const b2ProfileStats& b2World::GetProfileStats() const
+{
+	return m_profileStats;
+}
+
+inline const b2Metrics& b2World::GetMetrics() const
+{
+	return m_metrics;
+}
+
 #endif
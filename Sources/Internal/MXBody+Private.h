@@ -24,11 +24,29 @@
  */
 - (void)__assemble;
 
+/**
+ Assembles the b2Body objects of several bodies, along with their fixtures, with a single call to
+ b2World::CreateBodies. Joints are assembled once all of the bodies exist. Bodies that are already assembled are
+ skipped.
+
+ @param bodies  The bodies to assemble.
+ @param b2World The world in which to create the bodies.
+ */
++ (void)__assembleBodies:(NSArray<MXBody *> *)bodies inWorld:(b2World *)b2World;
+
 /**
  Destroys the underlying b2Body such that it may later be reassembled.
  */
 - (void)__disassemble;
 
+/**
+ Saves the state of the underlying b2Body and its fixtures and lets go of them without destroying them. Joints are
+ disassembled. Used to destroy many bodies at once with b2World::DestroyBodies.
+
+ @return The b2Body that the caller must destroy, or NULL if the body was not assembled.
+ */
+- (b2Body *)__detach;
+
 /**
  Add a joint edge to the body.
 
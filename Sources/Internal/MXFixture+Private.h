@@ -12,14 +12,32 @@
  */
 @property (nonatomic, assign, readonly) b2Fixture *b2Fixture;
 
+/**
+ The definition from which the b2Fixture is assembled.
+ */
+@property (nonatomic, assign, readonly) b2FixtureDef *b2FixtureDef;
+
 /**
  The fixture uses its b2FixtureDef to assemble a new b2Fixture.
  */
 - (void)__assemble;
 
+/**
+ Adopts a b2Fixture that was created from -b2FixtureDef by a batch operation, such as b2World::CreateBodies.
+
+ @param b2Fixture The new underlying fixture.
+ */
+- (void)__assembleWithB2Fixture:(b2Fixture *)b2Fixture;
+
 /**
  Destroys the underlying b2Fixture such that it may later be reassembled.
  */
 - (void)__disassemble;
 
+/**
+ Saves the state of the underlying b2Fixture to -b2FixtureDef and lets go of it without destroying it. Used when the
+ b2Fixture is destroyed along with its body.
+ */
+- (void)__detach;
+
 @end
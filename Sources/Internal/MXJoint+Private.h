@@ -36,6 +36,13 @@
  */
 - (void)__disassemble;
 
+/**
+ Updates the joint definition with the state of the underlying b2Joint and releases the joint without destroying it.
+
+ @return The b2Joint that the caller is now responsible for destroying, or NULL if the joint wasn't assembled.
+ */
+- (b2Joint *)__detach;
+
 /**
  Performs the most suitable operation. If the joint is defined, the joint operation is performed, otherwise,
  the join def operation is performed.
@@ -251,9 +251,16 @@ b2JointType B2JointTypeFromMXJointType(MXJointType type) {
 
 - (void)__disassemble {
     // Disassemble this joint.
+    b2Joint *b2Joint = [self __detach];
+    if (b2Joint) {
+        b2Joint->GetBodyA()->GetWorld()->DestroyJoint(b2Joint);
+    }
+}
+
+- (b2Joint *)__detach {
     b2Joint *b2Joint = self.b2Joint;
     if (!b2Joint) {
-        return;
+        return NULL;
     }
 
     NSParameterAssert(self.b2JointDef);
@@ -268,9 +275,8 @@ b2JointType B2JointTypeFromMXJointType(MXJointType type) {
     // Have subclass update its related fields in the joint definition.
     [[self class] __refreshJointDefinition:b2JointDef withDataFromJoint:b2Joint];
 
-    // Destroy the old joint.
-    b2Joint->GetBodyA()->GetWorld()->DestroyJoint(b2Joint);
     self.b2Joint = NULL;
+    return b2Joint;
 }
 
 - (void)__performJointOperation:(void (^)(b2Joint *joint))jointOperation
@@ -507,27 +507,86 @@ gravityScale, allowSleep, awake, active, fixedRotation, bullet, mass, operationa
         return;
     }
 
-    NSParameterAssert(self.b2BodyDef);
+    [MXBody __assembleBodies:@[self] inWorld:self.world.b2World];
+}
 
-    self.b2Body = self.world.b2World->CreateBody(self.b2BodyDef);
++ (void)__assembleBodies:(NSArray<MXBody *> *)bodies inWorld:(b2World *)b2World {
+    NSParameterAssert(b2World);
 
-    [self.fixtures makeObjectsPerformSelector:@selector(__assemble)];
+    NSMutableArray<MXBody *> *pendingBodies = [NSMutableArray arrayWithCapacity:bodies.count];
+    NSMutableArray<MXFixture *> *fixtures = [NSMutableArray array];
+    for (MXBody *body in bodies) {
+        if (!body.b2Body) {
+            [pendingBodies addObject:body];
+            [fixtures addObjectsFromArray:body.mutableFixtures.allObjects];
+        }
+    }
 
-    for (MXJointEdge *jointEdge in self.jointEdges) {
-        [jointEdge.joint __assemble];
+    const NSUInteger bodyCount = pendingBodies.count;
+    if (bodyCount == 0) {
+        return;
+    }
+
+    // Create the bodies and their fixtures in one batch, so the broad-phase is updated once and the mass of each
+    // body is computed once.
+    b2BodyDef *bodyDefs = new b2BodyDef[bodyCount];
+    int32 *fixtureCounts = new int32[bodyCount];
+    b2Body **b2Bodies = new b2Body *[bodyCount];
+    b2FixtureDef *fixtureDefs = new b2FixtureDef[fixtures.count];
+    b2Fixture **b2Fixtures = new b2Fixture *[fixtures.count];
+
+    NSUInteger fixtureIndex = 0;
+    for (NSUInteger i = 0; i < bodyCount; i++) {
+        MXBody *body = pendingBodies[i];
+        NSParameterAssert(body.b2BodyDef);
+
+        bodyDefs[i] = *body.b2BodyDef;
+        fixtureCounts[i] = (int32)body.mutableFixtures.count;
+        for (NSUInteger j = 0; j < (NSUInteger)fixtureCounts[i]; j++, fixtureIndex++) {
+            fixtureDefs[fixtureIndex] = *fixtures[fixtureIndex].b2FixtureDef;
+        }
+    }
+
+    b2World->CreateBodies((int32)bodyCount, bodyDefs, fixtureCounts, fixtureDefs, b2Bodies, b2Fixtures);
+
+    for (NSUInteger i = 0; i < bodyCount; i++) {
+        pendingBodies[i].b2Body = b2Bodies[i];
+    }
+
+    for (NSUInteger i = 0; i < fixtures.count; i++) {
+        [fixtures[i] __assembleWithB2Fixture:b2Fixtures[i]];
+    }
+
+    delete[] bodyDefs;
+    delete[] fixtureCounts;
+    delete[] b2Bodies;
+    delete[] fixtureDefs;
+    delete[] b2Fixtures;
+
+    for (MXBody *body in pendingBodies) {
+        for (MXJointEdge *jointEdge in body.jointEdges) {
+            [jointEdge.joint __assemble];
+        }
     }
 }
 
 - (void)__disassemble {
+    b2Body *b2Body = [self __detach];
+    if (b2Body) {
+        b2Body->GetWorld()->DestroyBody(b2Body);
+    }
+}
+
+- (b2Body *)__detach {
     for (MXJointEdge *jointEdge in self.jointEdges) {
         [jointEdge.joint __disassemble];
     }
     
-    [self.fixtures makeObjectsPerformSelector:@selector(__disassemble)];
+    [self.fixtures makeObjectsPerformSelector:@selector(__detach)];
     
     b2Body *b2Body = self.b2Body;
     if (!b2Body) {
-        return;
+        return NULL;
     }
 
     NSParameterAssert(self.b2BodyDef);
@@ -548,8 +607,8 @@ gravityScale, allowSleep, awake, active, fixedRotation, bullet, mass, operationa
     bodyDef->gravityScale = b2Body->GetGravityScale();
     bodyDef->userData = b2Body->GetUserData();
 
-    b2Body->GetWorld()->DestroyBody(b2Body);
     self.b2Body = NULL;
+    return b2Body;
 }
 
 - (void)__addJointEdge:(MXJointEdge *)jointEdge {
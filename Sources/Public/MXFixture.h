@@ -110,6 +110,14 @@ extern const NSUInteger kMXMinPolygonVertices;
  */
 + (nonnull instancetype)fixtureWithBoxSize:(CGSize)boxSize atLocation:(CGPoint)location angle:(CGFloat)angle;
 
+/**
+ Initializes a fixture that shares the shape of another fixture instead of copying it. Use this when many
+ bodies have the same geometry. Friction, restitution, density and filtering start at their defaults.
+
+ @param fixture The fixture whose shape is shared. It may be released before the new fixture.
+ */
++ (nonnull instancetype)fixtureWithShapeOfFixture:(nonnull MXFixture *)fixture;
+
 /**
  Test whether a point is contained within the fixture.
 
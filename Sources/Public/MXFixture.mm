@@ -18,7 +18,8 @@ const NSUInteger kMXMinPolygonVertices = 3;
 @property (nonatomic, assign, readwrite) b2Fixture *b2Fixture;
 @property (nonatomic, weak, readwrite) MXBody *body;
 
-- (instancetype)__initWithShape:(b2Shape *)shape;
+- (instancetype)__initWithShape:(const b2Shape *)shape;
+- (instancetype)__initWithSharedShape:(b2SharedShape *)sharedShape;
 
 - (void)__performFixtureOperation:(void (^)(b2Fixture *fixture))fixtureOperation
             orFixtureDefOperation:(void (^)(b2FixtureDef *fixtureDef))fixtureDefOperation;
@@ -59,6 +60,11 @@ const NSUInteger kMXMinPolygonVertices = 3;
     return [[self alloc] initWithBoxSize:boxSize atLocation:location angle:angle];
 }
 
++ (instancetype)fixtureWithShapeOfFixture:(MXFixture *)fixture {
+    NSParameterAssert(fixture);
+    return [[self alloc] __initWithSharedShape:fixture.b2FixtureDef->sharedShape];
+}
+
 - (instancetype)initWithEdgeVertices:(NSArray *)vertices isClosedLoop:(BOOL)isClosedLoop {
     b2Vec2 cverts[kMXMaxPolygonVertices];
     
@@ -68,14 +74,14 @@ const NSUInteger kMXMinPolygonVertices = 3;
         cverts[i] = B2Vec2FromCGPoint(point);
     }
     
-    b2ChainShape *chainShape = new b2ChainShape();
+    b2ChainShape chainShape;
     if (isClosedLoop) {
-        chainShape->CreateLoop(cverts, (int32)vertices.count);
+        chainShape.CreateLoop(cverts, (int32)vertices.count);
     } else {
-        chainShape->CreateChain(cverts, (int32)vertices.count);
+        chainShape.CreateChain(cverts, (int32)vertices.count);
     }
     
-    return [self __initWithShape:chainShape];
+    return [self __initWithShape:&chainShape];
 }
 
 - (instancetype)initWithPolygonVertices:(NSArray *)vertices {
@@ -92,40 +98,41 @@ const NSUInteger kMXMinPolygonVertices = 3;
         cverts[i] = B2Vec2FromCGPoint(point);
     }
     
-    b2PolygonShape *polygonShape = new b2PolygonShape();
-    polygonShape->Set(cverts, (int32)vertices.count);
-    return [self __initWithShape:polygonShape];
+    b2PolygonShape polygonShape;
+    polygonShape.Set(cverts, (int32)vertices.count);
+    return [self __initWithShape:&polygonShape];
 }
 
 - (instancetype)initWithCircleRadius:(CGFloat)circleRadius atLocation:(CGPoint)location {
-    b2CircleShape *circleShape = new b2CircleShape();
-	circleShape->m_radius = circleRadius / kMXPointsPerMeter;
-	circleShape->m_p = B2Vec2FromCGPoint(location);
-	return [self __initWithShape:circleShape];
+    b2CircleShape circleShape;
+	circleShape.m_radius = circleRadius / kMXPointsPerMeter;
+	circleShape.m_p = B2Vec2FromCGPoint(location);
+	return [self __initWithShape:&circleShape];
 }
 
 - (instancetype)initWithBoxSize:(CGSize)boxSize atLocation:(CGPoint)location angle:(CGFloat)angle {
-    b2PolygonShape *boxShape = new b2PolygonShape();
-	boxShape->SetAsBox((boxSize.width * 0.5) / kMXPointsPerMeter, (boxSize.height * 0.5) / kMXPointsPerMeter,
-                       B2Vec2FromCGPoint(location), MX_DEGREES_TO_RADIANS(angle));
-	return [self __initWithShape:boxShape];
+    b2PolygonShape boxShape;
+	boxShape.SetAsBox((boxSize.width * 0.5) / kMXPointsPerMeter, (boxSize.height * 0.5) / kMXPointsPerMeter,
+                      B2Vec2FromCGPoint(location), MX_DEGREES_TO_RADIANS(angle));
+	return [self __initWithShape:&boxShape];
 }
 
 - (void)dealloc {
     NSParameterAssert(_b2FixtureDef);
     _b2FixtureDef->userData = NULL;
 
-    delete _b2FixtureDef->shape;
-    _b2FixtureDef->shape = NULL;
-
-    delete _b2FixtureDef;
-    _b2FixtureDef = NULL;
-    
     // Destroy fixture.
     if (_b2Fixture) {
         _b2Fixture->GetBody()->DestroyFixture(_b2Fixture);
         _b2Fixture = NULL;
     }
+
+    // Other fixtures may still reference the shape; it is freed with the last one.
+    _b2FixtureDef->sharedShape->Release();
+    _b2FixtureDef->sharedShape = NULL;
+
+    delete _b2FixtureDef;
+    _b2FixtureDef = NULL;
 }
 
 - (CGFloat)friction {
@@ -262,7 +269,7 @@ const NSUInteger kMXMinPolygonVertices = 3;
          isContained = fixture->TestPoint(b2Point);
      } orFixtureDefOperation:^(b2FixtureDef *fixtureDef) {
          b2Transform identity = b2Transform(); identity.SetIdentity();
-         isContained = fixtureDef->shape->TestPoint(identity, b2Point);
+         isContained = fixtureDef->sharedShape->GetShape()->TestPoint(identity, b2Point);
      }];
     
     return isContained;
@@ -274,12 +281,24 @@ const NSUInteger kMXMinPolygonVertices = 3;
 
 #pragma mark - Private methods
 
-- (instancetype)__initWithShape:(b2Shape *)shape {
+- (instancetype)__initWithShape:(const b2Shape *)shape {
     NSParameterAssert(shape);
 
+    // The shape is copied, so fixtures created with +fixtureWithShapeOfFixture: can share it.
+    b2SharedShape *sharedShape = b2SharedShape::Create(shape);
+    self = [self __initWithSharedShape:sharedShape];
+    sharedShape->Release();
+
+    return self;
+}
+
+- (instancetype)__initWithSharedShape:(b2SharedShape *)sharedShape {
+    NSParameterAssert(sharedShape);
+
     if (self = [super init]) {
         b2FixtureDef *fixtureDef = new b2FixtureDef();
-        fixtureDef->shape = shape;
+        fixtureDef->sharedShape = sharedShape;
+        sharedShape->Retain();
         fixtureDef->userData = (__bridge void *)self;
         _b2FixtureDef = fixtureDef;
 
@@ -308,7 +327,7 @@ const NSUInteger kMXMinPolygonVertices = 3;
 #pragma mark -
 @implementation MXFixture (Private)
 
-@dynamic b2Fixture;
+@dynamic b2Fixture, b2FixtureDef;
 
 - (void)__assemble {
     if (self.b2Fixture || !self.body.isOperational) {
@@ -319,12 +338,31 @@ const NSUInteger kMXMinPolygonVertices = 3;
     self.b2Fixture = self.body.b2Body->CreateFixture(self.b2FixtureDef);
 }
 
+- (void)__assembleWithB2Fixture:(b2Fixture *)b2Fixture {
+    NSParameterAssert(b2Fixture);
+    NSParameterAssert(!self.b2Fixture);
+
+    self.b2Fixture = b2Fixture;
+}
+
 - (void)__disassemble {
     b2Fixture *b2Fixture = self.b2Fixture;
     if (!b2Fixture) {
         return;
     }
 
+    [self __detach];
+
+    // Destroy the old fixture.
+    b2Fixture->GetBody()->DestroyFixture(b2Fixture);
+}
+
+- (void)__detach {
+    b2Fixture *b2Fixture = self.b2Fixture;
+    if (!b2Fixture) {
+        return;
+    }
+
     NSParameterAssert(self.b2FixtureDef);
 
     // Update the fixture definition with the fixture data.
@@ -337,8 +375,6 @@ const NSUInteger kMXMinPolygonVertices = 3;
     fixtureDef->filter.maskBits = b2Fixture->GetFilterData().maskBits;
     fixtureDef->userData = b2Fixture->GetUserData();
 
-    // Destroy the old fixture.
-    b2Fixture->GetBody()->DestroyFixture(b2Fixture);
     self.b2Fixture = NULL;
 }
 
@@ -65,6 +65,14 @@
  */
 - (void)addBody:(nonnull MXBody *)body;
 
+/**
+ Add several bodies to the world. Bodies already in the world are skipped. All of the bodies and their fixtures are
+ created in one batch, which is much faster than adding them one at a time.
+
+ @param bodies The bodies to add.
+ */
+- (void)addBodies:(nonnull NSArray<MXBody *> *)bodies;
+
 /**
  Remove a body from the world. If the world is locked (it's inside a time-step) then the body shall be removed
  after the time step.
@@ -74,7 +82,16 @@
 - (void)removeBody:(nonnull MXBody *)body;
 
 /**
- Remove all bodies from the world.
+ Remove several bodies from the world in one batch. Bodies that are not in the world are skipped. If the world is
+ locked (it's inside a time-step) then the bodies shall be removed after the time step.
+
+ @param bodies The bodies to remove.
+ */
+- (void)removeBodies:(nonnull NSArray<MXBody *> *)bodies;
+
+/**
+ Remove all bodies from the world. Unless the world is locked, the underlying world is emptied at once instead of
+ destroying the bodies one by one.
  */
 - (void)removeAllBodies;
 
@@ -3,6 +3,7 @@
 #import "MXBox2DInternal.h"
 #import "MXBody+Private.h"
 #import "MXFixture.h"
+#import "MXJoint+Private.h"
 #import "MXContact+Private.h"
 #import "MXRayCastIntersection+Private.h"
 #import "MXContactListener.h"
@@ -134,7 +135,7 @@
 - (void)updateWithTimeStep:(CGFloat)timeStep velocityIterations:(NSInteger)velocityIterations
         positionIterations:(NSInteger)positionIterations
 {
-    [self.bodies makeObjectsPerformSelector:@selector(__recordLastTransform)];
+    [self.mutableBodies makeObjectsPerformSelector:@selector(__recordLastTransform)];
     self.b2World->Step(timeStep, (int32)velocityIterations, (int32)positionIterations);
     [self __removeQueuedObjects];
 }
@@ -146,7 +147,7 @@
 - (void)addBody:(MXBody *)body {
     NSParameterAssert(body);
 
-    if ([self.bodies containsObject:body]) {
+    if ([self.mutableBodies containsObject:body]) {
         return;
     }
 
@@ -159,10 +160,30 @@
     [body __assemble];
 }
 
+- (void)addBodies:(NSArray<MXBody *> *)bodies {
+    NSParameterAssert(bodies);
+
+    NSMutableArray<MXBody *> *addedBodies = [NSMutableArray arrayWithCapacity:bodies.count];
+    for (MXBody *body in bodies) {
+        if ([self.mutableBodies containsObject:body]) {
+            continue;
+        }
+
+        // Remove body from another world if needed.
+        [body.world removeBody:body];
+
+        [self.mutableBodies addObject:body];
+        body.world = self;
+        [addedBodies addObject:body];
+    }
+
+    [MXBody __assembleBodies:addedBodies inWorld:self.b2World];
+}
+
 - (void)removeBody:(MXBody *)body {
     NSParameterAssert(body);
 
-    if (![self.bodies containsObject:body]) {
+    if (![self.mutableBodies containsObject:body]) {
         return;
     } else if (self.isLocked) {
         [self.mutableBodiesToRemove addObject:body];
@@ -175,10 +196,58 @@
     [self.mutableBodies removeObject:body];
 }
 
+- (void)removeBodies:(NSArray<MXBody *> *)bodies {
+    NSParameterAssert(bodies);
+
+    if (self.isLocked) {
+        for (MXBody *body in bodies) {
+            [self removeBody:body];
+        }
+        return;
+    }
+
+    // Destroy the bodies in one batch, which removes their broad-phase proxies together.
+    b2Body **b2Bodies = new b2Body *[bodies.count];
+    int32 count = 0;
+
+    for (MXBody *body in bodies) {
+        if (![self.mutableBodies containsObject:body]) {
+            continue;
+        }
+
+        b2Body *b2Body = [body __detach];
+        if (b2Body) {
+            b2Bodies[count++] = b2Body;
+        }
+
+        body.world = nil;
+        [self.mutableBodies removeObject:body];
+    }
+
+    self.b2World->DestroyBodies(count, b2Bodies);
+    delete[] b2Bodies;
+}
+
 - (void)removeAllBodies {
-    for (MXBody *body in self.bodies) {
-        [self removeBody:body];
+    if (self.isLocked) {
+        [self removeBodies:self.mutableBodies.allObjects];
+        return;
+    }
+
+    // Every b2Body goes, so let go of all of them and empty the world at once. Joints only connect bodies of this
+    // world, so they can be let go of as well.
+    for (MXBody *body in self.mutableBodies) {
+        for (MXJointEdge *jointEdge in body.jointEdges) {
+            [jointEdge.joint __detach];
+        }
+
+        [body __detach];
+        body.world = nil;
     }
+
+    // Clear reports the contacts that end, which refer to the fixtures, so the bodies are released after it.
+    self.b2World->Clear();
+    [self.mutableBodies removeAllObjects];
 }
 
 #pragma mark - Private methods
@@ -186,9 +255,7 @@
 - (void)__removeQueuedObjects {
     NSParameterAssert(!self.isLocked);
 
-    for (MXBody *body in [self.mutableBodiesToRemove copy]) {
-        [self removeBody:body];
-    }
+    [self removeBodies:self.mutableBodiesToRemove.allObjects];
 
     for (MXFixture *fixture in [self.mutableFixturesToRemove copy]) {
         [fixture removeFromParentBody];
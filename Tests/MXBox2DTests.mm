@@ -0,0 +1,370 @@
+#import <XCTest/XCTest.h>
+
+#include <Box2D/Box2D.h>
+
+static void MXBuildPile(b2World *world) {
+    b2BodyDef bodyDef;
+    b2Body *ground = world->CreateBody(&bodyDef);
+    b2EdgeShape edge;
+    edge.Set(b2Vec2(-20.0f, 0.0f), b2Vec2(20.0f, 0.0f));
+    ground->CreateFixture(&edge, 0.0f);
+
+    b2PolygonShape box;
+    box.SetAsBox(0.5f, 0.5f);
+    b2CircleShape circle;
+    circle.m_radius = 0.4f;
+
+    bodyDef.type = b2_dynamicBody;
+    for (int32 i = 0; i < 60; ++i) {
+        bodyDef.position.Set(-10.0f + (i % 10) * 2.0f, 1.0f + (i / 10) * 1.5f);
+        b2Body *body = world->CreateBody(&bodyDef);
+        if (i % 2) {
+            body->CreateFixture(&box, 1.0f)->SetRestitution(0.3f);
+        } else {
+            body->CreateFixture(&circle, 1.0f)->SetRestitution(0.5f);
+        }
+    }
+}
+
+static b2World *MXCreatePileWorld() {
+    b2World *world = new b2World(b2Vec2(0.0f, -10.0f));
+    MXBuildPile(world);
+    return world;
+}
+
+static BOOL MXWorldsMatch(const b2World *worldA, const b2World *worldB) {
+    const b2Body *a = worldA->GetBodyList();
+    const b2Body *b = worldB->GetBodyList();
+    for (; a && b; a = a->GetNext(), b = b->GetNext()) {
+        if (a->GetPosition().x != b->GetPosition().x ||
+            a->GetPosition().y != b->GetPosition().y ||
+            a->GetAngle() != b->GetAngle()) {
+            return NO;
+        }
+    }
+
+    return a == NULL && b == NULL;
+}
+
+// Circles, boxes and an edge ground, chained together with several joint types.
+static void MXBuildMixedScene(b2World *world) {
+    b2BodyDef bodyDef;
+    b2Body *ground = world->CreateBody(&bodyDef);
+    b2EdgeShape edge;
+    edge.Set(b2Vec2(-40.0f, 0.0f), b2Vec2(40.0f, 0.0f));
+    ground->CreateFixture(&edge, 0.0f);
+
+    b2PolygonShape box;
+    box.SetAsBox(0.5f, 0.5f);
+    b2CircleShape circle;
+    circle.m_radius = 0.5f;
+
+    bodyDef.type = b2_dynamicBody;
+    b2Body *previous = NULL;
+    for (int32 i = 0; i < 300; ++i) {
+        bodyDef.position.Set(-30.0f + (i % 30) * 2.0f, 1.0f + (i / 30) * 2.0f);
+        b2Body *body = world->CreateBody(&bodyDef);
+        body->CreateFixture(i % 2 ? (const b2Shape *)&box : (const b2Shape *)&circle, 1.0f);
+
+        if (previous && i % 30 != 0) {
+            if (i % 3 == 0) {
+                b2DistanceJointDef jointDef;
+                jointDef.Initialize(previous, body, previous->GetPosition(), body->GetPosition());
+                world->CreateJoint(&jointDef);
+            } else if (i % 3 == 1) {
+                b2WeldJointDef jointDef;
+                jointDef.Initialize(previous, body, previous->GetPosition());
+                world->CreateJoint(&jointDef);
+            } else {
+                b2RevoluteJointDef jointDef;
+                jointDef.Initialize(previous, body, previous->GetPosition());
+                world->CreateJoint(&jointDef);
+            }
+        }
+        previous = body;
+    }
+}
+
+// A chain hanging from the ground: ground -revolute- A -weld- B -revolute- C -revolute- D.
+// The body at fixedIndex has fixed rotation, none if it is -1.
+static void MXBuildWeldChain(b2World *world, int32 fixedIndex) {
+    b2BodyDef bodyDef;
+    b2Body *previous = world->CreateBody(&bodyDef);
+
+    b2PolygonShape box;
+    box.SetAsBox(0.5f, 0.125f);
+
+    bodyDef.type = b2_dynamicBody;
+    for (int32 i = 0; i < 4; ++i) {
+        bodyDef.position.Set(0.5f + i, 10.0f);
+        bodyDef.fixedRotation = i == fixedIndex;
+        b2Body *body = world->CreateBody(&bodyDef);
+        body->CreateFixture(&box, 1.0f);
+
+        b2Vec2 anchor((float32)i, 10.0f);
+        if (i == 1) {
+            b2WeldJointDef jointDef;
+            jointDef.Initialize(previous, body, anchor);
+            world->CreateJoint(&jointDef);
+        } else {
+            b2RevoluteJointDef jointDef;
+            jointDef.Initialize(previous, body, anchor);
+            world->CreateJoint(&jointDef);
+        }
+        previous = body;
+    }
+}
+
+// The largest distance between the two anchors of any joint.
+static float32 MXMaxJointGap(b2World *world) {
+    float32 gap = 0.0f;
+    for (b2Joint *j = world->GetJointList(); j; j = j->GetNext()) {
+        gap = b2Max(gap, (j->GetAnchorA() - j->GetAnchorB()).Length());
+    }
+    return gap;
+}
+
+static BOOL MXBodiesAreValid(const b2World *world) {
+    for (const b2Body *b = world->GetBodyList(); b; b = b->GetNext()) {
+        if (b->GetPosition().IsValid() == false || b2IsValid(b->GetAngle()) == false) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+class MXBeginCounter : public b2ContactListener {
+public:
+    MXBeginCounter() : begins(0) {}
+    void BeginContact(b2Contact *contact) { B2_NOT_USED(contact); ++begins; }
+    int32 begins;
+};
+
+static const int32 kMXMixedSceneSteps = 120;
+
+// Find the largest object counts the mixed scene reaches.
+static b2WorldCapacity MXMeasureMixedScene() {
+    b2World world(b2Vec2(0.0f, -10.0f));
+    MXBuildMixedScene(&world);
+
+    b2WorldCapacity capacity;
+    for (b2Body *b = world.GetBodyList(); b; b = b->GetNext()) {
+        for (b2Fixture *f = b->GetFixtureList(); f; f = f->GetNext()) {
+            ++capacity.fixtureCount;
+            ++capacity.shapeCounts[f->GetType()];
+        }
+    }
+    for (b2Joint *j = world.GetJointList(); j; j = j->GetNext()) {
+        ++capacity.jointCounts[j->GetType()];
+    }
+    capacity.bodyCount = world.GetBodyCount();
+    capacity.jointCount = world.GetJointCount();
+    capacity.proxyCount = world.GetProxyCount();
+
+    for (int32 i = 0; i < kMXMixedSceneSteps; ++i) {
+        int32 contactCount = world.GetContactCount();
+        world.Step(1.0f / 60.0f, 8, 3);
+        const b2Metrics &metrics = world.GetMetrics();
+        capacity.contactCount = b2Max(capacity.contactCount, contactCount + metrics.contactsCreated);
+        capacity.pairCount = b2Max(capacity.pairCount, metrics.pairsBuffered);
+    }
+
+    return capacity;
+}
+
+#pragma mark -
+@interface MXBox2DTests : XCTestCase
+
+@end
+
+#pragma mark -
+@implementation MXBox2DTests
+
+- (void)testSnapshotWritesDoNotChangeSimulation {
+    b2World *plain = MXCreatePileWorld();
+    b2World *exported = MXCreatePileWorld();
+
+    // A server writes a delta for every client, so several per step.
+    b2Snapshot snapshot;
+    uint32 sinceEpoch = 0;
+    for (int32 i = 0; i < 600; ++i) {
+        plain->Step(1.0f / 60.0f, 8, 3);
+        exported->Step(1.0f / 60.0f, 8, 3);
+        for (int32 client = 0; client < 4; ++client) {
+            snapshot.Write(exported, sinceEpoch);
+        }
+        sinceEpoch = snapshot.GetEpoch();
+    }
+
+    XCTAssertTrue(MXWorldsMatch(plain, exported));
+
+    delete plain;
+    delete exported;
+}
+
+- (void)testReserveKeepsGrowthAtZero {
+    b2WorldCapacity capacity = MXMeasureMixedScene();
+
+    b2World world(b2Vec2(0.0f, -10.0f));
+    world.Reserve(capacity);
+    XCTAssertEqual(world.GetGrowthCount(), 0);
+
+    MXBuildMixedScene(&world);
+    for (int32 i = 0; i < kMXMixedSceneSteps; ++i) {
+        world.Step(1.0f / 60.0f, 8, 3);
+    }
+
+    XCTAssertEqual(world.GetGrowthCount(), 0);
+}
+
+- (void)testEmptySnapshot {
+    b2Snapshot snapshot;
+
+    XCTAssertEqual(snapshot.GetSize(), 0);
+    XCTAssertEqual(snapshot.GetEpoch(), 0u);
+    XCTAssertEqual(snapshot.GetBaseEpoch(), 0u);
+    XCTAssertEqual(snapshot.GetBodyCount(), 0);
+}
+
+- (void)testSnapshotDeltaCarriesChangesBetweenSteps {
+    b2World *world = MXCreatePileWorld();
+    world->Step(1.0f / 60.0f, 8, 3);
+
+    b2Snapshot snapshot;
+    snapshot.Write(world, 0);
+    uint32 sinceEpoch = snapshot.GetEpoch();
+
+    // Move a body after the write but before the next step.
+    b2Body *body = world->GetBodyList();
+    body->SetTransform(b2Vec2(0.0f, 30.0f), 0.0f);
+
+    snapshot.Write(world, sinceEpoch);
+    XCTAssertGreaterThan(snapshot.GetBodyCount(), 0);
+
+    b2World *client = MXCreatePileWorld();
+    b2Snapshot received;
+    XCTAssertTrue(received.SetData(snapshot.GetData(), snapshot.GetSize()));
+    received.Apply(client);
+
+    const b2Body *copy = client->GetBodyList();
+    XCTAssertEqualWithAccuracy(copy->GetPosition().y, 30.0f, 0.01f);
+
+    delete world;
+    delete client;
+}
+
+- (void)testReplayMatchesRecordedSession {
+    b2Recorder recorder;
+    b2World world(b2Vec2(0.0f, -10.0f));
+    world.SetRecorder(&recorder);
+    MXBuildPile(&world);
+
+    // Rewind to an earlier state part way through.
+    b2Snapshot snapshot;
+    for (int32 i = 0; i < 90; ++i) {
+        if (i == 30) {
+            snapshot.Write(&world, 0);
+        } else if (i == 60) {
+            snapshot.Apply(&world);
+        }
+        world.Step(1.0f / 60.0f, 8, 3);
+    }
+
+    b2Replayer replayer(recorder.GetData(), recorder.GetSize());
+    while (replayer.Step()) {
+    }
+
+    XCTAssertFalse(replayer.HasError());
+    XCTAssertEqual(replayer.GetStepCount(), 90);
+    XCTAssertTrue(MXWorldsMatch(&world, replayer.GetWorld()));
+}
+
+- (void)testJointTreeSolverKeepsChainTight {
+    float32 gaps[2];
+    for (int32 tree = 0; tree < 2; ++tree) {
+        b2World world(b2Vec2(0.0f, -10.0f));
+        world.SetJointTreeSolving(tree == 1);
+
+        b2BodyDef bodyDef;
+        b2Body *previous = world.CreateBody(&bodyDef);
+        b2PolygonShape box;
+        box.SetAsBox(0.5f, 0.125f);
+        bodyDef.type = b2_dynamicBody;
+        for (int32 i = 0; i < 30; ++i) {
+            bodyDef.position.Set(0.5f + i, 20.0f);
+            b2Body *body = world.CreateBody(&bodyDef);
+            body->CreateFixture(&box, 20.0f);
+
+            b2RevoluteJointDef jointDef;
+            jointDef.Initialize(previous, body, b2Vec2((float32)i, 20.0f));
+            world.CreateJoint(&jointDef);
+            previous = body;
+        }
+
+        // Few iterations, so the iterative solver lets the chain stretch.
+        gaps[tree] = 0.0f;
+        for (int32 i = 0; i < 300; ++i) {
+            world.Step(1.0f / 60.0f, 2, 1);
+            gaps[tree] = b2Max(gaps[tree], MXMaxJointGap(&world));
+        }
+    }
+
+    XCTAssertLessThan(gaps[1], 0.5f * gaps[0]);
+}
+
+- (void)testJointTreeSolverHandlesFixedRotationBodies {
+    for (int32 fixedIndex = -1; fixedIndex < 4; ++fixedIndex) {
+        b2World world(b2Vec2(0.0f, -10.0f));
+        world.SetJointTreeSolving(true);
+        MXBuildWeldChain(&world, fixedIndex);
+
+        float32 gap = 0.0f;
+        BOOL valid = YES;
+        for (int32 i = 0; i < 600 && valid; ++i) {
+            world.Step(1.0f / 60.0f, 8, 3);
+            gap = b2Max(gap, MXMaxJointGap(&world));
+            valid = MXBodiesAreValid(&world);
+        }
+
+        XCTAssertTrue(valid, @"fixed rotation body %d", fixedIndex);
+        XCTAssertLessThan(gap, 0.05f, @"fixed rotation body %d", fixedIndex);
+    }
+}
+
+- (void)testKeptSpeculativeManifoldDoesNotTouch {
+    b2World world(b2Vec2(0.0f, 0.0f));
+    world.SetSpeculativeContacts(true);
+    world.SetManifoldReuse(true);
+    MXBeginCounter listener;
+    world.SetContactListener(&listener);
+
+    b2BodyDef bodyDef;
+    b2Body *ground = world.CreateBody(&bodyDef);
+    b2PolygonShape box;
+    box.SetAsBox(20.0f, 0.5f, b2Vec2(0.0f, -0.5f), 0.0f);
+    ground->CreateFixture(&box, 0.0f);
+
+    // A ball sliding just above the ground gets a speculative point.
+    bodyDef.type = b2_dynamicBody;
+    bodyDef.position.Set(0.0f, 0.55f);
+    bodyDef.linearVelocity.Set(2.0f, 0.0f);
+    b2Body *ball = world.CreateBody(&bodyDef);
+    b2CircleShape circle;
+    circle.m_radius = 0.5f;
+    ball->CreateFixture(&circle, 1.0f);
+    world.Step(1.0f / 60.0f, 8, 3);
+
+    // Stopped where the manifold was built, the ball keeps that manifold
+    // although the step has no speculative margin left.
+    ball->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
+    ball->SetTransform(b2Vec2(0.0f, 0.55f), 0.0f);
+    world.Step(1.0f / 60.0f, 8, 3);
+
+    const b2Contact *contact = world.GetContactList();
+    XCTAssertTrue(contact != NULL);
+    XCTAssertTrue(contact->GetManifold()->pointCount > 0);
+    XCTAssertFalse(contact->IsTouching());
+    XCTAssertEqual(listener.begins, 0);
+}
+
+@end
@@ -99,4 +99,29 @@ static const CGFloat kMXMaxVariation = 0.00001;
     XCTAssertFalse([fixture testPoint:CGPointMake(5, 5.1)]);
 }
 
+- (void)testSharedShape {
+    MXFixture* sharedFixture = nil;
+
+    @autoreleasepool {
+        MXFixture* fixture = [MXFixture fixtureWithBoxSize:CGSizeMake(10, 10) atLocation:CGPointZero];
+        [fixture setFriction:0.5];
+        sharedFixture = [MXFixture fixtureWithShapeOfFixture:fixture];
+
+        XCTAssertEqualWithAccuracy(sharedFixture.friction, 0.2, kMXMaxVariation);
+    }
+
+    // The shape outlives the fixture it was created for.
+    XCTAssertTrue([sharedFixture testPoint:CGPointMake(5, 5)]);
+    XCTAssertFalse([sharedFixture testPoint:CGPointMake(5, 5.1)]);
+
+    MXBody* body = [MXBody bodyWithType:MXBodyTypeDynamic position:CGPointZero rotation:0];
+    MXWorld* world = [MXWorld worldWithGravity:CGPointZero];
+    [body addFixture:sharedFixture];
+    [body addFixture:[MXFixture fixtureWithShapeOfFixture:sharedFixture]];
+    [world addBody:body];
+
+    XCTAssertTrue([sharedFixture testPoint:CGPointMake(-5, -5)]);
+    XCTAssertFalse([sharedFixture testPoint:CGPointMake(-6, -5)]);
+}
+
 @end
@@ -145,6 +145,133 @@ static NSString * const kKillPhrase = @"Destroy Me!";
     }
 }
 
+- (void)testAddAndRemoveBodiesInBatch {
+    MXWorld *world = [MXWorld worldWithGravity:CGPointZero];
+
+    NSMutableArray<MXBody *> *bodies = [NSMutableArray array];
+    for (int i = 0; i < 64; i++) {
+        MXBody *body = [MXBody bodyWithType:MXBodyTypeDynamic position:CGPointMake(i * 20, 0) rotation:0];
+        [body addFixture:[MXFixture fixtureWithCircleRadius:5]];
+        [bodies addObject:body];
+    }
+
+    // Joints between bodies of the batch are assembled once all of them exist.
+    MXJoint *joint = [bodies[1] constrainToBody:bodies[3] withJointType:MXJointTypeDistance];
+
+    // Add one body up front; it is skipped by the batch.
+    [world addBody:bodies[0]];
+    [world addBodies:bodies];
+    XCTAssertEqual(world.bodies.count, bodies.count);
+    XCTAssertTrue(joint.isOperational);
+
+    for (MXBody *body in bodies) {
+        XCTAssertEqualObjects(body.world, world);
+        XCTAssertTrue(body.isOperational);
+        XCTAssertGreaterThan(body.mass, 0);
+    }
+
+    // Remove every other body in one batch.
+    NSMutableArray<MXBody *> *removedBodies = [NSMutableArray array];
+    for (NSUInteger i = 0; i < bodies.count; i += 2) {
+        [removedBodies addObject:bodies[i]];
+    }
+
+    [world removeBodies:removedBodies];
+    XCTAssertEqual(world.bodies.count, bodies.count - removedBodies.count);
+
+    for (MXBody *body in removedBodies) {
+        XCTAssertNil(body.world);
+        XCTAssertFalse(body.isOperational);
+        XCTAssertFalse([world.bodies containsObject:body]);
+    }
+
+    [world updateWithTimeStep:1.0 / 60 velocityIterations:8 positionIterations:3];
+}
+
+- (void)testRemoveAllBodiesPreservesState {
+    MXWorld *world = [MXWorld worldWithGravity:CGPointMake(0, -10)];
+
+    NSMutableArray *bodies = [NSMutableArray array];
+    for (int i = 0; i < 8; i++) {
+        MXBody *body = [MXBody bodyWithType:MXBodyTypeDynamic position:CGPointMake(i * 20, 0) rotation:0];
+        MXFixture *fixture = [MXFixture fixtureWithBoxSize:CGSizeMake(10, 10)];
+        [fixture setFriction:0.75];
+        [fixture setDensity:2];
+        [body addFixture:fixture];
+        [world addBody:body];
+        [bodies addObject:body];
+    }
+
+    [[bodies firstObject] constrainToBody:[bodies lastObject] withJointType:MXJointTypeDistance];
+    [world updateWithTimeStep:1.0 / 60 velocityIterations:8 positionIterations:3];
+
+    MXBody *body = [bodies objectAtIndex:3];
+    const CGPoint position = body.position;
+    const CGFloat mass = body.mass;
+    XCTAssertGreaterThan(mass, 0);
+
+    [world removeAllBodies];
+    XCTAssertEqual(world.bodies.count, 0);
+    XCTAssertFalse(body.isOperational);
+
+    // The bodies and fixtures can be added to another world with their state intact.
+    MXWorld *world2 = [MXWorld worldWithGravity:CGPointZero];
+    [world2 addBody:body];
+
+    MXFixture *fixture = [body.fixtures anyObject];
+    XCTAssertEqualWithAccuracy(body.position.x, position.x, kMXMaxVariation);
+    XCTAssertEqualWithAccuracy(body.position.y, position.y, kMXMaxVariation);
+    XCTAssertEqualWithAccuracy(body.mass, mass, kMXMaxVariation);
+    XCTAssertEqualWithAccuracy(fixture.friction, 0.75, kMXMaxVariation);
+    XCTAssertEqualWithAccuracy(fixture.density, 2, kMXMaxVariation);
+}
+
+- (void)testAddBodiesAfterRemoveAllBodies {
+    MXWorld *world = [MXWorld worldWithGravity:CGPointMake(0, -10)];
+
+    MXBody *bodyA = [MXBody bodyWithType:MXBodyTypeDynamic position:CGPointZero rotation:0];
+    MXBody *bodyB = [MXBody bodyWithType:MXBodyTypeDynamic position:CGPointMake(20, 0) rotation:0];
+    [bodyA addFixture:[MXFixture fixtureWithBoxSize:CGSizeMake(10, 10)]];
+    [bodyB addFixture:[MXFixture fixtureWithBoxSize:CGSizeMake(10, 10)]];
+    MXJoint *joint = [bodyA constrainToBody:bodyB withJointType:MXJointTypeDistance];
+    [world addBodies:@[bodyA, bodyB]];
+    [world updateWithTimeStep:1.0 / 60 velocityIterations:8 positionIterations:3];
+    XCTAssertTrue(joint.isOperational);
+
+    [world removeAllBodies];
+    XCTAssertEqual(world.bodies.count, 0);
+    XCTAssertFalse(bodyA.isOperational);
+    XCTAssertFalse(joint.isOperational);
+
+    // The emptied world takes the same bodies back, joint included.
+    [world addBodies:@[bodyA, bodyB]];
+    XCTAssertEqual(world.bodies.count, 2);
+    XCTAssertTrue(bodyA.isOperational);
+    XCTAssertTrue(joint.isOperational);
+
+    [world updateWithTimeStep:1.0 / 60 velocityIterations:8 positionIterations:3];
+    XCTAssertLessThan(bodyA.position.y, 0);
+}
+
+- (void)testRemoveAllBodiesEndsContacts {
+    MXWorld *world = [MXWorld worldWithGravity:CGPointZero];
+    MXContactListenerDelegateTester *delegate = [[MXContactListenerDelegateTester alloc] init];
+    world.delegate = delegate;
+
+    MXBody *bodyA = [MXBody bodyWithType:MXBodyTypeDynamic position:CGPointMake(10, 10) rotation:0];
+    MXBody *bodyB = [MXBody bodyWithType:MXBodyTypeDynamic position:CGPointMake(15, 15) rotation:0];
+    [bodyA addFixture:[MXFixture fixtureWithBoxSize:CGSizeMake(10, 10)]];
+    [bodyB addFixture:[MXFixture fixtureWithBoxSize:CGSizeMake(10, 10)]];
+    [world addBodies:@[bodyA, bodyB]];
+    [world updateWithTimeStep:1 velocityIterations:5 positionIterations:5];
+    XCTAssertNotNil(delegate.fixtureA);
+
+    // The touching contact ends with the bodies.
+    [world removeAllBodies];
+    XCTAssertNil(delegate.fixtureA);
+    XCTAssertNil(delegate.fixtureB);
+}
+
 - (void)testMoveBodyBetweenWorlds {
     // Construct a world.
     MXWorld* world1 = [MXWorld worldWithGravity:CGPointZero];